@@ -0,0 +1,168 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+import org.jnativehook.NativeInputEvent;
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.keyboard.NativeKeyListener;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseListener;
+import org.jnativehook.mouse.NativeMouseMotionListener;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+import org.jnativehook.mouse.NativeMouseWheelListener;
+
+import java.util.EventListener;
+
+/**
+ * The event types measured by the benchmarks.  Each benchmark takes one of
+ * the names <code>key</code>, <code>mouse</code>, <code>motion</code> or
+ * <code>wheel</code> as a JMH parameter.
+ *
+ * @since 1.2
+ */
+final class BenchmarkEvents {
+	private BenchmarkEvents() {
+		// Static helpers only.
+	}
+
+	/**
+	 * Returns the native event id used for the event type.
+	 *
+	 * @param type the event type name.
+	 * @return a native event id.
+	 */
+	static int getID(String type) {
+		int id;
+		if ("key".equals(type)) {
+			id = NativeKeyEvent.NATIVE_KEY_PRESSED;
+		}
+		else if ("mouse".equals(type)) {
+			id = NativeMouseEvent.NATIVE_MOUSE_PRESSED;
+		}
+		else if ("motion".equals(type)) {
+			id = NativeMouseEvent.NATIVE_MOUSE_MOVED;
+		}
+		else if ("wheel".equals(type)) {
+			id = NativeMouseEvent.NATIVE_MOUSE_WHEEL;
+		}
+		else {
+			throw new IllegalArgumentException("Unknown event type: " + type);
+		}
+
+		return id;
+	}
+
+	/**
+	 * Returns the listener type that receives the event type.
+	 *
+	 * @param type the event type name.
+	 * @return the listener interface.
+	 */
+	static Class<? extends EventListener> getListenerType(String type) {
+		Class<? extends EventListener> listenerType;
+		if ("key".equals(type)) {
+			listenerType = NativeKeyListener.class;
+		}
+		else if ("mouse".equals(type)) {
+			listenerType = NativeMouseListener.class;
+		}
+		else if ("motion".equals(type)) {
+			listenerType = NativeMouseMotionListener.class;
+		}
+		else if ("wheel".equals(type)) {
+			listenerType = NativeMouseWheelListener.class;
+		}
+		else {
+			throw new IllegalArgumentException("Unknown event type: " + type);
+		}
+
+		return listenerType;
+	}
+
+	/**
+	 * Creates a new event of the specified type.
+	 *
+	 * @param type the event type name.
+	 * @param when the event timestamp.
+	 * @return a new event.
+	 */
+	static NativeInputEvent create(String type, long when) {
+		int id = getID(type);
+
+		NativeInputEvent event;
+		if (id == NativeKeyEvent.NATIVE_KEY_PRESSED) {
+			event = new NativeKeyEvent(id, when, 0x00, 0x41, NativeKeyEvent.VC_A, NativeKeyEvent.CHAR_UNDEFINED, NativeKeyEvent.KEY_LOCATION_STANDARD);
+		}
+		else if (id == NativeMouseEvent.NATIVE_MOUSE_WHEEL) {
+			event = new NativeMouseWheelEvent(id, when, 0x00, 50, 75, 1, NativeMouseWheelEvent.WHEEL_UNIT_SCROLL, 3, 1);
+		}
+		else {
+			event = new NativeMouseEvent(id, when, 0x00, 50, 75, 1, NativeMouseEvent.BUTTON1);
+		}
+
+		return event;
+	}
+
+	/**
+	 * Adds the listener for the event type to the global screen.
+	 *
+	 * @param screen the global screen.
+	 * @param type the event type name.
+	 * @param listener the listener to add.
+	 */
+	static void addListener(GlobalScreen screen, String type, CountingListener listener) {
+		Class<? extends EventListener> listenerType = getListenerType(type);
+		if (listenerType == NativeKeyListener.class) {
+			screen.addNativeKeyListener(listener);
+		}
+		else if (listenerType == NativeMouseListener.class) {
+			screen.addNativeMouseListener(listener);
+		}
+		else if (listenerType == NativeMouseMotionListener.class) {
+			screen.addNativeMouseMotionListener(listener);
+		}
+		else {
+			screen.addNativeMouseWheelListener(listener);
+		}
+	}
+
+	/**
+	 * Removes the listener for the event type from the global screen.
+	 *
+	 * @param screen the global screen.
+	 * @param type the event type name.
+	 * @param listener the listener to remove.
+	 */
+	static void removeListener(GlobalScreen screen, String type, CountingListener listener) {
+		Class<? extends EventListener> listenerType = getListenerType(type);
+		if (listenerType == NativeKeyListener.class) {
+			screen.removeNativeKeyListener(listener);
+		}
+		else if (listenerType == NativeMouseListener.class) {
+			screen.removeNativeMouseListener(listener);
+		}
+		else if (listenerType == NativeMouseMotionListener.class) {
+			screen.removeNativeMouseMotionListener(listener);
+		}
+		else {
+			screen.removeNativeMouseWheelListener(listener);
+		}
+	}
+}
@@ -0,0 +1,102 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.keyboard.NativeKeyListener;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseInputListener;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+import org.jnativehook.mouse.NativeMouseWheelListener;
+
+/**
+ * A listener for every event type that only counts the events it receives.
+ * The count is volatile so that a benchmark thread can wait for delivery on
+ * an executor thread.  Only one thread delivers to a listener at a time.
+ *
+ * @since 1.2
+ */
+class CountingListener implements NativeKeyListener, NativeMouseInputListener, NativeMouseWheelListener {
+	/** The number of events received. */
+	volatile long count = 0;
+
+	/** The sum of the event timestamps, so that the event is always read. */
+	long checksum = 0;
+
+	private void received(long when) {
+		checksum += when;
+		count++;
+	}
+
+	public void nativeKeyPressed(NativeKeyEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeKeyReleased(NativeKeyEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeKeyTyped(NativeKeyEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeMouseClicked(NativeMouseEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeMousePressed(NativeMouseEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeMouseReleased(NativeMouseEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeMouseMoved(NativeMouseEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeMouseDragged(NativeMouseEvent e) {
+		received(e.getWhen());
+	}
+
+	public void nativeMouseWheelMoved(NativeMouseWheelEvent e) {
+		received(e.getWhen());
+	}
+
+	/**
+	 * Spin until the listener has received at least the specified number of
+	 * events.
+	 *
+	 * @param expected the event count to wait for.
+	 * @param timeout the maximum number of nanoseconds to wait.
+	 * @throws IllegalStateException if the events were not delivered in time.
+	 */
+	void await(long expected, long timeout) {
+		long deadline = System.nanoTime() + timeout;
+
+		while (count < expected) {
+			if (System.nanoTime() - deadline > 0) {
+				throw new IllegalStateException("Timed out waiting for event " + expected + ", received " + count + ".");
+			}
+
+			Thread.yield();
+		}
+	}
+}
@@ -0,0 +1,59 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.AbstractExecutorService;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * An executor service that runs each task on the submitting thread.  This is
+ * used to measure event delivery without the cost of a thread hand off.
+ *
+ * @since 1.2
+ */
+class DirectExecutorService extends AbstractExecutorService {
+	private volatile boolean shutdown = false;
+
+	public void execute(Runnable command) {
+		command.run();
+	}
+
+	public void shutdown() {
+		shutdown = true;
+	}
+
+	public List<Runnable> shutdownNow() {
+		shutdown = true;
+		return Collections.<Runnable>emptyList();
+	}
+
+	public boolean isShutdown() {
+		return shutdown;
+	}
+
+	public boolean isTerminated() {
+		return shutdown;
+	}
+
+	public boolean awaitTermination(long timeout, TimeUnit unit) {
+		return shutdown;
+	}
+}
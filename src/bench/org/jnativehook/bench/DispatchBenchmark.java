@@ -0,0 +1,111 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+import org.jnativehook.NativeInputEvent;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures the latency from {@link GlobalScreen#dispatchEvent(NativeInputEvent)}
+ * to delivery at a listener for each event type.  The <code>direct</code>
+ * dispatcher delivers on the calling thread and measures the Java dispatch
+ * overhead alone.  The <code>default</code> dispatcher is a single thread
+ * executor like the one installed by GlobalScreen, so the measurement also
+ * includes the thread hand off.
+ * <p/>
+ *
+ * Run with <code>-prof gc</code> to report the allocation rate per event.
+ *
+ * @since 1.2
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode({Mode.AverageTime, Mode.SampleTime})
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+public class DispatchBenchmark {
+	@Param({"key", "mouse", "motion", "wheel"})
+	public String type;
+
+	@Param({"direct", "default"})
+	public String dispatcher;
+
+	private GlobalScreen screen;
+	private CountingListener listener;
+	private NativeInputEvent event;
+	private long expected;
+
+	@Setup(Level.Trial)
+	public void setUp() {
+		screen = GlobalScreen.getInstance();
+
+		ExecutorService executor;
+		if ("direct".equals(dispatcher)) {
+			executor = new DirectExecutorService();
+		}
+		else {
+			executor = Executors.newSingleThreadExecutor();
+		}
+		screen.setEventDispatcher(BenchmarkEvents.getListenerType(type), executor);
+
+		listener = new CountingListener();
+		BenchmarkEvents.addListener(screen, type, listener);
+
+		event = BenchmarkEvents.create(type, System.currentTimeMillis());
+		expected = 0;
+	}
+
+	@TearDown(Level.Trial)
+	public void tearDown() {
+		BenchmarkEvents.removeListener(screen, type, listener);
+		screen.setEventDispatcher(BenchmarkEvents.getListenerType(type), Executors.newSingleThreadExecutor());
+	}
+
+	@Benchmark
+	public long dispatchEvent() {
+		screen.dispatchEvent(event);
+
+		// Wait for the listener, the direct dispatcher has already delivered.
+		listener.await(++expected, TimeUnit.SECONDS.toNanos(1));
+
+		return listener.checksum;
+	}
+
+	@Benchmark
+	public long dispatchNewEvent() {
+		screen.dispatchEvent(BenchmarkEvents.create(type, expected));
+
+		listener.await(++expected, TimeUnit.SECONDS.toNanos(1));
+
+		return listener.checksum;
+	}
+}
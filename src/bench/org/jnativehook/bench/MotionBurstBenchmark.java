@@ -0,0 +1,129 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseMotionListener;
+
+import org.openjdk.jmh.annotations.AuxCounters;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.infra.Blackhole;
+
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures how the motion executor queue behaves under bursts of native
+ * mouse motion events.  Each invocation dispatches a burst of synthetic
+ * native motion events from the native driver, then waits for the single
+ * thread motion executor to drain.  The listener spends a fixed amount of
+ * CPU time on each event so the executor falls behind the burst.
+ * <p/>
+ *
+ * The <code>delivered</code> counter reports the number of events that
+ * reached the listener.  With coalescing enabled it shows how many events
+ * were merged while the executor was busy.
+ *
+ * @since 1.2
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+public class MotionBurstBenchmark {
+	@Param({"16", "256", "4096"})
+	public int burst;
+
+	@Param({"false", "true"})
+	public boolean coalescing;
+
+	/** The number of Blackhole.consumeCPU() tokens spent in the listener. */
+	@Param({"0", "1000"})
+	public long listenerCost;
+
+	private GlobalScreen screen;
+	private ExecutorService executor;
+	private volatile long delivered;
+
+	private final NativeMouseMotionListener listener = new NativeMouseMotionListener() {
+		public void nativeMouseMoved(NativeMouseEvent e) {
+			Blackhole.consumeCPU(listenerCost);
+			delivered++;
+		}
+
+		public void nativeMouseDragged(NativeMouseEvent e) {
+			nativeMouseMoved(e);
+		}
+	};
+
+	/**
+	 * The per iteration event counts reported by JMH.
+	 */
+	@State(Scope.Thread)
+	@AuxCounters(AuxCounters.Type.EVENTS)
+	public static class Counters {
+		public long posted;
+		public long delivered;
+	}
+
+	@Setup(Level.Trial)
+	public void setUp() {
+		screen = GlobalScreen.getInstance();
+
+		executor = Executors.newSingleThreadExecutor();
+		screen.setEventDispatcher(NativeMouseMotionListener.class, executor);
+		screen.setMouseMotionCoalescing(coalescing);
+		screen.addNativeMouseMotionListener(listener);
+	}
+
+	@TearDown(Level.Trial)
+	public void tearDown() {
+		screen.removeNativeMouseMotionListener(listener);
+		screen.setMouseMotionCoalescing(false);
+		screen.setEventDispatcher(NativeMouseMotionListener.class, Executors.newSingleThreadExecutor());
+	}
+
+	@Benchmark
+	public void dispatchBurst(Counters counters) throws InterruptedException, ExecutionException {
+		long start = delivered;
+
+		NativeDispatchBenchmark.dispatchNativeEvents(NativeMouseEvent.NATIVE_MOUSE_MOVED, burst);
+
+		// Every queued or merged event is delivered before this task runs.
+		executor.submit(new Runnable() {
+			public void run() {
+				// Marks the end of the burst.
+			}
+		}).get();
+
+		counters.posted += burst;
+		counters.delivered += delivered - start;
+	}
+}
@@ -0,0 +1,107 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Drives the native event dispatcher directly with synthetic native events,
+ * bypassing the platform hook.  Each invocation calls
+ * <code>jni_EventDispatcher()</code> {@link #BATCH} times, which covers the
+ * event mask, conversion, the upcall to GlobalScreen and delivery to a
+ * listener on the calling thread.  The <code>pooling</code> parameter
+ * compares new event objects against
+ * {@link GlobalScreen#setEventObjectPooling(boolean)}.
+ * <p/>
+ *
+ * The native driver is only compiled into the library by
+ * <code>ant bench</code>.  Run with <code>-prof gc</code> to report the
+ * allocation rate per event.
+ *
+ * @since 1.2
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+public class NativeDispatchBenchmark {
+	/** The number of native events dispatched by each invocation. */
+	static final int BATCH = 1000;
+
+	@Param({"key", "mouse", "motion", "wheel"})
+	public String type;
+
+	@Param({"false", "true"})
+	public boolean pooling;
+
+	private GlobalScreen screen;
+	private CountingListener listener;
+	private int id;
+
+	@Setup(Level.Trial)
+	public void setUp() {
+		screen = GlobalScreen.getInstance();
+		screen.setEventDispatcher(BenchmarkEvents.getListenerType(type), new DirectExecutorService());
+		GlobalScreen.setEventObjectPooling(pooling);
+
+		listener = new CountingListener();
+		BenchmarkEvents.addListener(screen, type, listener);
+
+		id = BenchmarkEvents.getID(type);
+	}
+
+	@TearDown(Level.Trial)
+	public void tearDown() {
+		BenchmarkEvents.removeListener(screen, type, listener);
+		GlobalScreen.setEventObjectPooling(false);
+		screen.setEventDispatcher(BenchmarkEvents.getListenerType(type), Executors.newSingleThreadExecutor());
+	}
+
+	@Benchmark
+	@OperationsPerInvocation(BATCH)
+	public long dispatchNativeEvents() {
+		dispatchNativeEvents(id, BATCH);
+
+		return listener.checksum;
+	}
+
+	/**
+	 * Call the native event dispatcher with synthetic events on the current
+	 * thread.
+	 *
+	 * @param id the native event id to synthesize.
+	 * @param count the number of events to dispatch.
+	 * @return the elapsed time in nanoseconds.
+	 */
+	static native long dispatchNativeEvents(int id, int count);
+}
@@ -0,0 +1,93 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.bench;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+import org.jnativehook.NativeHookException;
+import org.jnativehook.mouse.NativeMouseEvent;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures the round trip of {@link GlobalScreen#postNativeEvent(org.jnativehook.NativeInputEvent)}
+ * through the operating system and back to a listener of the native hook.
+ * Each invocation moves the pointer by one pixel and waits until the
+ * resulting motion event is delivered.
+ * <p/>
+ *
+ * <b>Note:</b> This benchmark registers the native hook and moves the real
+ * pointer, so it requires a desktop session.
+ *
+ * @since 1.2
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.SampleTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+public class PostEventBenchmark {
+	private GlobalScreen screen;
+	private CountingListener listener;
+	private long expected;
+
+	@Setup(Level.Trial)
+	public void setUp() throws NativeHookException {
+		screen = GlobalScreen.getInstance();
+
+		listener = new CountingListener();
+		screen.addNativeMouseMotionListener(listener);
+
+		GlobalScreen.registerNativeHook();
+		expected = listener.count;
+	}
+
+	@TearDown(Level.Trial)
+	public void tearDown() {
+		GlobalScreen.unregisterNativeHook();
+		screen.removeNativeMouseMotionListener(listener);
+	}
+
+	@Benchmark
+	public long postNativeEvent() {
+		// Alternate between two positions so that every post moves the pointer.
+		int x = (int) (++expected & 0x01) + 100;
+
+		GlobalScreen.postNativeEvent(new NativeMouseEvent(
+				NativeMouseEvent.NATIVE_MOUSE_MOVED,
+				System.currentTimeMillis(),
+				0x00,
+				x,
+				100,
+				0));
+
+		// Motion from the physical pointer may also arrive, which only shortens the wait.
+		listener.await(expected, TimeUnit.SECONDS.toNanos(1));
+		expected = listener.count;
+
+		return listener.checksum;
+	}
+}
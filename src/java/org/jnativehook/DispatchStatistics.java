@@ -0,0 +1,332 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.mouse.NativeMouseEvent;
+
+/**
+ * An immutable snapshot of the native event dispatch statistics.
+ * <p/>
+ *
+ * Statistics are only collected while enabled with
+ * {@link GlobalScreen#setDispatchStatisticsEnabled(boolean)}.  For each native
+ * event type a count of the events delivered to Java is kept along with a
+ * latency histogram for each of the following stages:
+ * <ul>
+ * 	<li><code>CONVERSION</code> the time spent in native code converting the
+ * 	event into a Java object or native event queue record.</li>
+ * 	<li><code>UPCALL</code> the time spent in the
+ * 	{@link GlobalScreen#dispatchEvent(NativeInputEvent)} call made by the
+ * 	native hook, including any synchronous filters.</li>
+ * 	<li><code>LISTENERS</code> the time spent delivering the event to its
+ * 	listeners on the dispatch executor.</li>
+ * </ul>
+ * <p/>
+ *
+ * Histograms use power of two buckets.  Bucket 0 counts zero length intervals
+ * and bucket <code>n</code> counts intervals of at least
+ * <code>2<sup>n-1</sup></code> and less than <code>2<sup>n</sup></code>
+ * nanoseconds.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see GlobalScreen#getDispatchStatistics()
+ */
+public final class DispatchStatistics {
+	/** Time spent converting the native event. */
+	public static final int CONVERSION	= 0;
+
+	/** Time spent in the dispatch call from the native hook. */
+	public static final int UPCALL		= 1;
+
+	/** Time spent delivering the event to its listeners. */
+	public static final int LISTENERS	= 2;
+
+	/** The number of event types with statistics. */
+	static final int TYPES = 9;
+
+	/** The number of buckets in each histogram. */
+	static final int BUCKETS = 64;
+
+	/** The number of stages measured by the native library. */
+	static final int NATIVE_STAGES = 2;
+
+	/** The number of longs in the native statistics snapshot. */
+	static final int NATIVE_SIZE = 1 + TYPES * (1 + NATIVE_STAGES * BUCKETS);
+
+	/** The number of listener groups with a dispatch queue. */
+	static final int GROUPS = 4;
+
+	/** The number of events discarded by the native event queue. */
+	private final long droppedCount;
+
+	/** The number of events delivered to Java for each event type. */
+	private final long[] eventCounts = new long[TYPES];
+
+	/** The histogram buckets indexed by stage, event type and bucket. */
+	private final long[] latency = new long[(NATIVE_STAGES + 1) * TYPES * BUCKETS];
+
+	/** The pending and maximum number of queued events for each group. */
+	private final int[] pendingCounts = new int[GROUPS];
+	private final int[] maxPendingCounts = new int[GROUPS];
+
+	/**
+	 * Instantiates a new snapshot.
+	 *
+	 * @param nativeStatistics the statistics copied from the native library.
+	 * @param listenerLatency the listener histograms indexed by event type and
+	 * bucket.
+	 * @param pendingCounts the number of queued events for each group.
+	 * @param maxPendingCounts the maximum number of queued events for each
+	 * group.
+	 */
+	DispatchStatistics(long[] nativeStatistics, long[] listenerLatency, int[] pendingCounts, int[] maxPendingCounts) {
+		int offset = 0;
+		this.droppedCount = nativeStatistics[offset++];
+
+		for (int i = 0; i < TYPES; i++) {
+			eventCounts[i] = nativeStatistics[offset++];
+
+			for (int j = 0; j < NATIVE_STAGES; j++) {
+				System.arraycopy(nativeStatistics, offset, latency, (j * TYPES + i) * BUCKETS, BUCKETS);
+				offset += BUCKETS;
+			}
+		}
+
+		System.arraycopy(listenerLatency, 0, latency, LISTENERS * TYPES * BUCKETS, TYPES * BUCKETS);
+
+		System.arraycopy(pendingCounts, 0, this.pendingCounts, 0, GROUPS);
+		System.arraycopy(maxPendingCounts, 0, this.maxPendingCounts, 0, GROUPS);
+	}
+
+	/**
+	 * Returns the number of events discarded because the native event queue
+	 * was full.
+	 *
+	 * @return the number of dropped events.
+	 */
+	public long getDroppedEventCount() {
+		return droppedCount;
+	}
+
+	/**
+	 * Returns the number of events of the specified type delivered to Java.
+	 *
+	 * @param id the native event id, for example
+	 * <code>NativeKeyEvent.NATIVE_KEY_PRESSED</code>.
+	 * @return the number of events delivered.
+	 */
+	public long getEventCount(int id) {
+		return eventCounts[getIndex(id)];
+	}
+
+	/**
+	 * Returns a copy of the latency histogram of a stage for the specified
+	 * event type.
+	 *
+	 * @param stage one of <code>CONVERSION</code>, <code>UPCALL</code> or
+	 * <code>LISTENERS</code>.
+	 * @param id the native event id.
+	 * @return the histogram buckets.
+	 */
+	public long[] getLatencyHistogram(int stage, int id) {
+		long[] histogram = new long[BUCKETS];
+		System.arraycopy(latency, getOffset(stage, id), histogram, 0, BUCKETS);
+
+		return histogram;
+	}
+
+	/**
+	 * Returns an upper bound for the latency percentile of a stage for the
+	 * specified event type.  The result is the exclusive upper limit of the
+	 * histogram bucket containing the percentile.
+	 *
+	 * @param stage one of <code>CONVERSION</code>, <code>UPCALL</code> or
+	 * <code>LISTENERS</code>.
+	 * @param id the native event id.
+	 * @param percentile the percentile between 0 and 100.
+	 * @return the latency upper bound in nanoseconds or 0 if there are no
+	 * samples.
+	 */
+	public long getLatencyPercentile(int stage, int id, double percentile) {
+		int offset = getOffset(stage, id);
+
+		long total = 0;
+		for (int i = 0; i < BUCKETS; i++) {
+			total += latency[offset + i];
+		}
+
+		long bound = 0;
+		if (total > 0) {
+			long rank = (long) Math.ceil(total * Math.max(0.0, Math.min(percentile, 100.0)) / 100.0);
+			if (rank < 1) {
+				rank = 1;
+			}
+
+			long seen = 0;
+			for (int i = 0; i < BUCKETS && seen < rank; i++) {
+				seen += latency[offset + i];
+				if (seen >= rank) {
+					bound = i < BUCKETS - 1 ? 1L << i : Long.MAX_VALUE;
+				}
+			}
+		}
+
+		return bound;
+	}
+
+	/**
+	 * Returns the number of events of the specified type's listener group
+	 * that were waiting for or being delivered by the dispatch executor when
+	 * the snapshot was taken.
+	 *
+	 * @param id the native event id.
+	 * @return the dispatch queue depth.
+	 */
+	public int getPendingEventCount(int id) {
+		return pendingCounts[getGroup(id)];
+	}
+
+	/**
+	 * Returns the largest dispatch queue depth observed for the specified
+	 * event type's listener group.
+	 *
+	 * @param id the native event id.
+	 * @return the maximum dispatch queue depth.
+	 */
+	public int getMaxPendingEventCount(int id) {
+		return maxPendingCounts[getGroup(id)];
+	}
+
+	/**
+	 * Returns the offset of a histogram in the latency array.
+	 *
+	 * @param stage the measured stage.
+	 * @param id the native event id.
+	 * @return the offset of the first bucket.
+	 * @throws IllegalArgumentException if the stage or id is unknown.
+	 */
+	private static int getOffset(int stage, int id) {
+		if (stage < CONVERSION || stage > LISTENERS) {
+			throw new IllegalArgumentException("Unknown stage: " + stage);
+		}
+
+		return (stage * TYPES + getIndex(id)) * BUCKETS;
+	}
+
+	/**
+	 * Returns the histogram bucket for an interval in nanoseconds.
+	 *
+	 * @param nanos the interval.
+	 * @return the bucket index.
+	 */
+	static int getBucket(long nanos) {
+		int bucket = 0;
+		if (nanos > 0) {
+			bucket = Math.min(64 - Long.numberOfLeadingZeros(nanos), BUCKETS - 1);
+		}
+
+		return bucket;
+	}
+
+	/**
+	 * Returns the statistics index for a native event id.  The order matches
+	 * the native event types.
+	 *
+	 * @param id the native event id.
+	 * @return the event type index.
+	 * @throws IllegalArgumentException if the id is unknown.
+	 */
+	static int getIndex(int id) {
+		int index;
+
+		switch (id) {
+			case NativeKeyEvent.NATIVE_KEY_TYPED:
+				index = 0;
+				break;
+
+			case NativeKeyEvent.NATIVE_KEY_PRESSED:
+				index = 1;
+				break;
+
+			case NativeKeyEvent.NATIVE_KEY_RELEASED:
+				index = 2;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_CLICKED:
+				index = 3;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_PRESSED:
+				index = 4;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_RELEASED:
+				index = 5;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_MOVED:
+				index = 6;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_DRAGGED:
+				index = 7;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_WHEEL:
+				index = 8;
+				break;
+
+			default:
+				throw new IllegalArgumentException("Unknown event id: " + id);
+		}
+
+		return index;
+	}
+
+	/**
+	 * Returns the listener group index for a native event id, in the order
+	 * of the <code>GlobalScreen</code> event mask bits.
+	 *
+	 * @param id the native event id.
+	 * @return the listener group index.
+	 */
+	static int getGroup(int id) {
+		int index = getIndex(id);
+
+		int group;
+		if (index <= 2) {
+			group = 0;
+		}
+		else if (index <= 5) {
+			group = 1;
+		}
+		else if (index <= 7) {
+			group = 2;
+		}
+		else {
+			group = 3;
+		}
+
+		return group;
+	}
+}
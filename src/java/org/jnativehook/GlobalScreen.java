@@ -18,23 +18,37 @@
 package org.jnativehook;
 
 // Imports.
+import org.jnativehook.keyboard.NativeHotkeyListener;
 import org.jnativehook.keyboard.NativeKeyEvent;
 import org.jnativehook.keyboard.NativeKeyListener;
+import org.jnativehook.keyboard.NativeKeyPrimitiveListener;
 import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseGestureEvent;
+import org.jnativehook.mouse.NativeMouseGestureListener;
 import org.jnativehook.mouse.NativeMouseListener;
 import org.jnativehook.mouse.NativeMouseMotionListener;
+import org.jnativehook.mouse.NativeMousePrimitiveListener;
 import org.jnativehook.mouse.NativeMouseWheelEvent;
 import org.jnativehook.mouse.NativeMouseWheelListener;
 
-import javax.swing.event.EventListenerList;
 import java.io.File;
-import java.io.FileOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.lang.reflect.Array;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.Arrays;
 import java.util.EventListener;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
 import java.util.concurrent.ThreadFactory;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicIntegerArray;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicLongArray;
+import java.util.logging.Level;
+import java.util.logging.Logger;
 
 /**
  * GlobalScreen is used to represent the native screen area that Java does not
@@ -56,14 +70,355 @@ public class GlobalScreen {
 	private static final GlobalScreen instance = new GlobalScreen();
 
 	/**
-	 * The list of event listeners to notify.
+	 * The listeners to notify for each type of native event.  These arrays are
+	 * replaced, never modified, when listeners are added or removed so that
+	 * the dispatch threads can read them without locking or allocation.
 	 */
-	private static final EventListenerList eventListeners = new EventListenerList();
+	private static volatile NativeKeyListener[] keyListeners = new NativeKeyListener[0];
+	private static volatile NativeMouseListener[] mouseListeners = new NativeMouseListener[0];
+	private static volatile NativeMouseMotionListener[] mouseMotionListeners = new NativeMouseMotionListener[0];
+	private static volatile NativeMouseWheelListener[] mouseWheelListeners = new NativeMouseWheelListener[0];
 
 	/**
-	 * The service to dispatch events.
+	 * The <code>EVENT_MASK_*</code> groups that have at least one listener
+	 * expecting an event object.
 	 */
-	private static ExecutorService eventExecutor;
+	private static volatile int eventListenerMask = 0x00;
+
+	/**
+	 * The synchronous filters for each <code>EVENT_MASK_*</code> group,
+	 * indexed by the bit position of the group.  Both the outer and inner
+	 * arrays are replaced, never modified, when filters are added or removed.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeEventFilter[][] eventFilters = new NativeEventFilter[][] {
+		new NativeEventFilter[0],
+		new NativeEventFilter[0],
+		new NativeEventFilter[0],
+		new NativeEventFilter[0]
+	};
+
+	/**
+	 * The maximum time in nanoseconds the filters may take for a single event
+	 * before the event is passed through to the native system.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile long eventFilterBudget = TimeUnit.MICROSECONDS.toNanos(500);
+
+	/**
+	 * The number of events passed through because the filter budget was
+	 * exceeded.
+	 *
+	 * @since 1.2
+	 */
+	private static final AtomicLong eventFilterOverBudgetCount = new AtomicLong();
+
+	/**
+	 * The number of native event types with dispatch statistics.
+	 *
+	 * @since 1.2
+	 */
+	private static final int STATISTICS_TYPES = DispatchStatistics.TYPES;
+
+	/**
+	 * The number of buckets in each dispatch latency histogram.
+	 *
+	 * @since 1.2
+	 */
+	private static final int STATISTICS_BUCKETS = DispatchStatistics.BUCKETS;
+
+	/**
+	 * Whether dispatch statistics are being collected.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile boolean dispatchStatistics = false;
+
+	/**
+	 * The listener latency histograms indexed by event type and bucket.
+	 *
+	 * @since 1.2
+	 */
+	private static final AtomicLongArray listenerLatency = new AtomicLongArray(STATISTICS_TYPES * STATISTICS_BUCKETS);
+
+	/**
+	 * The current and maximum number of queued events for each listener group.
+	 *
+	 * @since 1.2
+	 */
+	private static final AtomicIntegerArray pendingEvents = new AtomicIntegerArray(DispatchStatistics.GROUPS);
+	private static final AtomicIntegerArray maxPendingEvents = new AtomicIntegerArray(DispatchStatistics.GROUPS);
+
+	/**
+	 * The native log levels.  These values must match the
+	 * <code>LOG_LEVEL_*</code> definitions used by the native library.
+	 *
+	 * @since 1.2
+	 */
+	private static final int LOG_LEVEL_DEBUG = 1;
+	private static final int LOG_LEVEL_INFO = 2;
+	private static final int LOG_LEVEL_WARN = 3;
+	private static final int LOG_LEVEL_ERROR = 4;
+
+	/**
+	 * The maximum number of native log messages copied with a single call to
+	 * {@link #drainLogRecords(int[], String[], int)}.
+	 *
+	 * @since 1.2
+	 */
+	private static final int LOG_BATCH_SIZE = 16;
+
+	/**
+	 * The number of milliseconds the log thread waits for native messages
+	 * before refreshing the cached native log level.  The logging API does not
+	 * notify anyone when a level changes, so changes made with
+	 * <code>Logger.setLevel(Level)</code> take effect within this interval.
+	 *
+	 * @since 1.2
+	 */
+	private static final int LOG_LEVEL_REFRESH = 1000;
+
+	/**
+	 * The thread delivering native log messages to the Java logger.
+	 *
+	 * @since 1.2
+	 */
+	private static Thread logThread;
+
+	/**
+	 * The service to dispatch <code>NativeKeyListener</code> events.
+	 */
+	private static volatile ExecutorService keyEventExecutor;
+
+	/**
+	 * The service to dispatch <code>NativeMouseListener</code> events.
+	 */
+	private static volatile ExecutorService mouseEventExecutor;
+
+	/**
+	 * The service to dispatch <code>NativeMouseMotionListener</code> events.
+	 */
+	private static volatile ExecutorService mouseMotionEventExecutor;
+
+	/**
+	 * The service to dispatch <code>NativeMouseWheelListener</code> events.
+	 */
+	private static volatile ExecutorService mouseWheelEventExecutor;
+
+	/**
+	 * The number of <code>long</code> values used to represent a single event
+	 * in the native event queue.
+	 *
+	 * @since 1.2
+	 */
+	private static final int EVENT_RECORD_SIZE = 6;
+
+	/**
+	 * The maximum number of events copied from the native event queue with a
+	 * single call to {@link #drainEvents(ByteBuffer)}.
+	 *
+	 * @since 1.2
+	 */
+	private static final int EVENT_BATCH_SIZE = 64;
+
+	/**
+	 * The native event mask bit for <code>NativeKeyListener</code> events.
+	 *
+	 * @since 1.2
+	 */
+	private static final int EVENT_MASK_KEY = 1 << 0;
+
+	/**
+	 * The native event mask bit for <code>NativeMouseListener</code> events.
+	 *
+	 * @since 1.2
+	 */
+	private static final int EVENT_MASK_MOUSE = 1 << 1;
+
+	/**
+	 * The native event mask bit for <code>NativeMouseMotionListener</code>
+	 * events.
+	 *
+	 * @since 1.2
+	 */
+	private static final int EVENT_MASK_MOUSE_MOTION = 1 << 2;
+
+	/**
+	 * The native event mask bit for <code>NativeMouseWheelListener</code>
+	 * events.
+	 *
+	 * @since 1.2
+	 */
+	private static final int EVENT_MASK_MOUSE_WHEEL = 1 << 3;
+
+	/**
+	 * The listeners receiving events as a reusable <code>NativeEventView</code>.
+	 * This array is replaced, never modified, when listeners are added or
+	 * removed so that the drain thread can read it without allocation.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeEventViewListener[] eventViewListeners = new NativeEventViewListener[0];
+
+	/**
+	 * The consumers receiving every native event through their own bounded
+	 * queue.  This array is replaced, never modified, when consumers are added
+	 * or removed.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeEventSubscription[] eventSubscriptions = new NativeEventSubscription[0];
+
+	/**
+	 * The listeners notified when a registered hotkey is pressed.  This array
+	 * is replaced, never modified, when listeners are added or removed.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeHotkeyListener[] hotkeyListeners = new NativeHotkeyListener[0];
+
+	/**
+	 * The listeners notified when the native settings change.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeSettingsListener[] settingsListeners = new NativeSettingsListener[0];
+
+	/**
+	 * The listeners notified when the native library recognizes a mouse
+	 * gesture.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeMouseGestureListener[] gestureListeners = new NativeMouseGestureListener[0];
+
+	/**
+	 * Serializes updates of the native gesture stage.  The settings thread
+	 * uses this lock instead of the <code>GlobalScreen</code> instance lock,
+	 * which may be held while the settings thread is stopped.
+	 *
+	 * @since 1.2
+	 */
+	private static final Object gestureLock = new Object();
+
+	/**
+	 * The listeners called by the native library with the primitive values
+	 * of each native key event.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeKeyPrimitiveListener[] keyPrimitiveListeners = new NativeKeyPrimitiveListener[0];
+
+	/**
+	 * The listeners called by the native library with the primitive values
+	 * of each native mouse button and motion event.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile NativeMousePrimitiveListener[] mousePrimitiveListeners = new NativeMousePrimitiveListener[0];
+
+	/**
+	 * The maximum number of registered hotkeys.  This must match the
+	 * <code>HOTKEY_MAX</code> definition used by the native library.
+	 *
+	 * @since 1.2
+	 */
+	private static final int HOTKEY_MAX = 256;
+
+	/**
+	 * The number of ints describing each hotkey passed to the native library:
+	 * key code, modifiers, key location, id and <code>HOTKEY_*</code> flags.
+	 *
+	 * @since 1.2
+	 */
+	private static final int HOTKEY_RECORD_SIZE = 5;
+
+	/**
+	 * Hotkey flag to consume the key events of a matching hotkey.
+	 *
+	 * @since 1.2
+	 */
+	private static final int HOTKEY_CONSUME = 0x01;
+
+	/**
+	 * The registered hotkey records, guarded by the <code>GlobalScreen</code>
+	 * instance.
+	 *
+	 * @since 1.2
+	 */
+	private static int[] hotkeys = new int[0];
+
+	/**
+	 * The native system settings that can be queried with
+	 * {@link #getNativeProperty(int)}.  These values are used as indexes by
+	 * the <code>NativeSystem</code> property cache.
+	 *
+	 * @since 1.2
+	 */
+	static final int PROPERTY_AUTO_REPEAT_RATE = 0;
+	static final int PROPERTY_AUTO_REPEAT_DELAY = 1;
+	static final int PROPERTY_POINTER_ACCELERATION_MULTIPLIER = 2;
+	static final int PROPERTY_POINTER_ACCELERATION_THRESHOLD = 3;
+	static final int PROPERTY_POINTER_SENSITIVITY = 4;
+	static final int PROPERTY_MULTI_CLICK_INTERVAL = 5;
+
+	/**
+	 * The number of native system settings.
+	 *
+	 * @since 1.2
+	 */
+	static final int PROPERTY_COUNT = 6;
+
+	/**
+	 * The gesture types passed to {@link #dispatchGesture}.  These values
+	 * must match the <code>GESTURE_*</code> types used by the native library.
+	 *
+	 * @since 1.2
+	 */
+	static final int GESTURE_DRAG_STARTED = 0;
+	static final int GESTURE_DRAG_ENDED = 1;
+	static final int GESTURE_MULTI_CLICKED = 2;
+	static final int GESTURE_WHEEL_BURST = 3;
+
+	/**
+	 * The multi click interval in milliseconds used by the gesture stage when
+	 * the native setting is not available.
+	 *
+	 * @since 1.2
+	 */
+	private static final long DEFAULT_MULTI_CLICK_INTERVAL = 500;
+
+	/**
+	 * The thread used to drain the native event queue.
+	 *
+	 * @since 1.2
+	 */
+	private static Thread eventQueueThread;
+
+	/**
+	 * Set by {@link #shutdown(long, TimeUnit, ShutdownPolicy)} to discard the
+	 * events remaining in the native event queue instead of dispatching them.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile boolean eventQueueDiscard = false;
+
+	/**
+	 * Whether events are stamped with the time they reach a dispatcher.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile boolean eventTimestamps = false;
+
+	/**
+	 * Whether mouse motion events are coalesced while a previous motion event
+	 * is being dispatched.
+	 *
+	 * @since 1.2
+	 */
+	private static volatile boolean mouseMotionCoalescing = false;
 
 	/**
 	 * Private constructor to prevent multiple instances of the global screen.
@@ -74,7 +429,8 @@ public class GlobalScreen {
 		// Unpack and Load the native library.
 		GlobalScreen.loadNativeLibrary();
 
-		GlobalScreen.eventExecutor = Executors.newSingleThreadExecutor(new ThreadFactory() {
+		// All listener types share a single dispatch thread by default.
+		ExecutorService eventExecutor = Executors.newSingleThreadExecutor(new ThreadFactory() {
 			public Thread newThread(Runnable r) {
 				Thread t = new Thread(r);
 				t.setName("JNativeHook Native Dispatch");
@@ -82,8 +438,109 @@ public class GlobalScreen {
 				return t;
 			}
 		});
+
+		GlobalScreen.keyEventExecutor = eventExecutor;
+		GlobalScreen.mouseEventExecutor = eventExecutor;
+		GlobalScreen.mouseMotionEventExecutor = eventExecutor;
+		GlobalScreen.mouseWheelEventExecutor = eventExecutor;
+
+		// Deliver native log messages without blocking the logging thread.
+		GlobalScreen.startNativeLogger();
+	}
+
+	/**
+	 * Start the thread that delivers queued native log messages to the
+	 * <code>org.jnativehook</code> logger.  Until this thread is running,
+	 * native messages are logged synchronously by the thread producing them.
+	 *
+	 * @since 1.2
+	 */
+	private static synchronized void startNativeLogger() {
+		if (logThread == null) {
+			final Logger logger = Logger.getLogger(GlobalScreen.class.getPackage().getName());
+
+			// Messages below the current level are discarded natively.
+			GlobalScreen.updateNativeLogLevel();
+			GlobalScreen.enableLogQueue();
+
+			logThread = new Thread(new Runnable() {
+				public void run() {
+					int[] levels = new int[LOG_BATCH_SIZE];
+					String[] messages = new String[LOG_BATCH_SIZE];
+
+					int count;
+					while ((count = GlobalScreen.drainLogRecords(levels, messages, LOG_LEVEL_REFRESH)) >= 0) {
+						for (int i = 0; i < count; i++) {
+							switch (levels[i]) {
+								case LOG_LEVEL_DEBUG:
+									logger.fine(messages[i]);
+									break;
+
+								case LOG_LEVEL_INFO:
+									logger.info(messages[i]);
+									break;
+
+								case LOG_LEVEL_WARN:
+									logger.warning(messages[i]);
+									break;
+
+								case LOG_LEVEL_ERROR:
+									logger.severe(messages[i]);
+									break;
+							}
+
+							messages[i] = null;
+						}
+
+						GlobalScreen.updateNativeLogLevel();
+					}
+				}
+			});
+			logThread.setName("JNativeHook Native Logger");
+			logThread.setDaemon(true);
+			logThread.start();
+		}
 	}
 
+	/**
+	 * Refresh the native copy of the <code>org.jnativehook</code> logger's
+	 * effective level.  Messages below this level are discarded before they
+	 * are formatted.
+	 *
+	 * @since 1.2
+	 */
+	private static native void updateNativeLogLevel();
+
+	/**
+	 * Start delivering native log messages through the native log queue.
+	 *
+	 * @since 1.2
+	 */
+	private static native void enableLogQueue();
+
+	/**
+	 * Stop delivering native log messages through the native log queue and
+	 * wake the log thread.
+	 *
+	 * @since 1.2
+	 */
+	private static native void disableLogQueue();
+
+	/**
+	 * Copy queued native log messages and their levels into the specified
+	 * arrays.  This method will block until at least one message is
+	 * available or the timeout elapses.
+	 *
+	 * @param levels the array receiving the <code>LOG_LEVEL_*</code> of each
+	 * message.
+	 * @param messages the array receiving the messages.
+	 * @param timeout the maximum number of milliseconds to wait.
+	 * @return the number of messages copied, zero if the timeout elapsed, or
+	 * -1 if the queue was disabled.
+	 * @since 1.2
+	 */
+	private static native int drainLogRecords(int[] levels, String[] messages, int timeout);
+
 	/**
 	 * A destructor that will perform native cleanup by calling the
 	 * {@link #unregisterNativeHook} method.  This method will not run until the
@@ -99,369 +556,2285 @@ public class GlobalScreen {
 			GlobalScreen.unloadNativeLibrary();
 		}
 
-		// Shutdown the current Event executor.
-		eventExecutor.shutdownNow();
-		eventExecutor = null;
+		// Stop the native log thread, later messages are logged synchronously.
+		GlobalScreen.disableLogQueue();
+
+		// Shutdown the current Event executors.
+		ExecutorService[] executors = new ExecutorService[] {
+			keyEventExecutor,
+			mouseEventExecutor,
+			mouseMotionEventExecutor,
+			mouseWheelEventExecutor
+		};
+
+		keyEventExecutor = null;
+		mouseEventExecutor = null;
+		mouseMotionEventExecutor = null;
+		mouseWheelEventExecutor = null;
+
+		for (int i = 0; i < executors.length; i++) {
+			if (executors[i] != null) {
+				executors[i].shutdownNow();
+			}
+		}
+
+		super.finalize();
+	}
+
+	/**
+	 * Returns the singleton instance of <code>GlobalScreen</code>.
+	 *
+	 * @return singleton instance of <code>GlobalScreen</code>
+	 */
+	public static synchronized GlobalScreen getInstance() {
+		return GlobalScreen.instance;
+	}
+
+	/**
+	 * Adds the specified native key listener to receive key events from the
+	 * native system. If listener is null, no exception is thrown and no action
+	 * is performed.
+	 *
+	 * @param listener a native key listener object
+	 */
+	public synchronized void addNativeKeyListener(NativeKeyListener listener) {
+		if (listener != null) {
+			keyListeners = addListener(keyListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native key listener so that it no longer receives
+	 * key events from the native system. This method performs no function if
+	 * the listener specified by the argument was not previously added.  If
+	 * listener is null, no exception is thrown and no action is performed.
+	 *
+	 * @param listener a native key listener object
+	 */
+	public synchronized void removeNativeKeyListener(NativeKeyListener listener) {
+		if (listener != null) {
+			keyListeners = removeListener(keyListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Adds the specified native hotkey listener to be notified when a hotkey
+	 * registered with
+	 * {@link #registerNativeHotkey(int, int, int, int, boolean)} is pressed.
+	 * If listener is null, no exception is thrown and no action is performed.
+	 *
+	 * @param listener a native hotkey listener object
+	 * @since 1.2
+	 */
+	public synchronized void addNativeHotkeyListener(NativeHotkeyListener listener) {
+		if (listener != null) {
+			hotkeyListeners = addListener(hotkeyListeners, listener);
+		}
+	}
+
+	/**
+	 * Removes the specified native hotkey listener so that it is no longer
+	 * notified of hotkeys.  If listener is null, no exception is thrown and no
+	 * action is performed.
+	 *
+	 * @param listener a native hotkey listener object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeHotkeyListener(NativeHotkeyListener listener) {
+		if (listener != null) {
+			hotkeyListeners = removeListener(hotkeyListeners, listener);
+		}
+	}
+
+	/**
+	 * Adds the specified native settings listener to be notified when the
+	 * native keyboard or pointer settings exposed by <code>NativeSystem</code>
+	 * change.  The native library waits for the platform's settings change
+	 * notification while at least one listener is registered, so the
+	 * settings do not need to be polled.  If listener is null, no exception
+	 * is thrown and no action is performed.
+	 * <p/>
+	 *
+	 * <b>Note:</b> Settings change notifications are currently available on
+	 * Windows and X11.
+	 *
+	 * @param listener a native settings listener object
+	 * @since 1.2
+	 */
+	public synchronized void addNativeSettingsListener(NativeSettingsListener listener) {
+		if (listener != null) {
+			if (settingsListeners.length == 0) {
+				GlobalScreen.setNativeSettingsWatcher(true);
+			}
+
+			settingsListeners = addListener(settingsListeners, listener);
+
+			// Cache the current values so that changes can be detected.
+			NativeSystem.getProperties();
+		}
+	}
+
+	/**
+	 * Removes the specified native settings listener so that it is no longer
+	 * notified of settings changes.  If listener is null, no exception is
+	 * thrown and no action is performed.
+	 *
+	 * @param listener a native settings listener object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeSettingsListener(NativeSettingsListener listener) {
+		if (listener != null && settingsListeners.length > 0) {
+			settingsListeners = removeListener(settingsListeners, listener);
+
+			if (settingsListeners.length == 0) {
+				GlobalScreen.setNativeSettingsWatcher(false);
+			}
+		}
+	}
+
+	/**
+	 * Called by the native settings thread when the platform reports that the
+	 * native settings may have changed.  The cached settings are refreshed
+	 * and the listeners are notified if any value actually changed.
+	 *
+	 * @since 1.2
+	 */
+	private static void settingsChanged() {
+		long[] previous = NativeSystem.getProperties();
+		NativeSystem.invalidateProperties();
+		long[] current = NativeSystem.getProperties();
+
+		// The gesture stage uses the native multi click interval.
+		// The instance lock is not taken here as shutdown() holds it while it
+		// waits for this thread to exit.
+		if (previous[PROPERTY_MULTI_CLICK_INTERVAL] != current[PROPERTY_MULTI_CLICK_INTERVAL] && gestureListeners.length > 0) {
+			GlobalScreen.updateNativeGestures();
+		}
+
+		NativeSettingsListener[] listeners = settingsListeners;
+		if (listeners.length > 0 && !Arrays.equals(previous, current)) {
+			NativeSettingsEvent event = new NativeSettingsEvent(GlobalScreen.getInstance(), previous, current);
+
+			for (int i = 0; i < listeners.length; i++) {
+				try {
+					listeners[i].nativeSettingsChanged(event);
+				}
+				catch (Throwable t) {
+					GlobalScreen.logCallbackException("settings listener", t);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Start or stop the native thread waiting for settings change
+	 * notifications.
+	 *
+	 * @param enabled true to start the thread.
+	 * @return false if notifications are not available on this platform or
+	 * the thread did not stop in time.
+	 * @since 1.2
+	 */
+	private static native boolean setNativeSettingsWatcher(boolean enabled);
+
+	/**
+	 * Adds the specified native mouse gesture listener to receive drag, multi
+	 * click and wheel burst gestures.  Gestures are recognized by the native
+	 * library before the raw events are passed to Java, so the raw mouse
+	 * events only cross into Java if a raw mouse listener is also registered.
+	 * If listener is null, no exception is thrown and no action is performed.
+	 *
+	 * @param listener a native mouse gesture listener object
+	 * @since 1.2
+	 */
+	public synchronized void addNativeMouseGestureListener(NativeMouseGestureListener listener) {
+		if (listener != null) {
+			gestureListeners = addListener(gestureListeners, listener);
+			GlobalScreen.updateNativeGestures();
+		}
+	}
+
+	/**
+	 * Removes the specified native mouse gesture listener so that it no
+	 * longer receives gestures.  If listener is null, no exception is thrown
+	 * and no action is performed.
+	 *
+	 * @param listener a native mouse gesture listener object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeMouseGestureListener(NativeMouseGestureListener listener) {
+		if (listener != null && gestureListeners.length > 0) {
+			gestureListeners = removeListener(gestureListeners, listener);
+			GlobalScreen.updateNativeGestures();
+		}
+	}
+
+	/**
+	 * Enable the native gesture stage while gesture listeners are registered
+	 * and pass it the current native multi click interval.  The listeners
+	 * are read under the gesture lock so that the last update always
+	 * reflects the current listeners.
+	 *
+	 * @since 1.2
+	 */
+	private static void updateNativeGestures() {
+		synchronized (gestureLock) {
+			long interval = NativeSystem.getMultiClickInterval();
+			if (interval < 0) {
+				interval = DEFAULT_MULTI_CLICK_INTERVAL;
+			}
+
+			GlobalScreen.setNativeGestures(gestureListeners.length > 0, (int) interval);
+		}
+	}
+
+	/**
+	 * Enable or disable the native gesture stage.
+	 *
+	 * @param enabled true to recognize gestures on the native hook thread.
+	 * @param interval the multi click interval in milliseconds.
+	 * @since 1.2
+	 */
+	private static native void setNativeGestures(boolean enabled, int interval);
+
+	/**
+	 * Adds the specified native key primitive listener.  The listener is
+	 * called on the native hook thread with the values of each native key
+	 * pressed and released event without creating a
+	 * <code>NativeKeyEvent</code>.  If listener is null, no exception is thrown
+	 * and no action is performed.
+	 *
+	 * @param listener a native key primitive listener object
+	 * @since 1.2
+	 */
+	public synchronized void addNativeKeyPrimitiveListener(NativeKeyPrimitiveListener listener) {
+		if (listener != null) {
+			keyPrimitiveListeners = addListener(keyPrimitiveListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native key primitive listener so that it no
+	 * longer receives native key events.  If listener is null, no exception is
+	 * thrown and no action is performed.
+	 *
+	 * @param listener a native key primitive listener object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeKeyPrimitiveListener(NativeKeyPrimitiveListener listener) {
+		if (listener != null && keyPrimitiveListeners.length > 0) {
+			keyPrimitiveListeners = removeListener(keyPrimitiveListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Adds the specified native mouse primitive listener.  The listener is
+	 * called on the native hook thread with the values of each native mouse
+	 * button and motion event without creating a
+	 * <code>NativeMouseEvent</code>.  If listener is null, no exception is
+	 * thrown and no action is performed.
+	 *
+	 * @param listener a native mouse primitive listener object
+	 * @since 1.2
+	 */
+	public synchronized void addNativeMousePrimitiveListener(NativeMousePrimitiveListener listener) {
+		if (listener != null) {
+			mousePrimitiveListeners = addListener(mousePrimitiveListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native mouse primitive listener so that it no
+	 * longer receives native mouse events.  If listener is null, no exception
+	 * is thrown and no action is performed.
+	 *
+	 * @param listener a native mouse primitive listener object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeMousePrimitiveListener(NativeMousePrimitiveListener listener) {
+		if (listener != null && mousePrimitiveListeners.length > 0) {
+			mousePrimitiveListeners = removeListener(mousePrimitiveListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Register a hotkey that is matched by the native library.  Key events
+	 * that do not match a hotkey are not passed to Java on its behalf, and a
+	 * matching key press only delivers the hotkey id to the registered
+	 * <code>NativeHotkeyListener</code> objects.
+	 * <p/>
+	 *
+	 * The modifiers are a combination of the <code>NativeInputEvent</code>
+	 * <code>*_MASK</code> key modifiers.  A group such as
+	 * <code>CTRL_MASK</code> accepts either side, while a single side such as
+	 * <code>CTRL_L_MASK</code> must be held exactly.  Modifier groups that are
+	 * not part of the hotkey must not be held.  Registering an id again
+	 * replaces the previous hotkey.
+	 *
+	 * @param id a non-negative id passed to the hotkey listeners.
+	 * @param keyCode the <code>NativeKeyEvent</code> virtual key code.
+	 * @param modifiers the key modifiers that must be held.
+	 * @param keyLocation the key location or
+	 * <code>NativeKeyEvent.KEY_LOCATION_UNKNOWN</code> for any location.
+	 * @param consume true to consume the key events of the hotkey so they
+	 * are not seen by other applications or key listeners.
+	 * @throws IllegalArgumentException if the id is negative, the modifiers
+	 * contain mouse button masks or too many hotkeys are registered.
+	 * @since 1.2
+	 */
+	public synchronized void registerNativeHotkey(int id, int keyCode, int modifiers, int keyLocation, boolean consume) {
+		if (id < 0) {
+			throw new IllegalArgumentException("The hotkey id must not be negative.");
+		}
+
+		int keyMask = NativeInputEvent.SHIFT_MASK | NativeInputEvent.CTRL_MASK | NativeInputEvent.META_MASK | NativeInputEvent.ALT_MASK;
+		if ((modifiers & ~keyMask) != 0) {
+			throw new IllegalArgumentException("Only key modifiers may be used for a hotkey.");
+		}
+
+		int[] records = removeHotkey(hotkeys, id);
+		if (records.length / HOTKEY_RECORD_SIZE >= HOTKEY_MAX) {
+			throw new IllegalArgumentException("Too many hotkeys are registered.");
+		}
+
+		int[] copy = new int[records.length + HOTKEY_RECORD_SIZE];
+		System.arraycopy(records, 0, copy, 0, records.length);
+		copy[records.length] = keyCode;
+		copy[records.length + 1] = modifiers;
+		copy[records.length + 2] = keyLocation;
+		copy[records.length + 3] = id;
+		copy[records.length + 4] = consume ? HOTKEY_CONSUME : 0x00;
+
+		hotkeys = copy;
+		GlobalScreen.setNativeHotkeys(copy, copy.length / HOTKEY_RECORD_SIZE);
+	}
+
+	/**
+	 * Unregister the hotkey with the specified id.  This method performs no
+	 * function if no hotkey was registered with the id.
+	 *
+	 * @param id the id the hotkey was registered with.
+	 * @since 1.2
+	 */
+	public synchronized void unregisterNativeHotkey(int id) {
+		int[] records = removeHotkey(hotkeys, id);
+
+		if (records.length != hotkeys.length) {
+			hotkeys = records;
+			GlobalScreen.setNativeHotkeys(records, records.length / HOTKEY_RECORD_SIZE);
+		}
+	}
+
+	/**
+	 * Returns a copy of the hotkey records without the specified id.
+	 *
+	 * @param records the hotkey records.
+	 * @param id the hotkey id to remove.
+	 * @return the remaining hotkey records.
+	 * @since 1.2
+	 */
+	private static int[] removeHotkey(int[] records, int id) {
+		int[] copy = records;
+
+		for (int i = 0; i < records.length; i += HOTKEY_RECORD_SIZE) {
+			if (records[i + 3] == id) {
+				copy = new int[records.length - HOTKEY_RECORD_SIZE];
+				System.arraycopy(records, 0, copy, 0, i);
+				System.arraycopy(records, i + HOTKEY_RECORD_SIZE, copy, i, records.length - i - HOTKEY_RECORD_SIZE);
+				break;
+			}
+		}
+
+		return copy;
+	}
+
+	/**
+	 * Replace the native hotkey table.
+	 *
+	 * @param records the hotkey records.
+	 * @param count the number of hotkeys.
+	 * @since 1.2
+	 */
+	private static native void setNativeHotkeys(int[] records, int count);
+
+	/**
+	 * Adds the specified native mouse listener to receive mouse events from the
+	 * native system. If listener is null, no exception is thrown and no action
+	 * is performed.
+	 *
+	 * @param listener a native mouse listener object
+	 */
+	public synchronized void addNativeMouseListener(NativeMouseListener listener) {
+		if (listener != null) {
+			mouseListeners = addListener(mouseListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native mouse listener so that it no longer receives
+	 * mouse events from the native system. This method performs no function if
+	 * the listener specified by the argument was not previously added.  If
+	 * listener is null, no exception is thrown and no action is performed.
+	 *
+	 * @param listener a native mouse listener object
+	 */
+	public synchronized void removeNativeMouseListener(NativeMouseListener listener) {
+		if (listener != null) {
+			mouseListeners = removeListener(mouseListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Adds the specified native mouse motion listener to receive mouse motion
+	 * events from the native system. If listener is null, no exception is
+	 * thrown and no action is performed.
+	 *
+	 * @param listener a native mouse motion listener object
+	 */
+	public synchronized void addNativeMouseMotionListener(NativeMouseMotionListener listener) {
+		if (listener != null) {
+			mouseMotionListeners = addListener(mouseMotionListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native mouse motion listener so that it no longer
+	 * receives mouse motion events from the native system. This method performs
+	 * no function if the listener specified by the argument was not previously
+	 * added.  If listener is null, no exception is thrown and no action is
+	 * performed.
+	 *
+	 * @param listener a native mouse motion listener object
+	 */
+	public synchronized void removeNativeMouseMotionListener(NativeMouseMotionListener listener) {
+		if (listener != null) {
+			mouseMotionListeners = removeListener(mouseMotionListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Adds the specified native mouse wheel listener to receive mouse wheel
+	 * events from the native system. If listener is null, no exception is
+	 * thrown and no action is performed.
+	 *
+	 * @param listener a native mouse wheel listener object
+	 * @since 1.1
+	 */
+	public synchronized void addNativeMouseWheelListener(NativeMouseWheelListener listener) {
+		if (listener != null) {
+			mouseWheelListeners = addListener(mouseWheelListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native mouse wheel listener so that it no longer
+	 * receives mouse wheel events from the native system. This method performs
+	 * no function if the listener specified by the argument was not previously
+	 * added.  If listener is null, no exception is thrown and no action is
+	 * performed.
+	 *
+	 * @param listener a native mouse wheel listener object
+	 * @since 1.1
+	 */
+	public synchronized void removeNativeMouseWheelListener(NativeMouseWheelListener listener) {
+		if (listener != null) {
+			mouseWheelListeners = removeListener(mouseWheelListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Adds the specified native event view listener to receive events from the
+	 * native event queue without allocating an event object for each event.
+	 * If listener is null, no exception is thrown and no action is performed.
+	 *
+	 * @param listener a native event view listener object
+	 * @see #setEventQueueEnabled(boolean)
+	 * @since 1.2
+	 */
+	public synchronized void addNativeEventViewListener(NativeEventViewListener listener) {
+		if (listener != null) {
+			eventViewListeners = addListener(eventViewListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified native event view listener so that it no longer
+	 * receives events from the native event queue. This method performs no
+	 * function if the listener specified by the argument was not previously
+	 * added.  If listener is null, no exception is thrown and no action is
+	 * performed.
+	 *
+	 * @param listener a native event view listener object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeEventViewListener(NativeEventViewListener listener) {
+		if (listener != null) {
+			eventViewListeners = removeListener(eventViewListeners, listener);
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Adds the specified native event consumer to receive every native event
+	 * on its own thread.  Each consumer has a bounded queue of the specified
+	 * capacity, and the overflow policy decides what happens to new events
+	 * while the queue is full.  The returned subscription reports the
+	 * consumer's drop and lag counters.
+	 * <p/>
+	 *
+	 * Consumers are fed from the same native events as the registered
+	 * listeners, so any number of consumers only cost one native hook.
+	 * Pooled event objects are copied before they are queued.
+	 *
+	 * @param consumer a native event consumer object
+	 * @param capacity the maximum number of events queued for the consumer.
+	 * @param policy the action taken when the queue is full.
+	 * @return the subscription of the consumer.
+	 * @throws IllegalArgumentException if the consumer or the policy is null
+	 * or the capacity is not positive.
+	 * @see #setEventObjectPooling(boolean)
+	 * @since 1.2
+	 */
+	public synchronized NativeEventSubscription addNativeEventConsumer(NativeEventConsumer consumer, int capacity, NativeEventSubscription.OverflowPolicy policy) {
+		if (consumer == null || policy == null) {
+			throw new IllegalArgumentException("The consumer and overflow policy must not be null.");
+		}
+		else if (capacity <= 0) {
+			throw new IllegalArgumentException("The consumer queue capacity must be positive.");
+		}
+
+		NativeEventSubscription subscription = new NativeEventSubscription(consumer, capacity, policy);
+
+		NativeEventSubscription[] copy = new NativeEventSubscription[eventSubscriptions.length + 1];
+		System.arraycopy(eventSubscriptions, 0, copy, 0, eventSubscriptions.length);
+		copy[eventSubscriptions.length] = subscription;
+		eventSubscriptions = copy;
+
+		GlobalScreen.updateNativeEventMask();
+
+		return subscription;
+	}
+
+	/**
+	 * Removes the subscription of the specified native event consumer.  Events
+	 * still queued for the consumer are discarded, and an event being
+	 * delivered is allowed to complete.  This method performs no function if
+	 * the consumer was not previously added.  If consumer is null, no
+	 * exception is thrown and no action is performed.
+	 *
+	 * @param consumer a native event consumer object
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeEventConsumer(NativeEventConsumer consumer) {
+		NativeEventSubscription[] subscriptions = eventSubscriptions;
+
+		for (int i = subscriptions.length - 1; consumer != null && i >= 0; i--) {
+			if (subscriptions[i].getConsumer() == consumer) {
+				NativeEventSubscription[] copy = new NativeEventSubscription[subscriptions.length - 1];
+				System.arraycopy(subscriptions, 0, copy, 0, i);
+				System.arraycopy(subscriptions, i + 1, copy, i, copy.length - i);
+				eventSubscriptions = copy;
+
+				subscriptions[i].close();
+				GlobalScreen.updateNativeEventMask();
+				break;
+			}
+		}
+	}
+
+	/**
+	 * Adds the specified synchronous filter for the events delivered to the
+	 * specified listener type.  The filter is invoked on the native hook
+	 * thread before the event is released to the native system and may
+	 * consume the event.  If filter is null, no exception is thrown and no
+	 * action is performed.
+	 * <p/>
+	 * Events that can be filtered are always dispatched synchronously from
+	 * the native hook, even while the native event queue is enabled.
+	 *
+	 * @param listenerType one of <code>NativeKeyListener.class</code>,
+	 * <code>NativeMouseListener.class</code>,
+	 * <code>NativeMouseMotionListener.class</code> or
+	 * <code>NativeMouseWheelListener.class</code>.
+	 * @param filter a native event filter object
+	 * @throws IllegalArgumentException if the listener type is not supported.
+	 * @see #setEventFilterBudget(long, TimeUnit)
+	 * @since 1.2
+	 */
+	public synchronized void addNativeEventFilter(Class<? extends EventListener> listenerType, NativeEventFilter filter) {
+		int index = getFilterIndex(listenerType);
+
+		if (filter != null) {
+			NativeEventFilter[][] filters = eventFilters.clone();
+			filters[index] = addListener(filters[index], filter);
+
+			eventFilters = filters;
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Removes the specified synchronous filter for the events delivered to
+	 * the specified listener type. This method performs no function if the
+	 * filter specified by the argument was not previously added.  If filter is
+	 * null, no exception is thrown and no action is performed.
+	 *
+	 * @param listenerType the listener type the filter was added for.
+	 * @param filter a native event filter object
+	 * @throws IllegalArgumentException if the listener type is not supported.
+	 * @since 1.2
+	 */
+	public synchronized void removeNativeEventFilter(Class<? extends EventListener> listenerType, NativeEventFilter filter) {
+		int index = getFilterIndex(listenerType);
+
+		if (filter != null) {
+			NativeEventFilter[][] filters = eventFilters.clone();
+			filters[index] = removeListener(filters[index], filter);
+
+			eventFilters = filters;
+			GlobalScreen.updateNativeEventMask();
+		}
+	}
+
+	/**
+	 * Set the maximum time all filters may take for a single event.  If the
+	 * filters take longer, the event is passed through to the native system
+	 * regardless of the filter result and the count returned by
+	 * {@link #getEventFilterOverBudgetCount()} is incremented.  The default
+	 * budget is 500 microseconds.
+	 * <p/>
+	 *
+	 * <b>Note:</b> The budget is checked after each filter returns, so it
+	 * cannot interrupt a filter.  A single slow filter still holds up the
+	 * native hook for as long as it runs.
+	 *
+	 * @param timeout the maximum time the filters may take.
+	 * @param unit the time unit of the timeout argument.
+	 * @since 1.2
+	 */
+	public final void setEventFilterBudget(long timeout, TimeUnit unit) {
+		GlobalScreen.eventFilterBudget = unit.toNanos(timeout);
+	}
+
+	/**
+	 * Returns the number of events that were passed through to the native
+	 * system because the filters exceeded their time budget.
+	 *
+	 * @return the number of events over the filter budget.
+	 * @since 1.2
+	 */
+	public final long getEventFilterOverBudgetCount() {
+		return eventFilterOverBudgetCount.get();
+	}
+
+	/**
+	 * Returns the <code>eventFilters</code> index for a listener type.
+	 *
+	 * @param listenerType the listener type.
+	 * @return the index of the filters for the listener type.
+	 * @throws IllegalArgumentException if the listener type is not supported.
+	 * @since 1.2
+	 */
+	private static int getFilterIndex(Class<? extends EventListener> listenerType) {
+		int index;
+
+		if (listenerType == NativeKeyListener.class) {
+			index = Integer.numberOfTrailingZeros(EVENT_MASK_KEY);
+		}
+		else if (listenerType == NativeMouseListener.class) {
+			index = Integer.numberOfTrailingZeros(EVENT_MASK_MOUSE);
+		}
+		else if (listenerType == NativeMouseMotionListener.class) {
+			index = Integer.numberOfTrailingZeros(EVENT_MASK_MOUSE_MOTION);
+		}
+		else if (listenerType == NativeMouseWheelListener.class) {
+			index = Integer.numberOfTrailingZeros(EVENT_MASK_MOUSE_WHEEL);
+		}
+		else {
+			throw new IllegalArgumentException("Unsupported listener type: " + listenerType);
+		}
+
+		return index;
+	}
+
+	/**
+	 * Run the synchronous filters for an event on the current thread.
+	 *
+	 * @param e the event to filter.
+	 * @return true if the event was consumed within the filter budget.
+	 * @since 1.2
+	 */
+	private static boolean filterEvent(NativeInputEvent e) {
+		boolean consumed = false;
+
+		int mask = getEventMask(e.getID());
+		if (mask != 0x00) {
+			NativeEventFilter[] filters = eventFilters[Integer.numberOfTrailingZeros(mask)];
+
+			if (filters.length > 0) {
+				long budget = eventFilterBudget;
+				long start = System.nanoTime();
+
+				boolean expired = false;
+				for (int i = 0; i < filters.length && !consumed && !expired; i++) {
+					// A failing filter must not leave an exception pending on
+					// the native hook thread.
+					try {
+						consumed = filters[i].filterNativeEvent(e);
+					}
+					catch (Throwable t) {
+						GlobalScreen.logCallbackException("filter", t);
+						consumed = false;
+					}
+
+					expired = System.nanoTime() - start > budget;
+				}
+
+				// Late decisions are ignored so the event is not held back
+				// any longer than the slowest filter already took.
+				if (expired) {
+					eventFilterOverBudgetCount.incrementAndGet();
+					consumed = false;
+				}
+			}
+		}
+
+		return consumed;
+	}
+
+	/**
+	 * Log an exception thrown by a user callback that runs on a thread the
+	 * exception must not escape from, such as the native hook thread.
+	 *
+	 * @param callback a short description of the callback.
+	 * @param t the exception thrown by the callback.
+	 * @since 1.2
+	 */
+	private static void logCallbackException(String callback, Throwable t) {
+		Logger.getLogger(GlobalScreen.class.getPackage().getName())
+				.log(Level.SEVERE, "Uncaught exception in native event " + callback + ".", t);
+	}
+
+	/**
+	 * Returns a copy of the listener array with the listener appended.
+	 *
+	 * @param listeners the current listener array.
+	 * @param listener the listener to add.
+	 * @return a new listener array.
+	 * @since 1.2
+	 */
+	@SuppressWarnings("unchecked")
+	private static <T extends EventListener> T[] addListener(T[] listeners, T listener) {
+		T[] copy = (T[]) Array.newInstance(listeners.getClass().getComponentType(), listeners.length + 1);
+		System.arraycopy(listeners, 0, copy, 0, listeners.length);
+		copy[listeners.length] = listener;
+
+		return copy;
+	}
+
+	/**
+	 * Returns a copy of the listener array without the last occurrence of the
+	 * listener.  The original array is returned if the listener is not found.
+	 *
+	 * @param listeners the current listener array.
+	 * @param listener the listener to remove.
+	 * @return a new listener array or the current array if unchanged.
+	 * @since 1.2
+	 */
+	@SuppressWarnings("unchecked")
+	private static <T extends EventListener> T[] removeListener(T[] listeners, T listener) {
+		T[] copy = listeners;
+
+		for (int i = listeners.length - 1; i >= 0; i--) {
+			if (listeners[i] == listener) {
+				copy = (T[]) Array.newInstance(listeners.getClass().getComponentType(), listeners.length - 1);
+				System.arraycopy(listeners, 0, copy, 0, i);
+				System.arraycopy(listeners, i + 1, copy, i, copy.length - i);
+				break;
+			}
+		}
+
+		return copy;
+	}
+
+	/**
+	 * Recalculate which groups of native events have at least one listener and
+	 * pass the result to the native library.  Native events that nobody is
+	 * listening for are discarded before any Java objects are created.
+	 *
+	 * @since 1.2
+	 */
+	private static synchronized void updateNativeEventMask() {
+		int mask = 0x00;
+
+		if (keyListeners.length > 0) {
+			mask |= EVENT_MASK_KEY;
+		}
+
+		if (mouseListeners.length > 0) {
+			mask |= EVENT_MASK_MOUSE;
+		}
+
+		if (mouseMotionListeners.length > 0) {
+			mask |= EVENT_MASK_MOUSE_MOTION;
+		}
+
+		if (mouseWheelListeners.length > 0) {
+			mask |= EVENT_MASK_MOUSE_WHEEL;
+		}
+
+		// Consumers receive every native event.
+		if (eventSubscriptions.length > 0) {
+			mask |= EVENT_MASK_KEY | EVENT_MASK_MOUSE | EVENT_MASK_MOUSE_MOTION | EVENT_MASK_MOUSE_WHEEL;
+		}
+
+		eventListenerMask = mask;
+
+		int filterMask = 0x00;
+		for (int i = 0; i < eventFilters.length; i++) {
+			if (eventFilters[i].length > 0) {
+				filterMask |= 1 << i;
+			}
+		}
+
+		if (eventViewListeners.length > 0) {
+			mask = EVENT_MASK_KEY | EVENT_MASK_MOUSE | EVENT_MASK_MOUSE_MOTION | EVENT_MASK_MOUSE_WHEEL;
+		}
+
+		int primitiveMask = 0x00;
+		if (keyPrimitiveListeners.length > 0) {
+			primitiveMask |= EVENT_MASK_KEY;
+		}
+
+		if (mousePrimitiveListeners.length > 0) {
+			primitiveMask |= EVENT_MASK_MOUSE | EVENT_MASK_MOUSE_MOTION;
+		}
+
+		GlobalScreen.setNativePrimitiveMask(primitiveMask);
+		GlobalScreen.setNativeFilterMask(filterMask);
+		GlobalScreen.setNativeEventMask(mask | filterMask);
+	}
+
+	/**
+	 * Returns the <code>EVENT_MASK_*</code> group for a native event id.
+	 *
+	 * @param id the native event id.
+	 * @return the event mask group or 0 if the id is unknown.
+	 * @since 1.2
+	 */
+	private static int getEventMask(int id) {
+		int mask = 0x00;
+
+		switch (id) {
+			case NativeKeyEvent.NATIVE_KEY_PRESSED:
+			case NativeKeyEvent.NATIVE_KEY_RELEASED:
+			case NativeKeyEvent.NATIVE_KEY_TYPED:
+				mask = EVENT_MASK_KEY;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_CLICKED:
+			case NativeMouseEvent.NATIVE_MOUSE_PRESSED:
+			case NativeMouseEvent.NATIVE_MOUSE_RELEASED:
+				mask = EVENT_MASK_MOUSE;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_MOVED:
+			case NativeMouseEvent.NATIVE_MOUSE_DRAGGED:
+				mask = EVENT_MASK_MOUSE_MOTION;
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_WHEEL:
+				mask = EVENT_MASK_MOUSE_WHEEL;
+				break;
+		}
+
+		return mask;
+	}
+
+	/**
+	 * Set the groups of native events that should be delivered to Java.
+	 *
+	 * @param mask a combination of the <code>EVENT_MASK_*</code> constants.
+	 * @since 1.2
+	 */
+	private static native void setNativeEventMask(int mask);
+
+	/**
+	 * Set the groups of native events that must be delivered synchronously
+	 * because they have at least one filter.
+	 *
+	 * @param mask a combination of the <code>EVENT_MASK_*</code> constants.
+	 * @since 1.2
+	 */
+	private static native void setNativeFilterMask(int mask);
+
+	/**
+	 * Set the groups of native events that are passed to the primitive
+	 * listeners before any event objects are created.
+	 *
+	 * @param mask a combination of the <code>EVENT_MASK_*</code> constants.
+	 * @since 1.2
+	 */
+	private static native void setNativePrimitiveMask(int mask);
+
+	/**
+	 * Enable the native hook if it is not currently running. If it is running
+	 * the function has no effect.
+	 * <p/>
+	 * <b>Note:</b> This method will throw a <code>NativeHookException</code>
+	 * if specific operating system features are unavailable or disabled.
+	 * For example: Access for assistive devices is unchecked in the Universal
+	 * Access section of the System Preferences on Apple's OS X platform or
+	 * <code>Load "record"</code> is missing for the xorg.conf file on
+	 * Unix/Linux/Solaris platforms.
+	 *
+	 * @throws NativeHookException problem registering the native hook with
+	 *                             the underlying operating system.
+	 * @since 1.1
+	 */
+	public static native void registerNativeHook() throws NativeHookException;
+
+	/**
+	 * Disable the native hook if it is currently registered. If the native
+	 * hook it is not registered the function has no effect.
+	 *
+	 * @since 1.1
+	 */
+	public static native void unregisterNativeHook();
+
+	/**
+	 * What happens to events that have been received but not yet delivered
+	 * when the event pipeline is shut down.
+	 *
+	 * @see GlobalScreen#shutdown(long, TimeUnit, ShutdownPolicy)
+	 * @since 1.2
+	 */
+	public enum ShutdownPolicy {
+		/** Deliver the queued events to their listeners and consumers. */
+		DRAIN,
+
+		/** Discard the queued events. */
+		DISCARD
+	}
+
+	/**
+	 * Shut down the native hook and the event pipeline within the specified
+	 * time, delivering the events that are already queued.
+	 *
+	 * @param timeout the maximum time to wait.
+	 * @param unit the time unit of the timeout argument.
+	 * @return true if the pipeline stopped before the timeout.
+	 * @see #shutdown(long, TimeUnit, ShutdownPolicy)
+	 * @since 1.2
+	 */
+	public static boolean shutdown(long timeout, TimeUnit unit) {
+		return GlobalScreen.shutdown(timeout, unit, ShutdownPolicy.DRAIN);
+	}
+
+	/**
+	 * Shut down the native hook and the event pipeline within the specified
+	 * time.  The stages are stopped in the order events flow through them:
+	 * <ol>
+	 * 	<li>The native replay, capture and settings threads are stopped.</li>
+	 * 	<li>The native hook is unregistered and the native library waits for
+	 * 	the hook thread to exit and detach from the virtual machine, and for
+	 * 	the event being delivered to Java, if any, to return.  No further
+	 * 	events cross into Java until the hook is registered again.</li>
+	 * 	<li>The native event queue is drained or discarded and its thread
+	 * 	exits.</li>
+	 * 	<li>The dispatch executors are shut down and, for
+	 * 	<code>DRAIN</code>, finish their queued events.  Executors that do
+	 * 	not terminate in time are interrupted.</li>
+	 * 	<li>The event consumers empty their queues, for <code>DRAIN</code>,
+	 * 	and are removed.  The native settings listeners are removed as
+	 * 	well.</li>
+	 * </ol>
+	 * The native globals are kept until the library is unloaded, so the hook
+	 * may be registered again.  Events are only dispatched again once new
+	 * dispatchers are set with {@link #setEventDispatcher(ExecutorService)}.
+	 * <p/>
+	 *
+	 * <b>Note:</b> This method must not be called from a synchronous event
+	 * filter, as the native hook would wait for itself until the timeout.
+	 *
+	 * @param timeout the maximum time to wait.
+	 * @param unit the time unit of the timeout argument.
+	 * @param policy what happens to queued events.
+	 * @return true if every stage stopped before the timeout.
+	 * @since 1.2
+	 */
+	public static boolean shutdown(long timeout, TimeUnit unit, ShutdownPolicy policy) {
+		long deadline = System.nanoTime() + unit.toNanos(timeout);
+		boolean discard = policy == ShutdownPolicy.DISCARD;
+
+		GlobalScreen instance = GlobalScreen.getInstance();
+		synchronized (instance) {
+			boolean clean = GlobalScreen.shutdownNativeHook(deadline - System.nanoTime());
+
+			// The settings thread was stopped with the hook, so a later listener
+			// must start it again.
+			settingsListeners = new NativeSettingsListener[0];
+
+			// Nothing is added to the native event queue anymore.
+			if (eventQueueThread != null) {
+				eventQueueDiscard = discard;
+				GlobalScreen.disableEventQueue();
+
+				try {
+					TimeUnit.NANOSECONDS.timedJoin(eventQueueThread, deadline - System.nanoTime());
+				}
+				catch (InterruptedException e) {
+					Thread.currentThread().interrupt();
+				}
+
+				if (eventQueueThread.isAlive()) {
+					clean = false;
+				}
+				else {
+					eventQueueThread = null;
+				}
+			}
+
+			// The same executor may serve several listener types.
+			ExecutorService[] executors = new ExecutorService[] {
+				keyEventExecutor,
+				mouseEventExecutor,
+				mouseMotionEventExecutor,
+				mouseWheelEventExecutor
+			};
+
+			keyEventExecutor = null;
+			mouseEventExecutor = null;
+			mouseMotionEventExecutor = null;
+			mouseWheelEventExecutor = null;
+
+			for (int i = 0; i < executors.length; i++) {
+				if (executors[i] != null) {
+					if (discard) {
+						executors[i].shutdownNow();
+					}
+					else {
+						executors[i].shutdown();
+					}
+				}
+			}
+
+			for (int i = 0; i < executors.length; i++) {
+				if (executors[i] != null) {
+					boolean terminated = false;
+					try {
+						terminated = executors[i].awaitTermination(deadline - System.nanoTime(), TimeUnit.NANOSECONDS);
+					}
+					catch (InterruptedException e) {
+						Thread.currentThread().interrupt();
+					}
+
+					if (!terminated) {
+						executors[i].shutdownNow();
+						clean = false;
+					}
+				}
+			}
+
+			NativeEventSubscription[] subscriptions = eventSubscriptions;
+			eventSubscriptions = new NativeEventSubscription[0];
+
+			for (int i = 0; i < subscriptions.length; i++) {
+				if (!discard && !subscriptions[i].awaitDrained(deadline)) {
+					clean = false;
+				}
+
+				subscriptions[i].close();
+			}
+
+			GlobalScreen.updateNativeEventMask();
+
+			return clean;
+		}
+	}
+
+	/**
+	 * Stop the native hook and wait for the hook thread to exit and for the
+	 * event in flight, if any, to return from Java.
+	 *
+	 * @param timeout the maximum time to wait in nanoseconds.
+	 * @return true if the hook stopped and no event was in flight at the
+	 * deadline.
+	 * @since 1.2
+	 */
+	private static native boolean shutdownNativeHook(long timeout);
+
+	/**
+	 * Returns <code>true</code> if the native hook is currently registered.
+	 *
+	 * @return true if the native hook is currently registered.
+	 * @throws NativeHookException the native hook exception
+	 * @since 1.1
+	 */
+	public static native boolean isNativeHookRegistered();
+
+	/**
+	 * Send a native input event to the system.  Key, mouse button, mouse
+	 * motion and mouse wheel events are supported.
+	 *
+	 * @param e the event to send.
+	 * @throws IllegalArgumentException if the event type is unknown.
+	 * @since 1.2
+	 */
+	public static native void postNativeEvent(NativeInputEvent e);
+
+	/**
+	 * Send a batch of native input events to the system.  The events are
+	 * packed into a single record array and converted with one native call.
+	 *
+	 * @param events the events to send in order.
+	 * @since 1.2
+	 */
+	public static void postNativeEvents(NativeInputEvent[] events) {
+		long[] records = new long[events.length * NativeEventView.RECORD_SIZE];
+		for (int i = 0; i < events.length; i++) {
+			NativeEventView.writeRecord(events[i], records, i);
+		}
+
+		GlobalScreen.postNativeEvents(records, 0, events.length);
+	}
+
+	/**
+	 * Send a batch of native input events stored as records to the system.
+	 * Each event occupies {@link NativeEventView#RECORD_SIZE} consecutive
+	 * values laid out as described by {@link NativeEventView#RECORD_BYTES}.
+	 * Records with an unknown event type are ignored.
+	 *
+	 * @param records the array containing the event records.
+	 * @param offset the index of the first record to send.
+	 * @param count the number of records to send.
+	 * @throws IllegalArgumentException if the records are out of bounds.
+	 * @since 1.2
+	 */
+	public static native void postNativeEvents(long[] records, int offset, int count);
+
+	/**
+	 * Start writing every native event to a compact binary capture file.
+	 * Events are recorded by the native library as they arrive, before they
+	 * are filtered, coalesced or converted to Java objects, so capturing does
+	 * not add any work to the event dispatch thread.  Only one capture may be
+	 * active at a time and an existing file will be replaced.
+	 * <p/>
+	 *
+	 * The file starts with the four byte magic <code>JNHC</code>, a version
+	 * byte, a flags byte and two reserved bytes.  Each following record is a
+	 * length byte, the native event type and a series of LEB128 encoded
+	 * values.  When delta encoding is enabled, timestamps and pointer
+	 * coordinates are stored as differences from the previous record.
+	 *
+	 * @param file the capture file to create.
+	 * @param deltaEncoding true to store timestamps and coordinates as
+	 * differences from the previous event.
+	 * @throws IOException if the file could not be created or a capture is
+	 * already active.
+	 * @since 1.2
+	 */
+	public static void startEventCapture(File file, boolean deltaEncoding) throws IOException {
+		GlobalScreen.startNativeCapture(file.getAbsolutePath(), deltaEncoding);
+	}
+
+	/**
+	 * Stop the active event capture and close the capture file.
+	 *
+	 * @return the size of the capture file in bytes, or -1 if no capture was
+	 * active.
+	 * @since 1.2
+	 */
+	public static long stopEventCapture() {
+		return GlobalScreen.stopNativeCapture();
+	}
+
+	/**
+	 * Create the native capture file and start recording events into it.
+	 *
+	 * @param path the absolute path of the capture file.
+	 * @param delta true to enable delta encoding.
+	 * @throws IOException if the capture could not be started.
+	 * @since 1.2
+	 */
+	private static native void startNativeCapture(String path, boolean delta) throws IOException;
+
+	/**
+	 * Stop the native event capture.
+	 *
+	 * @return the size of the capture file in bytes, or -1 if no capture was
+	 * active.
+	 * @since 1.2
+	 */
+	private static native long stopNativeCapture();
+
+	/**
+	 * Replay a capture file created by {@link #startEventCapture(File, boolean)}.
+	 * The events are posted by a native thread that reproduces the original
+	 * spacing between events using a high resolution clock, so the timing is
+	 * not affected by garbage collection or the Java thread scheduler.  This
+	 * method returns immediately; use {@link #isEventReplayActive()} to check
+	 * for completion.
+	 *
+	 * @param file the capture file to replay.
+	 * @param speed the playback speed multiplier, 1.0 for the original speed
+	 * or 2.0 for twice as fast.
+	 * @throws IOException if the file could not be opened or a replay is
+	 * already active.
+	 * @throws IllegalArgumentException if the speed is not a positive number.
+	 * @since 1.2
+	 */
+	public static synchronized void startEventReplay(File file, double speed) throws IOException {
+		if (!(speed > 0.0) || Double.isInfinite(speed)) {
+			throw new IllegalArgumentException("The replay speed must be a positive number.");
+		}
+
+		GlobalScreen.startNativeReplay(file.getAbsolutePath(), speed);
+	}
+
+	/**
+	 * Cancel the active event replay and wait for the replay thread to exit.
+	 * If no replay is active the function has no effect.
+	 *
+	 * @since 1.2
+	 */
+	public static synchronized void stopEventReplay() {
+		GlobalScreen.stopNativeReplay();
+	}
+
+	/**
+	 * Returns <code>true</code> while a capture file is being replayed.
+	 *
+	 * @return true if an event replay is active.
+	 * @since 1.2
+	 */
+	public static boolean isEventReplayActive() {
+		return GlobalScreen.isNativeReplayActive();
+	}
+
+	/**
+	 * Start the native replay thread.
+	 *
+	 * @param path the absolute path of the capture file.
+	 * @param speed the playback speed multiplier.
+	 * @throws IOException if the replay could not be started.
+	 * @since 1.2
+	 */
+	private static native void startNativeReplay(String path, double speed) throws IOException;
+
+	/**
+	 * Cancel the native replay thread and wait for it to exit.
+	 *
+	 * @since 1.2
+	 */
+	private static native void stopNativeReplay();
+
+	/**
+	 * Returns <code>true</code> while the native replay thread is running.
+	 *
+	 * @return true if an event replay is active.
+	 * @since 1.2
+	 */
+	private static native boolean isNativeReplayActive();
+
+	/**
+	 * Dispatches a matched hotkey to the registered
+	 * <code>NativeHotkeyListener</code> objects using the key event
+	 * dispatcher.  This method is called by the native library on the native
+	 * systems event queue.
+	 *
+	 * @param id the id of the matched hotkey.
+	 * @since 1.2
+	 */
+	private void dispatchHotkey(final int id) {
+		// Hotkeys are discarded while no dispatcher is set.
+		ExecutorService executor = keyEventExecutor;
+		if (executor == null) {
+			return;
+		}
+
+		try {
+			GlobalScreen.execute(executor, NativeKeyEvent.NATIVE_KEY_PRESSED, new Runnable() {
+				public void run() {
+					NativeHotkeyListener[] listeners = hotkeyListeners;
+
+					for (int i = 0; i < listeners.length; i++) {
+						listeners[i].nativeHotkeyPressed(id);
+					}
+				}
+			});
+		}
+		catch (RejectedExecutionException e) {
+			// The dispatcher was shut down while the hook was still running.
+			GlobalScreen.logCallbackException("dispatcher", e);
+		}
+	}
+
+	/**
+	 * Dispatches a gesture recognized by the native library to the registered
+	 * <code>NativeMouseGestureListener</code> objects using the mouse event
+	 * dispatcher.  This method is called by the native library on the native
+	 * systems event queue.
+	 *
+	 * @param type the native gesture type.
+	 * @param when the time the gesture completed.
+	 * @param modifiers the modifier mask of the last native event.
+	 * @param x the x coordinate of the gesture.
+	 * @param y the y coordinate of the gesture.
+	 * @param button the mouse button of a drag or multi click.
+	 * @param count the click count or the number of wheel events.
+	 * @param deltaX the horizontal distance covered by a drag.
+	 * @param deltaY the vertical distance covered by a drag.
+	 * @param rotation the total rotation of a wheel burst.
+	 * @since 1.2
+	 */
+	private void dispatchGesture(int type, long when, int modifiers, int x, int y, int button, int count, int deltaX, int deltaY, int rotation) {
+		// Gestures are discarded while no dispatcher is set.
+		ExecutorService executor = mouseEventExecutor;
+		if (executor == null) {
+			return;
+		}
+
+		final NativeMouseGestureEvent e = new NativeMouseGestureEvent(
+				NativeMouseGestureEvent.NATIVE_MOUSE_GESTURE_FIRST + type,
+				when, modifiers, x, y, count, button, deltaX, deltaY, rotation);
+
+		try {
+			GlobalScreen.execute(executor, NativeMouseEvent.NATIVE_MOUSE_CLICKED, new Runnable() {
+				public void run() {
+					NativeMouseGestureListener[] listeners = gestureListeners;
+
+					for (int i = 0; i < listeners.length; i++) {
+						switch (e.getID()) {
+							case NativeMouseGestureEvent.NATIVE_MOUSE_DRAG_STARTED:
+								listeners[i].nativeMouseDragStarted(e);
+								break;
+
+							case NativeMouseGestureEvent.NATIVE_MOUSE_DRAG_ENDED:
+								listeners[i].nativeMouseDragEnded(e);
+								break;
+
+							case NativeMouseGestureEvent.NATIVE_MOUSE_MULTI_CLICKED:
+								listeners[i].nativeMouseMultiClicked(e);
+								break;
+
+							case NativeMouseGestureEvent.NATIVE_MOUSE_WHEEL_BURST:
+								listeners[i].nativeMouseWheelBurst(e);
+								break;
+						}
+					}
+				}
+			});
+		}
+		catch (RejectedExecutionException ex) {
+			// The dispatcher was shut down while the hook was still running.
+			GlobalScreen.logCallbackException("dispatcher", ex);
+		}
+	}
+
+	/**
+	 * Passes the values of a native key event to the registered
+	 * <code>NativeKeyPrimitiveListener</code> objects.  This method is called
+	 * by the native library on the native systems event queue.
+	 *
+	 * @param id the native key event type.
+	 * @param keyCode the virtual key code.
+	 * @param rawCode the native key code.
+	 * @param modifiers the modifier mask of the event.
+	 * @param when the time the event occurred.
+	 * @since 1.2
+	 */
+	private void dispatchKeyPrimitive(int id, int keyCode, int rawCode, int modifiers, long when) {
+		NativeKeyPrimitiveListener[] listeners = keyPrimitiveListeners;
+
+		for (int i = 0; i < listeners.length; i++) {
+			// Exceptions must not escape onto the native hook thread.
+			try {
+				listeners[i].onKey(id, keyCode, rawCode, modifiers, when);
+			}
+			catch (Throwable t) {
+				GlobalScreen.logCallbackException("primitive listener", t);
+			}
+		}
+	}
+
+	/**
+	 * Passes the values of a native mouse button or motion event to the
+	 * registered <code>NativeMousePrimitiveListener</code> objects.  This
+	 * method is called by the native library on the native systems event
+	 * queue.
+	 *
+	 * @param id the native mouse event type.
+	 * @param x the x coordinate of the native pointer.
+	 * @param y the y coordinate of the native pointer.
+	 * @param button the mouse button that changed state.
+	 * @param modifiers the modifier mask of the event.
+	 * @param when the time the event occurred.
+	 * @since 1.2
+	 */
+	private void dispatchMousePrimitive(int id, int x, int y, int button, int modifiers, long when) {
+		NativeMousePrimitiveListener[] listeners = mousePrimitiveListeners;
+
+		for (int i = 0; i < listeners.length; i++) {
+			// Exceptions must not escape onto the native hook thread.
+			try {
+				listeners[i].onMouse(id, x, y, button, modifiers, when);
+			}
+			catch (Throwable t) {
+				GlobalScreen.logCallbackException("primitive listener", t);
+			}
+		}
+	}
+
+	/**
+	 * Dispatches an event to the appropriate processor.  This method is
+	 * generally called by the native library but maybe used to synthesize
+	 * native events from Java.
+	 * <p/>
+	 * <b>Note:</b> This method executes on the native systems event queue.
+	 * It is imperative that all processing be off-loaded to other threads.
+	 * Failure to do so may result in the delay of user input and the automatic
+	 * removal of the native hook.
+	 */
+	public final void dispatchEvent(NativeInputEvent e) {
+		// Filters decide before the event is released to the native system.
+		if (filterEvent(e)) {
+			e.setReserved(NativeInputEvent.RESERVED_CONSUMED);
+		}
+
+		GlobalScreen.offerSubscriptions(e);
+
+		if (e instanceof NativeKeyEvent) {
+			processKeyEvent((NativeKeyEvent) e);
+		}
+		else if (e instanceof NativeMouseWheelEvent) {
+			processMouseWheelEvent((NativeMouseWheelEvent) e);
+		}
+		else if (e instanceof NativeMouseEvent) {
+			processMouseEvent((NativeMouseEvent) e);
+		}
+	}
+
+	/**
+	 * Offers an event to every registered <code>NativeEventSubscription</code>.
+	 *
+	 * @param e the <code>NativeInputEvent</code> to offer.
+	 * @since 1.2
+	 */
+	private static void offerSubscriptions(NativeInputEvent e) {
+		NativeEventSubscription[] subscriptions = eventSubscriptions;
+		if (subscriptions.length > 0) {
+			// Pooled objects are reused once the listeners are done with them.
+			NativeInputEvent shared = e.getPoolIndex() >= 0 ? NativeEventSubscription.copy(e) : e;
+
+			for (int i = 0; i < subscriptions.length; i++) {
+				subscriptions[i].offer(shared);
+			}
+		}
+	}
+
+	/**
+	 * Processes native key events by dispatching them to all registered
+	 * <code>NativeKeyListener</code> objects.
+	 *
+	 * @param e the <code>NativeKeyEvent</code> to dispatch.
+	 * @see NativeKeyEvent
+	 * @see NativeKeyListener
+	 * @see #addNativeKeyListener(NativeKeyListener)
+	 */
+	private void processKeyEvent(NativeKeyEvent e) {
+		/*
+		try {
+			Field f = NativeInputEvent.class.getDeclaredField("propagate");
+			f.setAccessible(true);
+			f.setBoolean(e, false);
+		}
+		catch (Exception ex) {
+			ex.printStackTrace();
+		}
+		*/
+
+		// The event cannot be modified beyond this point!  This is both a 
+		// Java restriction and a native code restriction.
+		final NativeKeyEvent event = e;
+
+		// Events are discarded while no dispatcher is set.
+		ExecutorService executor = keyEventExecutor;
+		if (executor == null) {
+			GlobalScreen.release(event);
+			return;
+		}
+
+		try {
+			GlobalScreen.execute(executor, event.getID(), new Runnable() {
+				public void run() {
+					GlobalScreen.stampDispatch(event);
+
+					int id = event.getID();
+					NativeKeyListener[] listeners = keyListeners;
+
+					try {
+						for (int i = 0; i < listeners.length; i++) {
+							switch (id) {
+								case NativeKeyEvent.NATIVE_KEY_PRESSED:
+									listeners[i].nativeKeyPressed(event);
+									break;
+
+								case NativeKeyEvent.NATIVE_KEY_TYPED:
+									listeners[i].nativeKeyTyped(event);
+									break;
+
+								case NativeKeyEvent.NATIVE_KEY_RELEASED:
+									listeners[i].nativeKeyReleased(event);
+									break;
+							}
+						}
+					}
+					finally {
+						GlobalScreen.release(event);
+					}
+				}
+			});
+		}
+		catch (RuntimeException ex) {
+			// The executor rejected the event, so it will never be released.
+			GlobalScreen.release(event);
+
+			throw ex;
+		}
+	}
+
+	/**
+	 * Processes native mouse events by dispatching them to all registered
+	 * <code>NativeMouseListener</code> objects.
+	 *
+	 * @param e the <code>NativeMouseEvent</code> to dispatch.
+	 * @see NativeMouseEvent
+	 * @see NativeMouseListener
+	 * @see #addNativeMouseListener(NativeMouseListener)
+	 */
+	private void processMouseEvent(NativeMouseEvent e) {
+		// The event cannot be modified beyond this point!  This is both a 
+		// Java restriction and a native code restriction.
+		final NativeMouseEvent event = e;
+
+		int id = event.getID();
+		boolean motion = id == NativeMouseEvent.NATIVE_MOUSE_MOVED || id == NativeMouseEvent.NATIVE_MOUSE_DRAGGED;
+
+		// Events are discarded while no dispatcher is set.
+		ExecutorService executor = motion ? mouseMotionEventExecutor : mouseEventExecutor;
+		if (executor == null) {
+			GlobalScreen.release(event);
+			return;
+		}
+
+		// Native motion events will be merged until this event is complete.
+		final boolean coalesce = motion && mouseMotionCoalescing;
+		if (coalesce) {
+			GlobalScreen.beginMouseMotion();
+		}
+
+		try {
+			GlobalScreen.execute(executor, event.getID(), new Runnable() {
+				public void run() {
+					try {
+						fireMouseEvent(event);
+					}
+					finally {
+						GlobalScreen.release(event);
+
+						if (coalesce) {
+							// Deliver any motion events merged while this one was
+							// dispatched.  The native dispatcher stays busy until
+							// this loop ends, so it must not be cut short.
+							NativeMouseEvent next;
+							while ((next = GlobalScreen.completeMouseMotion()) != null) {
+								try {
+									// Merged events never pass through dispatchEvent(), and
+									// they were released to the native system long ago, so
+									// only the consumers are offered them here.
+									GlobalScreen.offerSubscriptions(next);
+
+									fireMouseEvent(next);
+								}
+								catch (Throwable t) {
+									GlobalScreen.logCallbackException("listener", t);
+								}
+							}
+						}
+					}
+				}
+			});
+		}
+		catch (RuntimeException ex) {
+			// The executor rejected the event, so it will never complete.
+			if (coalesce) {
+				GlobalScreen.cancelMouseMotion();
+			}
+			GlobalScreen.release(event);
+
+			throw ex;
+		}
+	}
+
+	/**
+	 * Delivers a native mouse event to all registered
+	 * <code>NativeMouseListener</code> or <code>NativeMouseMotionListener</code>
+	 * objects on the current thread.
+	 *
+	 * @param event the <code>NativeMouseEvent</code> to deliver.
+	 * @since 1.2
+	 */
+	private void fireMouseEvent(NativeMouseEvent event) {
+		GlobalScreen.stampDispatch(event);
+
+		int id = event.getID();
+
+		if (id == NativeMouseEvent.NATIVE_MOUSE_MOVED || id == NativeMouseEvent.NATIVE_MOUSE_DRAGGED) {
+			NativeMouseMotionListener[] listeners = mouseMotionListeners;
+
+			for (int i = 0; i < listeners.length; i++) {
+				if (id == NativeMouseEvent.NATIVE_MOUSE_MOVED) {
+					listeners[i].nativeMouseMoved(event);
+				}
+				else {
+					listeners[i].nativeMouseDragged(event);
+				}
+			}
+		}
+		else {
+			NativeMouseListener[] listeners = mouseListeners;
+
+			for (int i = 0; i < listeners.length; i++) {
+				switch (id) {
+					case NativeMouseEvent.NATIVE_MOUSE_CLICKED:
+						listeners[i].nativeMouseClicked(event);
+						break;
+
+					case NativeMouseEvent.NATIVE_MOUSE_PRESSED:
+						listeners[i].nativeMousePressed(event);
+						break;
+
+					case NativeMouseEvent.NATIVE_MOUSE_RELEASED:
+						listeners[i].nativeMouseReleased(event);
+						break;
+				}
+			}
+		}
+	}
+
+	/**
+	 * Processes native mouse wheel events by dispatching them to all registered
+	 * <code>NativeMouseWheelListener</code> objects.
+	 *
+	 * @param e The <code>NativeMouseWheelEvent</code> to dispatch.
+	 * @see NativeMouseWheelEvent
+	 * @see NativeMouseWheelListener
+	 * @see #addNativeMouseWheelListener(NativeMouseWheelListener)
+	 * @since 1.1
+	 */
+	private void processMouseWheelEvent(NativeMouseWheelEvent e) {
+		// The event cannot be modified beyond this point!  This is both a 
+		// Java restriction and a native code restriction.
+		final NativeMouseWheelEvent event = e;
+
+		// Events are discarded while no dispatcher is set.
+		ExecutorService executor = mouseWheelEventExecutor;
+		if (executor == null) {
+			GlobalScreen.release(event);
+			return;
+		}
+
+		try {
+			GlobalScreen.execute(executor, event.getID(), new Runnable() {
+				public void run() {
+					GlobalScreen.stampDispatch(event);
+
+					NativeMouseWheelListener[] listeners = mouseWheelListeners;
+
+					try {
+						for (int i = 0; i < listeners.length; i++) {
+							listeners[i].nativeMouseWheelMoved(event);
+						}
+					}
+					finally {
+						GlobalScreen.release(event);
+					}
+				}
+			});
+		}
+		catch (RuntimeException ex) {
+			// The executor rejected the event, so it will never be released.
+			GlobalScreen.release(event);
+
+			throw ex;
+		}
+	}
+
+	/**
+	 * Submit a dispatch task to an executor, measuring its queue time and
+	 * run time while dispatch statistics are enabled.
+	 *
+	 * @param executor the executor for the event's listener group.
+	 * @param id the native event id.
+	 * @param task the task delivering the event to its listeners.
+	 * @since 1.2
+	 */
+	private static void execute(ExecutorService executor, final int id, final Runnable task) {
+		if (dispatchStatistics) {
+			final int group = DispatchStatistics.getGroup(id);
+
+			int depth = pendingEvents.incrementAndGet(group);
+			int max;
+			while (depth > (max = maxPendingEvents.get(group)) && !maxPendingEvents.compareAndSet(group, max, depth)) {
+				// Another thread raised the maximum first, try again.
+			}
+
+			try {
+				executor.execute(new Runnable() {
+					public void run() {
+						pendingEvents.decrementAndGet(group);
+
+						long start = System.nanoTime();
+						try {
+							task.run();
+						}
+						finally {
+							int bucket = DispatchStatistics.getBucket(System.nanoTime() - start);
+							listenerLatency.incrementAndGet(DispatchStatistics.getIndex(id) * STATISTICS_BUCKETS + bucket);
+						}
+					}
+				});
+			}
+			catch (RuntimeException e) {
+				// A rejected task is never counted as pending.
+				pendingEvents.decrementAndGet(group);
+				throw e;
+			}
+		}
+		else {
+			executor.execute(task);
+		}
+	}
+
+	/**
+	 * Enable or disable the collection of dispatch statistics.  While enabled,
+	 * the native library counts every event passed to Java and measures the
+	 * time spent converting and dispatching it, and the dispatch executors
+	 * measure queue depth and listener run time.  Statistics are disabled by
+	 * default.
+	 *
+	 * @param enabled true to collect dispatch statistics.
+	 * @see #getDispatchStatistics()
+	 * @since 1.2
+	 */
+	public final void setDispatchStatisticsEnabled(boolean enabled) {
+		GlobalScreen.dispatchStatistics = enabled;
+		GlobalScreen.setNativeStatisticsEnabled(enabled);
+	}
+
+	/**
+	 * Returns a snapshot of the dispatch statistics collected so far.
+	 *
+	 * @return the current dispatch statistics.
+	 * @see #setDispatchStatisticsEnabled(boolean)
+	 * @since 1.2
+	 */
+	public final DispatchStatistics getDispatchStatistics() {
+		long[] nativeStatistics = new long[DispatchStatistics.NATIVE_SIZE];
+		GlobalScreen.getNativeStatistics(nativeStatistics);
+
+		long[] listeners = new long[listenerLatency.length()];
+		for (int i = 0; i < listeners.length; i++) {
+			listeners[i] = listenerLatency.get(i);
+		}
+
+		int[] pending = new int[DispatchStatistics.GROUPS];
+		int[] maxPending = new int[DispatchStatistics.GROUPS];
+		for (int i = 0; i < DispatchStatistics.GROUPS; i++) {
+			pending[i] = pendingEvents.get(i);
+			maxPending[i] = maxPendingEvents.get(i);
+		}
 
-		super.finalize();
+		return new DispatchStatistics(nativeStatistics, listeners, pending, maxPending);
 	}
 
 	/**
-	 * Returns the singleton instance of <code>GlobalScreen</code>.
+	 * Query a native system setting from the platform.  This performs the
+	 * platform query on every call, use the cached <code>NativeSystem</code>
+	 * accessors instead.
 	 *
-	 * @return singleton instance of <code>GlobalScreen</code>
+	 * @param property one of the <code>PROPERTY_*</code> constants.
+	 * @return the setting or -1 if the platform does not report it.
+	 * @since 1.2
 	 */
-	public static synchronized GlobalScreen getInstance() {
-		return GlobalScreen.instance;
-	}
+	static native long getNativeProperty(int property);
 
 	/**
-	 * Adds the specified native key listener to receive key events from the
-	 * native system. If listener is null, no exception is thrown and no action
-	 * is performed.
+	 * Enable or disable the collection of native dispatch statistics.
 	 *
-	 * @param listener a native key listener object
+	 * @param enabled true to collect native statistics.
+	 * @since 1.2
 	 */
-	public void addNativeKeyListener(NativeKeyListener listener) {
-		if (listener != null) {
-			eventListeners.add(NativeKeyListener.class, listener);
-		}
-	}
+	private static native void setNativeStatisticsEnabled(boolean enabled);
 
 	/**
-	 * Removes the specified native key listener so that it no longer receives
-	 * key events from the native system. This method performs no function if
-	 * the listener specified by the argument was not previously added.  If
-	 * listener is null, no exception is thrown and no action is performed.
+	 * Copy the native dispatch statistics into the specified array.
 	 *
-	 * @param listener a native key listener object
+	 * @param statistics an array of at least
+	 * <code>DispatchStatistics.NATIVE_SIZE</code> longs.
+	 * @since 1.2
 	 */
-	public void removeNativeKeyListener(NativeKeyListener listener) {
-		if (listener != null) {
-			eventListeners.remove(NativeKeyListener.class, listener);
-		}
-	}
+	private static native void getNativeStatistics(long[] statistics);
 
 	/**
-	 * Adds the specified native mouse listener to receive mouse events from the
-	 * native system. If listener is null, no exception is thrown and no action
-	 * is performed.
+	 * Set a different executor service for native event delivery.  By default,
+	 * JNativeHook utilizes a single thread executor to dispatch events from
+	 * the native event queue.  You may choose to use an alternative approach
+	 * for event delivery by implementing an <code>ExecutorService</code>.
+	 * <p/>
+	 * This method replaces the executor service for all listener types.  Use
+	 * {@link #setEventDispatcher(Class, ExecutorService)} to give a listener
+	 * type its own executor service.
+	 * <p/>
+	 * <b>Note:</b> Using null as an <code>ExecutorService</code> will cause all
+	 * delivered events to be discard until a valid <code>ExecutorService</code>
+	 * is set.
 	 *
-	 * @param listener a native mouse listener object
+	 * @param dispatcher The <code>ExecutorService</code> used to dispatch native events.
+	 * @see java.util.concurrent.ExecutorService
+	 * @see java.util.concurrent.Executors#newSingleThreadExecutor()
+	 * @since 1.2
 	 */
-	public void addNativeMouseListener(NativeMouseListener listener) {
-		if (listener != null) {
-			eventListeners.add(NativeMouseListener.class, listener);
-		}
+	public final void setEventDispatcher(ExecutorService dispatcher) {
+		setEventDispatcher(NativeKeyListener.class, dispatcher);
+		setEventDispatcher(NativeMouseListener.class, dispatcher);
+		setEventDispatcher(NativeMouseMotionListener.class, dispatcher);
+		setEventDispatcher(NativeMouseWheelListener.class, dispatcher);
 	}
 
 	/**
-	 * Removes the specified native mouse listener so that it no longer receives
-	 * mouse events from the native system. This method performs no function if
-	 * the listener specified by the argument was not previously added.  If
-	 * listener is null, no exception is thrown and no action is performed.
+	 * Set a different executor service for the delivery of events to a
+	 * single type of listener.  Each executor service has its own queue, so a
+	 * slow <code>NativeMouseMotionListener</code> will not delay delivery to
+	 * a <code>NativeKeyListener</code> that uses a different executor service.
+	 * Events for different listener types are not delivered in order relative
+	 * to each other unless they share an executor service that preserves
+	 * order.
+	 * <p/>
+	 * The previous executor service is shut down once it is no longer used by
+	 * any listener type.
+	 * <p/>
+	 * <b>Note:</b> Using null as an <code>ExecutorService</code> will cause
+	 * events for the listener type to be discard until a valid
+	 * <code>ExecutorService</code> is set.
 	 *
-	 * @param listener a native mouse listener object
+	 * @param listenerType one of <code>NativeKeyListener.class</code>,
+	 * <code>NativeMouseListener.class</code>,
+	 * <code>NativeMouseMotionListener.class</code> or
+	 * <code>NativeMouseWheelListener.class</code>.
+	 * @param dispatcher The <code>ExecutorService</code> used to dispatch native
+	 * events to the listener type.
+	 * @throws IllegalArgumentException if the listener type is not supported.
+	 * @see java.util.concurrent.ExecutorService
+	 * @since 1.2
 	 */
-	public void removeNativeMouseListener(NativeMouseListener listener) {
-		if (listener != null) {
-			eventListeners.remove(NativeMouseListener.class, listener);
+	public final void setEventDispatcher(Class<? extends EventListener> listenerType, ExecutorService dispatcher) {
+		ExecutorService previous;
+
+		synchronized (GlobalScreen.class) {
+			if (listenerType == NativeKeyListener.class) {
+				previous = keyEventExecutor;
+				keyEventExecutor = dispatcher;
+			}
+			else if (listenerType == NativeMouseListener.class) {
+				previous = mouseEventExecutor;
+				mouseEventExecutor = dispatcher;
+			}
+			else if (listenerType == NativeMouseMotionListener.class) {
+				previous = mouseMotionEventExecutor;
+				mouseMotionEventExecutor = dispatcher;
+			}
+			else if (listenerType == NativeMouseWheelListener.class) {
+				previous = mouseWheelEventExecutor;
+				mouseWheelEventExecutor = dispatcher;
+			}
+			else {
+				throw new IllegalArgumentException("Unsupported listener type: " + listenerType);
+			}
+
+			// The previous executor may still be shared with another listener type.
+			if (previous == keyEventExecutor
+					|| previous == mouseEventExecutor
+					|| previous == mouseMotionEventExecutor
+					|| previous == mouseWheelEventExecutor) {
+				previous = null;
+			}
+		}
+
+		if (previous != null) {
+			previous.shutdown();
 		}
 	}
 
 	/**
-	 * Adds the specified native mouse motion listener to receive mouse motion
-	 * events from the native system. If listener is null, no exception is
-	 * thrown and no action is performed.
+	 * Enable or disable high resolution event timestamps.  When enabled, the
+	 * native library stamps each native event as it enters the native event
+	 * dispatcher, before any filtering, coalescing or conversion, using the
+	 * same monotonic clock as <code>System.nanoTime()</code>.  The dispatch
+	 * executors stamp the event again with <code>System.nanoTime()</code>
+	 * just before the event is delivered to its listeners.  Listeners can
+	 * then measure the time from input to action with
+	 * <code>System.nanoTime() - e.getCaptureTime()</code>.
+	 * <p/>
 	 *
-	 * @param listener a native mouse motion listener object
+	 * Unlike {@link NativeInputEvent#getWhen()}, whose epoch and resolution
+	 * depend on the native platform, the stamps are directly comparable with
+	 * other <code>System.nanoTime()</code> based measurements.  Events
+	 * delivered through the native event queue carry the capture time in
+	 * their record, see {@link NativeEventView#getCaptureTime()}.  Timestamps
+	 * are disabled by default.
+	 *
+	 * @param enabled true to stamp events with the capture and dispatch time.
+	 * @see NativeInputEvent#getCaptureTime()
+	 * @see NativeInputEvent#getDispatchTime()
+	 * @since 1.2
 	 */
-	public void addNativeMouseMotionListener(NativeMouseMotionListener listener) {
-		if (listener != null) {
-			eventListeners.add(NativeMouseMotionListener.class, listener);
-		}
+	public static void setEventTimestamps(boolean enabled) {
+		GlobalScreen.eventTimestamps = enabled;
+		GlobalScreen.setNativeEventTimestamps(enabled);
 	}
 
 	/**
-	 * Removes the specified native mouse motion listener so that it no longer
-	 * receives mouse motion events from the native system. This method performs
-	 * no function if the listener specified by the argument was not previously
-	 * added.  If listener is null, no exception is thrown and no action is
-	 * performed.
+	 * Enable or disable stamping native events with the capture time.
 	 *
-	 * @param listener a native mouse motion listener object
+	 * @param enabled true to stamp native events.
+	 * @since 1.2
 	 */
-	public void removeNativeMouseMotionListener(NativeMouseMotionListener listener) {
-		if (listener != null) {
-			eventListeners.remove(NativeMouseMotionListener.class, listener);
+	private static native void setNativeEventTimestamps(boolean enabled);
+
+	/**
+	 * Record the time an event is about to be delivered to its listeners.
+	 *
+	 * @param e the event being delivered.
+	 * @since 1.2
+	 */
+	private static void stampDispatch(NativeInputEvent e) {
+		if (eventTimestamps) {
+			e.setDispatchTime(System.nanoTime());
 		}
 	}
 
 	/**
-	 * Adds the specified native mouse wheel listener to receive mouse wheel
-	 * events from the native system. If listener is null, no exception is
-	 * thrown and no action is performed.
+	 * Enable or disable event object pooling.  When enabled, the native
+	 * library keeps a fixed number of key, mouse and mouse wheel event objects
+	 * and reinitializes a free one for each native event instead of
+	 * constructing a new event.  Each pooled event is returned to the pool
+	 * once every listener of its group has returned.  A new event is
+	 * constructed whenever the pool is exhausted.
+	 * <p/>
 	 *
-	 * @param listener a native mouse wheel listener object
-	 * @since 1.1
+	 * <b>Note:</b> Listeners must not retain a reference to a pooled event,
+	 * or use it on another thread, after returning from the listener method.
+	 * The same object will be reused for a later event.  Copy the required
+	 * values instead.  Events returned by {@link NativeEventView#createEvent()}
+	 * and events created by the application are never pooled.
+	 * <p/>
+	 *
+	 * Pooling is disabled by default.
+	 *
+	 * @param enabled true to reuse pooled event objects.
+	 * @since 1.2
 	 */
-	public void addNativeMouseWheelListener(NativeMouseWheelListener listener) {
-		if (listener != null) {
-			eventListeners.add(NativeMouseWheelListener.class, listener);
-		}
+	public static void setEventObjectPooling(boolean enabled) {
+		GlobalScreen.setNativeEventPooling(enabled);
 	}
 
 	/**
-	 * Removes the specified native mouse wheel listener so that it no longer
-	 * receives mouse wheel events from the native system. This method performs
-	 * no function if the listener specified by the argument was not previously
-	 * added.  If listener is null, no exception is thrown and no action is
-	 * performed.
+	 * Return a pooled event to the native event pool.  Events that are not
+	 * pooled are ignored.
 	 *
-	 * @param listener a native mouse wheel listener object
-	 * @since 1.1
+	 * @param e the event that all listeners have finished with.
+	 * @since 1.2
 	 */
-	public void removeNativeMouseWheelListener(NativeMouseWheelListener listener) {
-		if (listener != null) {
-			eventListeners.remove(NativeMouseWheelListener.class, listener);
+	private static void release(NativeInputEvent e) {
+		int index = e.getPoolIndex();
+		if (index >= 0) {
+			GlobalScreen.releaseNativeEvent(index);
 		}
 	}
 
 	/**
-	 * Enable the native hook if it is not currently running. If it is running
-	 * the function has no effect.
+	 * Start or stop handing out pooled native event objects.  The pool is
+	 * created the first time pooling is enabled.
+	 *
+	 * @param enabled true to reuse pooled event objects.
+	 * @since 1.2
+	 */
+	private static native void setNativeEventPooling(boolean enabled);
+
+	/**
+	 * Mark the pooled event with the specified pool index as free.
+	 *
+	 * @param index the pool index of the event.
+	 * @since 1.2
+	 */
+	private static native void releaseNativeEvent(int index);
+
+	/**
+	 * Enable or disable mouse motion coalescing.  When enabled, native mouse
+	 * moved and dragged events that arrive while a previous motion event is
+	 * still waiting for or being delivered by the event dispatcher are merged
+	 * in native code.  Only the latest coordinates are delivered once the
+	 * dispatcher is done with the previous event, and the number of merged
+	 * events is available from {@link NativeMouseEvent#getCoalescedCount()}.
+	 * Other events are never merged and are never delivered ahead of a merged
+	 * motion event.
 	 * <p/>
-	 * <b>Note:</b> This method will throw a <code>NativeHookException</code>
-	 * if specific operating system features are unavailable or disabled.
-	 * For example: Access for assistive devices is unchecked in the Universal
-	 * Access section of the System Preferences on Apple's OS X platform or
-	 * <code>Load "record"</code> is missing for the xorg.conf file on
-	 * Unix/Linux/Solaris platforms.
+	 * Coalescing is disabled by default.
 	 *
-	 * @throws NativeHookException problem registering the native hook with
-	 *                             the underlying operating system.
-	 * @since 1.1
+	 * @param enabled true to merge mouse motion events while the event
+	 * dispatcher is busy.
+	 * @since 1.2
 	 */
-	public static native void registerNativeHook() throws NativeHookException;
+	public final void setMouseMotionCoalescing(boolean enabled) {
+		GlobalScreen.mouseMotionCoalescing = enabled;
+		GlobalScreen.setNativeMotionCoalescing(enabled);
+	}
 
 	/**
-	 * Disable the native hook if it is currently registered. If the native
-	 * hook it is not registered the function has no effect.
+	 * Enable or disable merging of native mouse motion events.
 	 *
-	 * @since 1.1
+	 * @param enabled true to merge motion events while the dispatcher is busy.
+	 * @since 1.2
 	 */
-	public static native void unregisterNativeHook();
+	private static native void setNativeMotionCoalescing(boolean enabled);
 
 	/**
-	 * Returns <code>true</code> if the native hook is currently registered.
+	 * Notify the native library that a mouse motion event has been queued for
+	 * dispatch.  Motion events will be merged until the event is complete.
 	 *
-	 * @return true if the native hook is currently registered.
-	 * @throws NativeHookException the native hook exception
-	 * @since 1.1
+	 * @since 1.2
 	 */
-	public static native boolean isNativeHookRegistered();
+	private static native void beginMouseMotion();
 
 	/**
-	 * Send a native input event to the system.
+	 * Notify the native library that a mouse motion event has been delivered
+	 * to all listeners.
 	 *
+	 * @return the motion event merged in the meantime or null if there is
+	 * none, in which case the event is complete.
 	 * @since 1.2
 	 */
-	public static native void postNativeEvent(NativeInputEvent e);
+	private static native NativeMouseEvent completeMouseMotion();
 
 	/**
-	 * Dispatches an event to the appropriate processor.  This method is
-	 * generally called by the native library but maybe used to synthesize
-	 * native events from Java.
-	 * <p/>
-	 * <b>Note:</b> This method executes on the native systems event queue.
-	 * It is imperative that all processing be off-loaded to other threads.
-	 * Failure to do so may result in the delay of user input and the automatic
-	 * removal of the native hook.
+	 * Notify the native library that a mouse motion event passed to
+	 * {@link #beginMouseMotion()} will not be dispatched after all.
+	 *
+	 * @since 1.2
 	 */
-	public final void dispatchEvent(NativeInputEvent e) {
-		if (eventExecutor != null) {
-			if (e instanceof NativeKeyEvent) {
-				processKeyEvent((NativeKeyEvent) e);
-			}
-			else if (e instanceof NativeMouseWheelEvent) {
-				processMouseWheelEvent((NativeMouseWheelEvent) e);
-			}
-			else if (e instanceof NativeMouseEvent) {
-				processMouseEvent((NativeMouseEvent) e);
-			}
-		}
-	}
+	private static native void cancelMouseMotion();
 
 	/**
-	 * Processes native key events by dispatching them to all registered
-	 * <code>NativeKeyListener</code> objects.
+	 * Configure native mouse wheel accumulation.  When enabled, consecutive
+	 * native wheel events with the same scroll type, scroll amount and
+	 * direction are summed in native code and delivered as a single
+	 * <code>NativeMouseWheelEvent</code> per accumulation window.  The
+	 * delivered event carries the summed wheel rotation and the latest
+	 * position, and the number of merged events is available from
+	 * {@link NativeMouseEvent#getCoalescedCount()}.  This greatly reduces the
+	 * number of events dispatched for precision touchpads and free spinning
+	 * wheels without changing the total scroll distance.
+	 * <p/>
 	 *
-	 * @param e the <code>NativeKeyEvent</code> to dispatch.
-	 * @see NativeKeyEvent
-	 * @see NativeKeyListener
-	 * @see #addNativeKeyListener(NativeKeyListener)
+	 * A window closes after <code>windowCount</code> events or with the first
+	 * wheel event that arrives <code>windowMillis</code> milliseconds after
+	 * the window opened, whichever comes first.  Any other native event closes
+	 * the window early and is never delivered ahead of the accumulated event.
+	 * Because windows are only closed by incoming events, the last window of
+	 * a scroll is delivered with the next native event.  Accumulated events
+	 * cannot be consumed.
+	 * <p/>
+	 * Accumulation is disabled by default.
+	 *
+	 * @param windowMillis the maximum length of a window in milliseconds, or
+	 * 0 for no time limit.
+	 * @param windowCount the maximum number of events in a window, or 0 for
+	 * no count limit.
+	 * @throws IllegalArgumentException if either limit is negative.
+	 * @since 1.2
 	 */
-	private void processKeyEvent(NativeKeyEvent e) {
-		/*
-		try {
-			Field f = NativeInputEvent.class.getDeclaredField("propagate");
-			f.setAccessible(true);
-			f.setBoolean(e, false);
+	public final void setMouseWheelAccumulation(int windowMillis, int windowCount) {
+		if (windowMillis < 0 || windowCount < 0) {
+			throw new IllegalArgumentException("The wheel accumulation window must not be negative.");
 		}
-		catch (Exception ex) {
-			ex.printStackTrace();
-		}
-		*/
 
-		// The event cannot be modified beyond this point!  This is both a 
-		// Java restriction and a native code restriction.
-		final NativeKeyEvent event = e;
-		eventExecutor.execute(new Runnable() {
-			public void run() {
-				int id = event.getID();
-				EventListener[] listeners = eventListeners.getListeners(NativeKeyListener.class);
-
-				for (int i = 0; i < listeners.length; i++) {
-					switch (id) {
-						case NativeKeyEvent.NATIVE_KEY_PRESSED:
-							((NativeKeyListener) listeners[i]).nativeKeyPressed(event);
-							break;
-
-						case NativeKeyEvent.NATIVE_KEY_TYPED:
-							((NativeKeyListener) listeners[i]).nativeKeyTyped(event);
-							break;
-
-						case NativeKeyEvent.NATIVE_KEY_RELEASED:
-							((NativeKeyListener) listeners[i]).nativeKeyReleased(event);
-							break;
-					}
-				}
-			}
-		});
+		GlobalScreen.setNativeWheelAccumulation(windowMillis, windowCount);
 	}
 
 	/**
-	 * Processes native mouse events by dispatching them to all registered
-	 * <code>NativeMouseListener</code> objects.
+	 * Configure the native mouse wheel accumulation window.
 	 *
-	 * @param e the <code>NativeMouseEvent</code> to dispatch.
-	 * @see NativeMouseEvent
-	 * @see NativeMouseListener
-	 * @see #addNativeMouseListener(NativeMouseListener)
+	 * @param time the maximum window length in milliseconds, 0 for none.
+	 * @param count the maximum number of events per window, 0 for none.
+	 * @since 1.2
 	 */
-	private void processMouseEvent(NativeMouseEvent e) {
-		// The event cannot be modified beyond this point!  This is both a 
-		// Java restriction and a native code restriction.
-		final NativeMouseEvent event = e;
-		eventExecutor.execute(new Runnable() {
-			public void run() {
-				int id = event.getID();
+	private static native void setNativeWheelAccumulation(int time, int count);
 
-				EventListener[] listeners;
-				if (id == NativeMouseEvent.NATIVE_MOUSE_MOVED || id == NativeMouseEvent.NATIVE_MOUSE_DRAGGED) {
-					listeners = eventListeners.getListeners(NativeMouseMotionListener.class);
-				}
-				else {
-					listeners = eventListeners.getListeners(NativeMouseListener.class);
-				}
+	/**
+	 * Enable or disable batched event delivery through the native event queue.
+	 * When enabled, the native hook callback only copies each event into a
+	 * fixed size ring buffer and returns.  A separate drain thread copies
+	 * batches of events out of the ring buffer into a direct
+	 * <code>ByteBuffer</code> with a single native call.  Each event is first
+	 * delivered to the registered <code>NativeEventViewListener</code> objects
+	 * through a reusable <code>NativeEventView</code> and then, if any other
+	 * listeners are registered, passed to
+	 * {@link #dispatchEvent(NativeInputEvent)} as a new event object.  This
+	 * keeps the time spent in the operating system hook to a minimum.
+	 * <p/>
+	 * <b>Note:</b> Events delivered through the native event queue have
+	 * already been delivered to the native system and cannot be consumed.
+	 * Events that arrive while the queue is full are discarded.
+	 *
+	 * @param enabled true to deliver events through the native event queue.
+	 * @since 1.2
+	 */
+	public final synchronized void setEventQueueEnabled(boolean enabled) {
+		if (enabled && eventQueueThread == null) {
+			eventQueueDiscard = false;
+			GlobalScreen.enableEventQueue();
 
-				for (int i = 0; i < listeners.length; i++) {
-					switch (id) {
-						case NativeMouseEvent.NATIVE_MOUSE_CLICKED:
-							((NativeMouseListener) listeners[i]).nativeMouseClicked(event);
-							break;
+			eventQueueThread = new Thread(new Runnable() {
+				public void run() {
+					ByteBuffer records = ByteBuffer.allocateDirect(EVENT_BATCH_SIZE * NativeEventView.RECORD_BYTES);
+					records.order(ByteOrder.nativeOrder());
 
-						case NativeMouseEvent.NATIVE_MOUSE_PRESSED:
-							((NativeMouseListener) listeners[i]).nativeMousePressed(event);
-							break;
+					NativeEventView view = new NativeEventView(records);
 
-						case NativeMouseEvent.NATIVE_MOUSE_RELEASED:
-							((NativeMouseListener) listeners[i]).nativeMouseReleased(event);
-							break;
+					int count;
+					while ((count = GlobalScreen.drainEvents(records)) >= 0) {
+						for (int i = 0; i < count && !eventQueueDiscard; i++) {
+							view.setIndex(i);
 
-						case NativeMouseEvent.NATIVE_MOUSE_MOVED:
-							((NativeMouseMotionListener) listeners[i]).nativeMouseMoved(event);
-							break;
+							// A failing listener must not stop the only consumer of the queue.
+							NativeEventViewListener[] listeners = eventViewListeners;
+							for (int j = 0; j < listeners.length; j++) {
+								try {
+									listeners[j].nativeEventReceived(view);
+								}
+								catch (Throwable t) {
+									GlobalScreen.logCallbackException("view listener", t);
+								}
+							}
 
-						case NativeMouseEvent.NATIVE_MOUSE_DRAGGED:
-							((NativeMouseMotionListener) listeners[i]).nativeMouseDragged(event);
-							break;
+							// Only materialize an event object if someone will receive it.
+							if ((eventListenerMask & getEventMask(view.getID())) != 0) {
+								try {
+									dispatchEvent(view.createEvent());
+								}
+								catch (Throwable t) {
+									GlobalScreen.logCallbackException("dispatcher", t);
+								}
+							}
+						}
 					}
 				}
+			});
+			eventQueueThread.setName("JNativeHook Event Queue");
+			eventQueueThread.setDaemon(true);
+			eventQueueThread.start();
+		}
+		else if (!enabled && eventQueueThread != null) {
+			GlobalScreen.disableEventQueue();
+
+			// Wait for the drain thread to empty the queue so that there is never
+			// more than one consumer.
+			try {
+				eventQueueThread.join();
 			}
-		});
+			catch (InterruptedException e) {
+				Thread.currentThread().interrupt();
+			}
+
+			eventQueueThread = null;
+		}
 	}
 
 	/**
-	 * Processes native mouse wheel events by dispatching them to all registered
-	 * <code>NativeMouseWheelListener</code> objects.
+	 * Start accepting events into the native event queue.
 	 *
-	 * @param e The <code>NativeMouseWheelEvent</code> to dispatch.
-	 * @see NativeMouseWheelEvent
-	 * @see NativeMouseWheelListener
-	 * @see #addNativeMouseWheelListener(NativeMouseWheelListener)
-	 * @since 1.1
+	 * @since 1.2
 	 */
-	private void processMouseWheelEvent(NativeMouseWheelEvent e) {
-		// The event cannot be modified beyond this point!  This is both a 
-		// Java restriction and a native code restriction.
-		final NativeMouseWheelEvent event = e;
-		eventExecutor.execute(new Runnable() {
-			public void run() {
-				EventListener[] listeners = eventListeners.getListeners(NativeMouseWheelListener.class);
-
-				for (int i = 0; i < listeners.length; i++) {
-					((NativeMouseWheelListener) listeners[i]).nativeMouseWheelMoved(event);
-				}
-			}
-		});
-	}
+	private static native void enableEventQueue();
 
 	/**
-	 * Set a different executor service for native event delivery.  By default,
-	 * JNativeHook utilizes a single thread executor to dispatch events from
-	 * the native event queue.  You may choose to use an alternative approach
-	 * for event delivery by implementing an <code>ExecutorService</code>.
-	 * <p/>
-	 * <b>Note:</b> Using null as an <code>ExecutorService</code> will cause all
-	 * delivered events to be discard until a valid <code>ExecutorService</code>
-	 * is set.
+	 * Stop accepting events into the native event queue and wake the drain
+	 * thread.
 	 *
-	 * @param dispatcher The <code>ExecutorService</code> used to dispatch native events.
-	 * @see java.util.concurrent.ExecutorService
-	 * @see java.util.concurrent.Executors#newSingleThreadExecutor()
 	 * @since 1.2
 	 */
-	public final void setEventDispatcher(ExecutorService dispatcher) {
-		if (GlobalScreen.eventExecutor != null) {
-			GlobalScreen.eventExecutor.shutdown();
-		}
+	private static native void disableEventQueue();
 
-		GlobalScreen.eventExecutor = dispatcher;
-	}
+	/**
+	 * Copy events from the native event queue into the specified direct
+	 * buffer.  Each event occupies <code>EVENT_RECORD_SIZE</code> consecutive
+	 * native order <code>long</code> values, as described by
+	 * <code>NativeEventView</code>.  This method will block until at least one
+	 * event is available.
+	 *
+	 * @param records the direct buffer to copy event records into.
+	 * @return the number of events copied or -1 if the queue was disabled.
+	 * @since 1.2
+	 */
+	private static native int drainEvents(ByteBuffer records);
 
 	/**
 	 * Perform procedures to interface with the native library. These procedures
 	 * include unpacking and loading the library into the Java Virtual Machine.
+	 * <p/>
+	 *
+	 * If the library is not on the <code>java.library.path</code>, the bundled
+	 * copy is extracted into a version specific directory below
+	 * <code>jnativehook.tmpdir</code>, or <code>java.io.tmpdir</code> if that
+	 * property is not set.  The extracted copy is verified and reused by later
+	 * launches.  Set <code>jnativehook.banner</code> to <code>false</code> to
+	 * skip printing the license banner.
 	 */
 	private static void loadNativeLibrary() {
-		System.out.println("\n" +
-			"JNativeHook: Global keyboard and mouse hooking for Java.\n" +
-			"Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.\n" +
-			"https://github.com/kwhat/libuiohook/\n" +
-			"\n" +
-			"JNativeHook is free software: you can redistribute it and/or modify\n" +
-			"it under the terms of the GNU Lesser General Public License as published\n" +
-			"by the Free Software Foundation, either version 3 of the License, or\n" +
-			"(at your option) any later version.\n" +
-			"\n" +
-			"JNativeHook is distributed in the hope that it will be useful,\n" +
-			"but WITHOUT ANY WARRANTY; without even the implied warranty of\n" +
-			"MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the\n" +
-			"GNU General Public License for more details.\n" +
-			"\n" +
-			"You should have received a copy of the GNU Lesser General Public License\n" +
-			"along with this program.  If not, see <http://www.gnu.org/licenses/>.\n");
+		if (Boolean.parseBoolean(System.getProperty("jnativehook.banner", "true"))) {
+			System.out.println("\n" +
+				"JNativeHook: Global keyboard and mouse hooking for Java.\n" +
+				"Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.\n" +
+				"https://github.com/kwhat/libuiohook/\n" +
+				"\n" +
+				"JNativeHook is free software: you can redistribute it and/or modify\n" +
+				"it under the terms of the GNU Lesser General Public License as published\n" +
+				"by the Free Software Foundation, either version 3 of the License, or\n" +
+				"(at your option) any later version.\n" +
+				"\n" +
+				"JNativeHook is distributed in the hope that it will be useful,\n" +
+				"but WITHOUT ANY WARRANTY; without even the implied warranty of\n" +
+				"MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the\n" +
+				"GNU General Public License for more details.\n" +
+				"\n" +
+				"You should have received a copy of the GNU Lesser General Public License\n" +
+				"along with this program.  If not, see <http://www.gnu.org/licenses/>.\n");
+		}
 
 		String libName = "JNativeHook";
 
@@ -488,15 +2861,14 @@ public class GlobalScreen {
 				String libNativeSuffix = libNativeName.substring(i);
 
 				// Determine if the user specified temp directory should be used.
-				String tmpDir = System.getProperty("jnativehook.tmpdir", null);
-
-				File libDir = null;
-				if (tmpDir != null) {
-					libDir = new File(tmpDir);
-				}
+				String tmpDir = System.getProperty("jnativehook.tmpdir", System.getProperty("java.io.tmpdir"));
 
-				// Create the temp file for this instance of the library.
-				File libFile = File.createTempFile(libNativePrefix, libNativeSuffix, libDir);
+				// Cached libraries are kept per user and version and named by
+				// their content.
+				String version = GlobalScreen.class.getPackage().getImplementationVersion();
+				File libDir = NativeLibraryCache.getCacheDirectory(new File(tmpDir),
+						System.getProperty("user.name", "unknown"),
+						version != null ? version : "unknown");
 
 				// This may return null in some circumstances.
 				InputStream libInputStream =
@@ -509,18 +2881,8 @@ public class GlobalScreen {
 					throw new IOException("Unable to locate the native library.");
 				}
 
-				// Check and see if a copy of the native lib already exists.
-				FileOutputStream libOutputStream = new FileOutputStream(libFile);
-				byte[] buffer = new byte[4 * 1024];
-
-				int size;
-				while ((size = libInputStream.read(buffer)) != -1) {
-					libOutputStream.write(buffer, 0, size);
-				}
-				libOutputStream.close();
-				libInputStream.close();
-
-				libFile.deleteOnExit();
+				// Reuse a verified copy of the native lib if one already exists.
+				File libFile = NativeLibraryCache.extract(libInputStream, libDir, libNativePrefix, libNativeSuffix);
 
 				System.load(libFile.getPath());
 			}
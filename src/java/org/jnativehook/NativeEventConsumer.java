@@ -0,0 +1,50 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving every native event on a dedicated
+ * consumer thread.
+ * <p/>
+ *
+ * The class that is interested in a complete stream of native input events
+ * implements this interface, and the object created with that class is
+ * registered with the <code>GlobalScreen</code> using the
+ * {@link GlobalScreen#addNativeEventConsumer(NativeEventConsumer, int, NativeEventSubscription.OverflowPolicy)}
+ * method.  Each consumer has its own bounded queue and thread, so a slow
+ * consumer only affects itself according to its overflow policy.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeEventSubscription
+ */
+public interface NativeEventConsumer extends EventListener {
+	/**
+	 * Invoked on the consumer thread for each native event taken from the
+	 * consumer's queue.  The event may be shared with other consumers and
+	 * must not be modified.
+	 *
+	 * @param event the native event.
+	 */
+	public void nativeEventReceived(NativeInputEvent event);
+}
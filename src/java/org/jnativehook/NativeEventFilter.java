@@ -0,0 +1,57 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import java.util.EventListener;
+
+/**
+ * The listener interface for synchronously filtering native events before
+ * they are delivered to the native system.
+ * <p/>
+ *
+ * The class that is interested in consuming native events implements this
+ * interface, and the object created with that class is registered with the
+ * <code>GlobalScreen</code> using the
+ * {@link GlobalScreen#addNativeEventFilter(Class, NativeEventFilter)} method.
+ * Unlike other listeners, filters are invoked inline on the native hook thread
+ * before the event is released to the rest of the system.
+ * <p/>
+ *
+ * <b>Note:</b> Filters must return as quickly as possible.  If all of the
+ * filters for an event take longer than the budget set with
+ * {@link GlobalScreen#setEventFilterBudget(long, java.util.concurrent.TimeUnit)}
+ * the event is passed through to the native system regardless of the result.
+ * Event consumption may not be supported by all native platforms.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see GlobalScreen#addNativeEventFilter(Class, NativeEventFilter)
+ */
+public interface NativeEventFilter extends EventListener {
+	/**
+	 * Invoked on the native hook thread when a native event has been received.
+	 *
+	 * @param event the native event.
+	 * @return true to prevent the event from being delivered to the native
+	 * system.
+	 */
+	public boolean filterNativeEvent(NativeInputEvent event);
+}
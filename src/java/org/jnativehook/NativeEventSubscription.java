@@ -0,0 +1,527 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+
+import java.util.concurrent.locks.Condition;
+import java.util.concurrent.locks.ReentrantLock;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * A registered {@link NativeEventConsumer} along with its bounded event queue,
+ * its consumer thread and its delivery counters.
+ * <p/>
+ *
+ * Every native event delivered to Java is offered to the queue of each
+ * subscription.  When a queue is full the subscription's
+ * {@link OverflowPolicy} decides what happens to the new event, so one slow
+ * consumer can neither exhaust the heap nor hold up other consumers unless it
+ * uses {@link OverflowPolicy#BLOCK}.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see GlobalScreen#addNativeEventConsumer(NativeEventConsumer, int, OverflowPolicy)
+ */
+public final class NativeEventSubscription {
+	/**
+	 * The action taken when an event is offered to a full queue.
+	 */
+	public enum OverflowPolicy {
+		/**
+		 * Wait for the consumer to make room.  The wait happens on the thread
+		 * dispatching native events, which is usually the native hook thread,
+		 * so this delays every listener, consumer and the native system
+		 * itself.  Only use this policy for consumers that keep up.
+		 */
+		BLOCK,
+
+		/** Discard the oldest queued event to make room for the new one. */
+		DROP_OLDEST,
+
+		/** Discard the new event. */
+		DROP_NEWEST,
+
+		/**
+		 * Merge the new event into the newest queued event if both are mouse
+		 * motion events of the same type, or mouse wheel events of the same
+		 * scroll type, scroll amount and direction.  Other events are
+		 * discarded like <code>DROP_NEWEST</code>.
+		 */
+		COALESCE
+	}
+
+	/** The logger used to report exceptions thrown by the consumer. */
+	private static final Logger log = Logger.getLogger(GlobalScreen.class.getPackage().getName());
+
+	/** The consumer receiving the events. */
+	private final NativeEventConsumer consumer;
+
+	/** The overflow policy of the queue. */
+	private final OverflowPolicy policy;
+
+	/** The queued events and the time each was queued, as a ring buffer. */
+	private final NativeInputEvent[] events;
+	private final long[] queued;
+
+	/** The index of the oldest queued event and the number of queued events. */
+	private int head = 0;
+	private int size = 0;
+
+	/** Guards the queue and the counters below. */
+	private final ReentrantLock lock = new ReentrantLock();
+
+	private final Condition notEmpty = lock.newCondition();
+	private final Condition notFull = lock.newCondition();
+
+	/** Cleared when the subscription is removed. */
+	private boolean active = true;
+
+	private long deliveredCount = 0;
+	private long droppedCount = 0;
+	private long coalescedCount = 0;
+	private int maxQueueSize = 0;
+	private long lag = 0;
+	private long maxLag = 0;
+
+	/** The thread delivering events to the consumer. */
+	private final Thread thread;
+
+	/**
+	 * Creates a subscription and starts its consumer thread.
+	 *
+	 * @param consumer the consumer receiving the events.
+	 * @param capacity the maximum number of queued events.
+	 * @param policy the action taken when the queue is full.
+	 */
+	NativeEventSubscription(NativeEventConsumer consumer, int capacity, OverflowPolicy policy) {
+		this.consumer = consumer;
+		this.policy = policy;
+		this.events = new NativeInputEvent[capacity];
+		this.queued = new long[capacity];
+
+		thread = new Thread(new Runnable() {
+			public void run() {
+				try {
+					NativeInputEvent event;
+					while ((event = take()) != null) {
+						try {
+							NativeEventSubscription.this.consumer.nativeEventReceived(event);
+						}
+						catch (Throwable t) {
+							log.log(Level.WARNING, "Native event consumer failed.", t);
+						}
+					}
+				}
+				finally {
+					// Never leave a blocked producer waiting for a thread that is gone.
+					close();
+				}
+			}
+		});
+		thread.setName("JNativeHook Event Consumer");
+		thread.setDaemon(true);
+		thread.start();
+	}
+
+	/**
+	 * Returns the consumer receiving the events.
+	 *
+	 * @return the native event consumer
+	 */
+	public NativeEventConsumer getConsumer() {
+		return consumer;
+	}
+
+	/**
+	 * Returns the action taken when the queue is full.
+	 *
+	 * @return the overflow policy
+	 */
+	public OverflowPolicy getOverflowPolicy() {
+		return policy;
+	}
+
+	/**
+	 * Returns the maximum number of queued events.
+	 *
+	 * @return the queue capacity
+	 */
+	public int getCapacity() {
+		return events.length;
+	}
+
+	/**
+	 * Returns the number of events waiting to be delivered.
+	 *
+	 * @return the current queue size
+	 */
+	public int getQueueSize() {
+		lock.lock();
+		try {
+			return size;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns the largest number of events that were waiting at once.
+	 *
+	 * @return the maximum queue size
+	 */
+	public int getMaxQueueSize() {
+		lock.lock();
+		try {
+			return maxQueueSize;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns the number of events passed to the consumer.
+	 *
+	 * @return the delivered event count
+	 */
+	public long getDeliveredCount() {
+		lock.lock();
+		try {
+			return deliveredCount;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns the number of events discarded because the queue was full.
+	 *
+	 * @return the dropped event count
+	 */
+	public long getDroppedCount() {
+		lock.lock();
+		try {
+			return droppedCount;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns the number of events merged into a queued event by the
+	 * <code>COALESCE</code> policy.
+	 *
+	 * @return the coalesced event count
+	 */
+	public long getCoalescedCount() {
+		lock.lock();
+		try {
+			return coalescedCount;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns the time the most recently delivered event spent in the queue.
+	 *
+	 * @return the lag in nanoseconds
+	 */
+	public long getLag() {
+		lock.lock();
+		try {
+			return lag;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns the longest time an event spent in the queue.
+	 *
+	 * @return the maximum lag in nanoseconds
+	 */
+	public long getMaxLag() {
+		lock.lock();
+		try {
+			return maxLag;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Returns <code>true</code> until the subscription is removed.
+	 *
+	 * @return true if the subscription receives events
+	 */
+	public boolean isActive() {
+		lock.lock();
+		try {
+			return active;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Queue an event according to the overflow policy.
+	 *
+	 * @param event the event to queue.
+	 */
+	void offer(NativeInputEvent event) {
+		long now = System.nanoTime();
+
+		lock.lock();
+		try {
+			boolean accept = active;
+
+			if (accept && size == events.length) {
+				switch (policy) {
+					case BLOCK:
+						while (active && size == events.length) {
+							notFull.awaitUninterruptibly();
+						}
+						accept = active;
+						break;
+
+					case DROP_OLDEST:
+						events[head] = null;
+						head = (head + 1) % events.length;
+						size--;
+						droppedCount++;
+						break;
+
+					case DROP_NEWEST:
+						droppedCount++;
+						accept = false;
+						break;
+
+					case COALESCE:
+						int tail = (head + size - 1) % events.length;
+
+						NativeInputEvent merged = merge(events[tail], event);
+						if (merged != null) {
+							// The merged event keeps its place and queue time.
+							events[tail] = merged;
+							coalescedCount++;
+						}
+						else {
+							droppedCount++;
+						}
+						accept = false;
+						break;
+				}
+			}
+
+			if (accept) {
+				int tail = (head + size) % events.length;
+				events[tail] = event;
+				queued[tail] = now;
+				size++;
+
+				if (size > maxQueueSize) {
+					maxQueueSize = size;
+				}
+
+				notEmpty.signal();
+			}
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Wait for the next queued event.
+	 *
+	 * @return the next event or null once the subscription is removed.
+	 */
+	private NativeInputEvent take() {
+		NativeInputEvent event = null;
+
+		lock.lock();
+		try {
+			while (active && size == 0) {
+				notEmpty.awaitUninterruptibly();
+			}
+
+			if (active) {
+				event = events[head];
+				events[head] = null;
+
+				lag = System.nanoTime() - queued[head];
+				if (lag > maxLag) {
+					maxLag = lag;
+				}
+
+				head = (head + 1) % events.length;
+				size--;
+				deliveredCount++;
+
+				// Wake a blocked producer as well as a shutdown waiting for the queue.
+				notFull.signalAll();
+			}
+		}
+		finally {
+			lock.unlock();
+		}
+
+		return event;
+	}
+
+	/**
+	 * Wait until every queued event has been taken by the consumer thread.
+	 *
+	 * @param deadline the <code>System.nanoTime()</code> to stop waiting at.
+	 * @return true if the queue is empty.
+	 */
+	boolean awaitDrained(long deadline) {
+		lock.lock();
+		try {
+			long remaining;
+			while (active && size > 0 && (remaining = deadline - System.nanoTime()) > 0) {
+				try {
+					notFull.awaitNanos(remaining);
+				}
+				catch (InterruptedException e) {
+					Thread.currentThread().interrupt();
+					break;
+				}
+			}
+
+			return size == 0;
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Stop delivering events.  Queued events are discarded and a producer
+	 * waiting for space is released.  An event already passed to the consumer
+	 * is allowed to complete.
+	 */
+	void close() {
+		lock.lock();
+		try {
+			active = false;
+
+			for (int i = 0; i < size; i++) {
+				events[(head + i) % events.length] = null;
+			}
+			size = 0;
+
+			notEmpty.signalAll();
+			notFull.signalAll();
+		}
+		finally {
+			lock.unlock();
+		}
+	}
+
+	/**
+	 * Merge two consecutive events for the <code>COALESCE</code> policy.
+	 *
+	 * @param previous the newest queued event.
+	 * @param next the event being offered.
+	 * @return the merged event or null if the events cannot be merged.
+	 */
+	static NativeInputEvent merge(NativeInputEvent previous, NativeInputEvent next) {
+		NativeInputEvent merged = null;
+
+		if (previous.getID() == next.getID()) {
+			switch (next.getID()) {
+				case NativeMouseEvent.NATIVE_MOUSE_MOVED:
+				case NativeMouseEvent.NATIVE_MOUSE_DRAGGED:
+					NativeMouseEvent motion = (NativeMouseEvent) next;
+					merged = new NativeMouseEvent(motion.getID(), motion.getWhen(), motion.getModifiers(),
+							motion.getX(), motion.getY(), motion.getClickCount(), motion.getButton(),
+							((NativeMouseEvent) previous).getCoalescedCount() + motion.getCoalescedCount());
+					merged.setCaptureTime(motion.getCaptureTime());
+					break;
+
+				case NativeMouseEvent.NATIVE_MOUSE_WHEEL:
+					NativeMouseWheelEvent first = (NativeMouseWheelEvent) previous;
+					NativeMouseWheelEvent wheel = (NativeMouseWheelEvent) next;
+
+					if (first.getScrollType() == wheel.getScrollType()
+							&& first.getScrollAmount() == wheel.getScrollAmount()
+							&& (first.getWheelRotation() < 0) == (wheel.getWheelRotation() < 0)) {
+						merged = new NativeMouseWheelEvent(wheel.getID(), wheel.getWhen(), wheel.getModifiers(),
+								wheel.getX(), wheel.getY(), wheel.getClickCount(),
+								wheel.getScrollType(), wheel.getScrollAmount(),
+								first.getWheelRotation() + wheel.getWheelRotation(),
+								first.getCoalescedCount() + wheel.getCoalescedCount());
+						merged.setCaptureTime(wheel.getCaptureTime());
+					}
+					break;
+			}
+		}
+
+		return merged;
+	}
+
+	/**
+	 * Returns a copy of a pooled event that may be retained by consumers.
+	 *
+	 * @param event the pooled event.
+	 * @return a new event with the same values.
+	 */
+	static NativeInputEvent copy(NativeInputEvent event) {
+		NativeInputEvent copy = event;
+
+		if (event instanceof NativeKeyEvent) {
+			NativeKeyEvent key = (NativeKeyEvent) event;
+			copy = new NativeKeyEvent(key.getID(), key.getWhen(), key.getModifiers(),
+					key.getRawCode(), key.getKeyCode(), key.getKeyChar(), key.getKeyLocation());
+		}
+		else if (event instanceof NativeMouseWheelEvent) {
+			NativeMouseWheelEvent wheel = (NativeMouseWheelEvent) event;
+			copy = new NativeMouseWheelEvent(wheel.getID(), wheel.getWhen(), wheel.getModifiers(),
+					wheel.getX(), wheel.getY(), wheel.getClickCount(),
+					wheel.getScrollType(), wheel.getScrollAmount(), wheel.getWheelRotation(),
+					wheel.getCoalescedCount());
+		}
+		else if (event instanceof NativeMouseEvent) {
+			NativeMouseEvent mouse = (NativeMouseEvent) event;
+			copy = new NativeMouseEvent(mouse.getID(), mouse.getWhen(), mouse.getModifiers(),
+					mouse.getX(), mouse.getY(), mouse.getClickCount(), mouse.getButton(),
+					mouse.getCoalescedCount());
+		}
+
+		copy.setCaptureTime(event.getCaptureTime());
+		copy.setDispatchTime(event.getDispatchTime());
+
+		return copy;
+	}
+}
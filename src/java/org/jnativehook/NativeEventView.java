@@ -0,0 +1,360 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+
+import java.nio.ByteBuffer;
+
+/**
+ * A reusable, read-only view of a single native event record stored in a
+ * direct <code>ByteBuffer</code> shared with the native library.  The view is
+ * repositioned for each event instead of allocating a new event object, making
+ * it suitable for high frequency listeners that must not generate garbage.
+ * <p/>
+ *
+ * A <code>NativeEventView</code> is only valid for the duration of the
+ * {@link NativeEventViewListener#nativeEventReceived(NativeEventView)} call it
+ * was passed to.  Listeners must not retain a reference to the view; copy the
+ * required values or call {@link #createEvent()} instead.
+ * <p/>
+ *
+ * Fields that do not apply to the current event type return undefined values.
+ * For example, {@link #getX()} is only valid for mouse events.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeEventViewListener
+ * @see GlobalScreen#addNativeEventViewListener(NativeEventViewListener)
+ */
+public final class NativeEventView {
+	/**
+	 * The size of a single event record in bytes.  Each record contains six
+	 * native order <code>long</code> values laid out as follows:
+	 * <pre>
+	 * [0] when
+	 * [1] id &lt;&lt; 32 | modifiers
+	 * [2] rawCode &lt;&lt; 32 | keyCode, or x &lt;&lt; 32 | y
+	 * [3] keyChar &lt;&lt; 32 | keyLocation, or clickCount &lt;&lt; 32 | button,
+	 *     or clickCount &lt;&lt; 32 | coalescedCount &lt;&lt; 16 | scrollType
+	 * [4] scrollAmount &lt;&lt; 32 | wheelRotation, or coalescedCount
+	 * [5] captureTime
+	 * </pre>
+	 * A coalesced count of 0 is read as a single native event.
+	 */
+	public static final int RECORD_BYTES = 6 * 8;
+
+	/**
+	 * The size of a single event record in <code>long</code> values.
+	 *
+	 * @see GlobalScreen#postNativeEvents(long[], int, int)
+	 */
+	public static final int RECORD_SIZE = RECORD_BYTES / 8;
+
+	/** The largest coalesced count that fits in a wheel event record. */
+	private static final int MAX_WHEEL_COUNT = 0xFFFF;
+
+	/** The buffer containing the event records. */
+	private final ByteBuffer buffer;
+
+	/** The byte offset of the current record. */
+	private int offset;
+
+	/**
+	 * Instantiates a new view over the specified buffer.  The buffer must use
+	 * the native byte order.
+	 *
+	 * @param buffer the buffer containing native event records.
+	 */
+	NativeEventView(ByteBuffer buffer) {
+		this.buffer = buffer;
+		this.offset = 0;
+	}
+
+	/**
+	 * Moves the view to the record at the specified index.
+	 *
+	 * @param index the index of the record in the buffer.
+	 */
+	void setIndex(int index) {
+		this.offset = index * RECORD_BYTES;
+	}
+
+	/**
+	 * Gets the event type.
+	 *
+	 * @return the event type
+	 */
+	public int getID() {
+		return (int) (buffer.getLong(offset + 8) >> 32);
+	}
+
+	/**
+	 * Gets the timestamp for when this event occurred.
+	 *
+	 * @return the timestamp in milliseconds
+	 */
+	public long getWhen() {
+		return buffer.getLong(offset);
+	}
+
+	/**
+	 * Gets the modifier flags for this event.
+	 *
+	 * @return the modifier flags
+	 */
+	public int getModifiers() {
+		return (int) buffer.getLong(offset + 8);
+	}
+
+	/**
+	 * Returns the raw native code for a key event.
+	 *
+	 * @return the native key code
+	 */
+	public int getRawCode() {
+		return (int) (buffer.getLong(offset + 16) >> 32);
+	}
+
+	/**
+	 * Returns the virtual key code for a key event.
+	 *
+	 * @return the virtual key code
+	 */
+	public int getKeyCode() {
+		return (int) buffer.getLong(offset + 16);
+	}
+
+	/**
+	 * Returns the Unicode character for a key typed event.
+	 *
+	 * @return the Unicode character
+	 */
+	public char getKeyChar() {
+		return (char) (buffer.getLong(offset + 24) >> 32);
+	}
+
+	/**
+	 * Returns the location of the key for a key event.
+	 *
+	 * @return the key location
+	 */
+	public int getKeyLocation() {
+		return (int) buffer.getLong(offset + 24);
+	}
+
+	/**
+	 * Returns the x coordinate for a mouse event.
+	 *
+	 * @return the horizontal position of the native pointer
+	 */
+	public int getX() {
+		return (int) (buffer.getLong(offset + 16) >> 32);
+	}
+
+	/**
+	 * Returns the y coordinate for a mouse event.
+	 *
+	 * @return the vertical position of the native pointer
+	 */
+	public int getY() {
+		return (int) buffer.getLong(offset + 16);
+	}
+
+	/**
+	 * Returns the number of button clicks for a mouse event.
+	 *
+	 * @return the number of button clicks
+	 */
+	public int getClickCount() {
+		return (int) (buffer.getLong(offset + 24) >> 32);
+	}
+
+	/**
+	 * Returns the mouse button that has changed state for a mouse event.
+	 *
+	 * @return the mouse button
+	 */
+	public int getButton() {
+		return (int) buffer.getLong(offset + 24);
+	}
+
+	/**
+	 * Returns the type of scrolling for a mouse wheel event.
+	 *
+	 * @return <code>WHEEL_UNIT_SCROLL</code> or <code>WHEEL_BLOCK_SCROLL</code>
+	 */
+	public int getScrollType() {
+		return (int) buffer.getLong(offset + 24) & 0xFFFF;
+	}
+
+	/**
+	 * Returns the number of units to scroll for a mouse wheel event.
+	 *
+	 * @return the number of units to scroll
+	 */
+	public int getScrollAmount() {
+		return (int) (buffer.getLong(offset + 32) >> 32);
+	}
+
+	/**
+	 * Returns the number of "clicks" the mouse wheel was rotated.
+	 *
+	 * @return negative values if the wheel was rotated up, positive values if
+	 * the wheel was rotated down
+	 */
+	public int getWheelRotation() {
+		return (int) buffer.getLong(offset + 32);
+	}
+
+	/**
+	 * Returns the number of native events merged into a mouse motion or mouse
+	 * wheel event.  All other events represent a single native event.
+	 *
+	 * @return the number of coalesced native events
+	 * @see GlobalScreen#setMouseMotionCoalescing(boolean)
+	 * @see GlobalScreen#setMouseWheelAccumulation(int, int)
+	 */
+	public int getCoalescedCount() {
+		int count = 1;
+
+		switch (getID()) {
+			case NativeMouseEvent.NATIVE_MOUSE_MOVED:
+			case NativeMouseEvent.NATIVE_MOUSE_DRAGGED:
+				count = (int) buffer.getLong(offset + 32);
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_WHEEL:
+				count = (int) buffer.getLong(offset + 24) >>> 16;
+				break;
+		}
+
+		return count > 0 ? count : 1;
+	}
+
+	/**
+	 * Returns the high resolution time the native event was captured.
+	 *
+	 * @return the capture time in nanoseconds or 0 if the event was not
+	 * stamped.
+	 * @see NativeInputEvent#getCaptureTime()
+	 * @see GlobalScreen#setEventTimestamps(boolean)
+	 */
+	public long getCaptureTime() {
+		return buffer.getLong(offset + 40);
+	}
+
+	/**
+	 * Pack two 32-bit values into a single record slot.
+	 */
+	private static long pack(int high, int low) {
+		return ((long) high << 32) | (low & 0xFFFFFFFFL);
+	}
+
+	/**
+	 * Writes the specified event into a <code>long</code> array using the
+	 * record layout described by {@link #RECORD_BYTES}.
+	 *
+	 * @param event the event to write.
+	 * @param records the array receiving the record.
+	 * @param index the index of the record in the array.
+	 */
+	static void writeRecord(NativeInputEvent event, long[] records, int index) {
+		int offset = index * RECORD_SIZE;
+
+		records[offset] = event.getWhen();
+		records[offset + 1] = pack(event.getID(), event.getModifiers());
+		records[offset + 2] = 0;
+		records[offset + 3] = 0;
+		records[offset + 4] = 0;
+		records[offset + 5] = event.getCaptureTime();
+
+		if (event instanceof NativeKeyEvent) {
+			NativeKeyEvent keyEvent = (NativeKeyEvent) event;
+			records[offset + 2] = pack(keyEvent.getRawCode(), keyEvent.getKeyCode());
+			records[offset + 3] = pack(keyEvent.getKeyChar(), keyEvent.getKeyLocation());
+		}
+		else if (event instanceof NativeMouseWheelEvent) {
+			NativeMouseWheelEvent wheelEvent = (NativeMouseWheelEvent) event;
+			records[offset + 2] = pack(wheelEvent.getX(), wheelEvent.getY());
+			int count = Math.min(wheelEvent.getCoalescedCount(), MAX_WHEEL_COUNT);
+			records[offset + 3] = pack(wheelEvent.getClickCount(), count << 16 | (wheelEvent.getScrollType() & 0xFFFF));
+			records[offset + 4] = pack(wheelEvent.getScrollAmount(), wheelEvent.getWheelRotation());
+		}
+		else if (event instanceof NativeMouseEvent) {
+			NativeMouseEvent mouseEvent = (NativeMouseEvent) event;
+			records[offset + 2] = pack(mouseEvent.getX(), mouseEvent.getY());
+			records[offset + 3] = pack(mouseEvent.getClickCount(), mouseEvent.getButton());
+
+			int id = mouseEvent.getID();
+			if (id == NativeMouseEvent.NATIVE_MOUSE_MOVED || id == NativeMouseEvent.NATIVE_MOUSE_DRAGGED) {
+				records[offset + 4] = pack(0, mouseEvent.getCoalescedCount());
+			}
+		}
+	}
+
+	/**
+	 * Creates a new <code>NativeInputEvent</code> from the current record.
+	 * Unlike the view, the returned event may be retained.
+	 *
+	 * @return a new event or null if the event type is unknown.
+	 */
+	public NativeInputEvent createEvent() {
+		int id = getID();
+
+		NativeInputEvent event = null;
+		switch (id) {
+			case NativeKeyEvent.NATIVE_KEY_PRESSED:
+			case NativeKeyEvent.NATIVE_KEY_RELEASED:
+			case NativeKeyEvent.NATIVE_KEY_TYPED:
+				event = new NativeKeyEvent(id, getWhen(), getModifiers(),
+						getRawCode(), getKeyCode(), getKeyChar(), getKeyLocation());
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_CLICKED:
+			case NativeMouseEvent.NATIVE_MOUSE_PRESSED:
+			case NativeMouseEvent.NATIVE_MOUSE_RELEASED:
+				event = new NativeMouseEvent(id, getWhen(), getModifiers(),
+						getX(), getY(), getClickCount(), getButton());
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_MOVED:
+			case NativeMouseEvent.NATIVE_MOUSE_DRAGGED:
+				event = new NativeMouseEvent(id, getWhen(), getModifiers(),
+						getX(), getY(), getClickCount(), getButton(), getCoalescedCount());
+				break;
+
+			case NativeMouseEvent.NATIVE_MOUSE_WHEEL:
+				event = new NativeMouseWheelEvent(id, getWhen(), getModifiers(),
+						getX(), getY(), getClickCount(),
+						getScrollType(), getScrollAmount(), getWheelRotation(), getCoalescedCount());
+				break;
+		}
+
+		if (event != null) {
+			event.setCaptureTime(getCaptureTime());
+		}
+
+		return event;
+	}
+}
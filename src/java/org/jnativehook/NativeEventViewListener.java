@@ -0,0 +1,54 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving native events without allocating an
+ * event object for each event.
+ * <p/>
+ *
+ * The class that is interested in processing native events as a
+ * <code>NativeEventView</code> implements this interface, and the object
+ * created with that class is registered with the <code>GlobalScreen</code>
+ * using the {@link GlobalScreen#addNativeEventViewListener(NativeEventViewListener)}
+ * method.  Views are only delivered while the native event queue is enabled
+ * with {@link GlobalScreen#setEventQueueEnabled(boolean)}.
+ * <p/>
+ *
+ * <b>Note:</b> This listener is invoked on the event queue drain thread and
+ * the view passed to it is reused for the next event.  Do not retain the view
+ * beyond the scope of the method call.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeEventView
+ */
+public interface NativeEventViewListener extends EventListener {
+	/**
+	 * Invoked when a native event has been received.
+	 *
+	 * @param view a view of the native event that is only valid for the
+	 * duration of this call.
+	 */
+	public void nativeEventReceived(NativeEventView view);
+}
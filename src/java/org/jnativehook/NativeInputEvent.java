@@ -29,6 +29,16 @@ import java.util.EventObject;
  * Java before they are delivered natively.
  * <p/>
  *
+ * A {@link NativeEventFilter} is invoked before the event is released to the
+ * native system and may consume it where the native platform supports doing
+ * so.
+ * <p/>
+ *
+ * While {@link GlobalScreen#setEventObjectPooling(boolean)} is enabled, the
+ * same event objects are reused for later native events.  Listeners must not
+ * retain a reference to an event after returning from the listener method.
+ * <p/>
+ *
  * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
  * @version	1.1
  *
@@ -49,6 +59,16 @@ public class NativeInputEvent extends EventObject {
 
 	/** The modifier keys down during event. */
 	private int modifiers;
+
+	/** The <code>System.nanoTime()</code> the native event was captured.
+	 * @since 1.2
+	 */
+	private long captureTime;
+
+	/** The <code>System.nanoTime()</code> the event reached its dispatcher.
+	 * @since 1.2
+	 */
+	private long dispatchTime;
 	
 	/** Flag to prevent native event propagation.
 	 * @since 1.2
@@ -56,6 +76,16 @@ public class NativeInputEvent extends EventObject {
 	@SuppressWarnings("unused")
 	private short reserved;
 
+	/** The reserved flag that prevents native event propagation.
+	 * @since 1.2
+	 */
+	static final short RESERVED_CONSUMED = 0x01;
+
+	/** The native event pool slot of this event or -1 if it is not pooled.
+	 * @since 1.2
+	 */
+	private transient int poolIndex = -1;
+
 	/** The left shift key modifier constant. 
 	 * @since 1.2
 	 */
@@ -163,6 +193,54 @@ public class NativeInputEvent extends EventObject {
 	}
 
 
+	/**
+	 * Returns the high resolution time the native event was captured by the
+	 * native library.  The value uses the same clock as
+	 * <code>System.nanoTime()</code> and is only meaningful relative to other
+	 * values of that clock.
+	 *
+	 * @return the capture time in nanoseconds or 0 if the event was not
+	 * stamped.
+	 * @see GlobalScreen#setEventTimestamps(boolean)
+	 * @since 1.2
+	 */
+	public long getCaptureTime() {
+		return captureTime;
+	}
+
+	/**
+	 * Returns the <code>System.nanoTime()</code> at which the dispatch
+	 * executor started delivering this event to its listeners.
+	 *
+	 * @return the dispatch time in nanoseconds or 0 if the event was not
+	 * stamped.
+	 * @see GlobalScreen#setEventTimestamps(boolean)
+	 * @since 1.2
+	 */
+	public long getDispatchTime() {
+		return dispatchTime;
+	}
+
+	/**
+	 * Sets the capture time of this event.
+	 *
+	 * @param captureTime the capture time in nanoseconds.
+	 * @since 1.2
+	 */
+	void setCaptureTime(long captureTime) {
+		this.captureTime = captureTime;
+	}
+
+	/**
+	 * Sets the dispatch time of this event.
+	 *
+	 * @param dispatchTime the dispatch time in nanoseconds.
+	 * @since 1.2
+	 */
+	void setDispatchTime(long dispatchTime) {
+		this.dispatchTime = dispatchTime;
+	}
+
 	/**
 	 * Gets the modifier flags for this event.
 	 *
@@ -194,10 +272,22 @@ public class NativeInputEvent extends EventObject {
 	 * 
 	 * @since 1.1
 	 */
-	@SuppressWarnings("unused")
-	private void setReserved(short reserved) {
+	void setReserved(short reserved) {
 		this.reserved = reserved;
 	}
+
+	/**
+	 * Returns the native event pool slot of this event.  Pooled events are
+	 * reinitialized by the native library and must be returned to the pool
+	 * once all listeners have finished with them.
+	 *
+	 * @return the pool slot or -1 if the event is not pooled.
+	 * @see GlobalScreen#setEventObjectPooling(boolean)
+	 * @since 1.2
+	 */
+	int getPoolIndex() {
+		return poolIndex;
+	}
 	
 	/**
 	 * Gets a <code>String</code> describing the modifier flags, such as
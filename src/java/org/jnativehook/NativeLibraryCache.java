@@ -0,0 +1,299 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.reflect.Array;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.Arrays;
+import java.util.Iterator;
+import java.util.Set;
+
+/**
+ * Extracts the bundled native library into a cache directory so that it can
+ * be reused by later launches.  Each extracted library is named after the
+ * SHA-1 digest of its content.  A cached copy is only loaded after its
+ * content matches the bundled library.  A new copy is written to a temporary
+ * file in the cache directory and renamed into place.  Concurrent launches
+ * therefore never load a partially written library.
+ * <p/>
+ *
+ * The cache directory is only used if it is a real directory owned by the
+ * current user that neither the group nor other users may write to.
+ * Otherwise another local user could replace the library between its
+ * verification and <code>System.load()</code>.  The ownership check requires
+ * the <code>java.nio.file</code> API, so on older platforms, and whenever the
+ * cache directory is not private, the library is extracted to a private
+ * temporary file instead.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ */
+final class NativeLibraryCache {
+	/** The size of the buffer used to read the library. */
+	private static final int BUFFER_SIZE = 64 * 1024;
+
+	private NativeLibraryCache() {
+		// Static helpers only.
+	}
+
+	/**
+	 * Returns the cache directory for a user and library version below the
+	 * specified base directory.
+	 *
+	 * @param baseDir the base directory, such as <code>java.io.tmpdir</code>.
+	 * @param user the name of the current user.
+	 * @param version the library version.
+	 * @return the user and version specific cache directory.
+	 */
+	static File getCacheDirectory(File baseDir, String user, String version) {
+		// Keep the user and version safe for use as a file name.
+		return new File(baseDir, "jnativehook-"
+				+ user.replaceAll("[^A-Za-z0-9._-]", "_") + "-"
+				+ version.replaceAll("[^A-Za-z0-9._-]", "_"));
+	}
+
+	/**
+	 * Returns a cached copy of the library read from the input stream,
+	 * extracting it first if no valid copy exists.  If the cache directory
+	 * cannot be used safely, the library is extracted to a private temporary
+	 * file in the parent of the cache directory that is deleted on exit.
+	 * The input stream is closed.
+	 *
+	 * @param libInputStream the bundled library.
+	 * @param cacheDir the directory containing cached libraries.
+	 * @param prefix the library file name prefix.
+	 * @param suffix the library file name suffix.
+	 * @return the cached library file.
+	 * @throws IOException if the library could not be read or written.
+	 */
+	static File extract(InputStream libInputStream, File cacheDir, String prefix, String suffix) throws IOException {
+		byte[] library = read(libInputStream);
+		byte[] digest = digest(library);
+
+		File libFile = null;
+		if (cacheDir.mkdirs()) {
+			// Nobody else may add files to a directory created here.
+			setPrivate(cacheDir);
+		}
+
+		File tmpFile = null;
+		try {
+			// The temporary file doubles as a reference for the file owner.
+			tmpFile = File.createTempFile(prefix, ".tmp", cacheDir);
+		}
+		catch (IOException e) {
+			// The cache directory is missing or not writable.
+		}
+
+		if (tmpFile != null) {
+			try {
+				if (isPrivate(cacheDir, tmpFile)) {
+					libFile = new File(cacheDir, prefix + toHex(digest) + suffix);
+					if (!isValid(libFile, library.length, digest)) {
+						// Write a private copy and rename it into place.
+						write(tmpFile, library);
+
+						if (!tmpFile.renameTo(libFile)) {
+							// Another launch may have won the race, or the platform
+							// does not replace an existing file on rename.
+							if (!isValid(libFile, library.length, digest)) {
+								libFile.delete();
+
+								if (!tmpFile.renameTo(libFile)) {
+									throw new IOException("Unable to rename the native library to " + libFile);
+								}
+							}
+						}
+					}
+				}
+			}
+			finally {
+				tmpFile.delete();
+			}
+		}
+
+		if (libFile == null) {
+			libFile = File.createTempFile(prefix, suffix, cacheDir.getParentFile());
+			libFile.deleteOnExit();
+
+			write(libFile, library);
+		}
+
+		return libFile;
+	}
+
+	/**
+	 * Returns true if the directory is a real directory with the same owner
+	 * as the reference file and, where the file system supports POSIX
+	 * permissions, is not writable by the group or other users.  Returns
+	 * false if this cannot be determined on the current platform.
+	 *
+	 * @param dir the directory to check.
+	 * @param ownedFile a file created by the current user.
+	 * @return true if only the current user may modify the directory.
+	 */
+	static boolean isPrivate(File dir, File ownedFile) {
+		boolean secure = false;
+
+		try {
+			Class<?> files = Class.forName("java.nio.file.Files");
+			Class<?> pathClass = Class.forName("java.nio.file.Path");
+			Class<?> optionClass = Class.forName("java.nio.file.LinkOption");
+
+			// Never follow a symbolic link planted in place of the directory.
+			Object options = Array.newInstance(optionClass, 1);
+			Array.set(options, 0, optionClass.getField("NOFOLLOW_LINKS").get(null));
+
+			Method toPath = File.class.getMethod("toPath");
+			Method isDirectory = files.getMethod("isDirectory", pathClass, options.getClass());
+			Method getOwner = files.getMethod("getOwner", pathClass, options.getClass());
+
+			Object path = toPath.invoke(dir);
+			if (Boolean.TRUE.equals(isDirectory.invoke(null, path, options))) {
+				Object owner = getOwner.invoke(null, path, options);
+				secure = owner.equals(getOwner.invoke(null, toPath.invoke(ownedFile), options));
+			}
+
+			if (secure) {
+				Method getPermissions = files.getMethod("getPosixFilePermissions", pathClass, options.getClass());
+
+				try {
+					Iterator<?> permissions = ((Set<?>) getPermissions.invoke(null, path, options)).iterator();
+					while (secure && permissions.hasNext()) {
+						String permission = permissions.next().toString();
+						if (permission.equals("GROUP_WRITE") || permission.equals("OTHERS_WRITE")) {
+							secure = false;
+						}
+					}
+				}
+				catch (InvocationTargetException e) {
+					// Only the owner check applies without POSIX permissions.
+					if (!(e.getCause() instanceof UnsupportedOperationException)) {
+						secure = false;
+					}
+				}
+			}
+		}
+		catch (Exception e) {
+			// The java.nio.file API is not available or the check failed.
+			secure = false;
+		}
+
+		return secure;
+	}
+
+	/**
+	 * Restrict a directory to the current user where the file system supports
+	 * POSIX permissions.  Failures are ignored because
+	 * {@link #isPrivate(File, File)} rejects a directory that is not private.
+	 */
+	private static void setPrivate(File dir) {
+		try {
+			Class<?> files = Class.forName("java.nio.file.Files");
+			Class<?> pathClass = Class.forName("java.nio.file.Path");
+
+			Object permissions = Class.forName("java.nio.file.attribute.PosixFilePermissions")
+					.getMethod("fromString", String.class)
+					.invoke(null, "rwx------");
+
+			files.getMethod("setPosixFilePermissions", pathClass, Set.class)
+					.invoke(null, File.class.getMethod("toPath").invoke(dir), permissions);
+		}
+		catch (Exception e) {
+			// Not supported on this platform.
+		}
+	}
+
+	/**
+	 * Write the library to a file.
+	 */
+	private static void write(File file, byte[] library) throws IOException {
+		FileOutputStream libOutputStream = new FileOutputStream(file);
+		try {
+			libOutputStream.write(library);
+		}
+		finally {
+			libOutputStream.close();
+		}
+	}
+
+	/**
+	 * Returns true if the file has the expected size and content digest.
+	 */
+	static boolean isValid(File libFile, long length, byte[] digest) throws IOException {
+		boolean valid = false;
+
+		if (libFile.isFile() && libFile.length() == length) {
+			valid = Arrays.equals(digest, digest(read(new FileInputStream(libFile))));
+		}
+
+		return valid;
+	}
+
+	/**
+	 * Read and close the stream.
+	 */
+	private static byte[] read(InputStream inputStream) throws IOException {
+		ByteArrayOutputStream outputStream = new ByteArrayOutputStream(BUFFER_SIZE);
+
+		try {
+			byte[] buffer = new byte[BUFFER_SIZE];
+
+			int size;
+			while ((size = inputStream.read(buffer)) != -1) {
+				outputStream.write(buffer, 0, size);
+			}
+		}
+		finally {
+			inputStream.close();
+		}
+
+		return outputStream.toByteArray();
+	}
+
+	private static byte[] digest(byte[] data) throws IOException {
+		try {
+			return MessageDigest.getInstance("SHA-1").digest(data);
+		}
+		catch (NoSuchAlgorithmException e) {
+			// Every Java platform is required to support SHA-1.
+			throw new IOException("Unable to compute the native library digest.");
+		}
+	}
+
+	static String toHex(byte[] data) {
+		StringBuilder hex = new StringBuilder(data.length * 2);
+		for (int i = 0; i < data.length; i++) {
+			hex.append(Character.forDigit((data[i] >> 4) & 0x0F, 16));
+			hex.append(Character.forDigit(data[i] & 0x0F, 16));
+		}
+
+		return hex.toString();
+	}
+}
@@ -0,0 +1,111 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import java.util.EventObject;
+
+/**
+ * An event which indicates that one or more native system settings have
+ * changed.  The event carries the previous and current value of every
+ * setting; use {@link #isChanged(NativeSystem.Setting)} to find the settings
+ * that changed.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeSettingsListener
+ */
+public class NativeSettingsEvent extends EventObject {
+	/** The Constant serialVersionUID. */
+	private static final long serialVersionUID = 2973282631492474618L;
+
+	/** The values before the change, indexed by setting ordinal. */
+	private final long[] previous;
+
+	/** The values after the change, indexed by setting ordinal. */
+	private final long[] current;
+
+	/**
+	 * Instantiates a new native settings event.
+	 *
+	 * @param source the object that was notified of the change.
+	 * @param previous the values before the change, indexed by
+	 * <code>NativeSystem.Setting</code> ordinal.
+	 * @param current the values after the change, indexed by
+	 * <code>NativeSystem.Setting</code> ordinal.
+	 */
+	public NativeSettingsEvent(Object source, long[] previous, long[] current) {
+		super(source);
+
+		this.previous = previous.clone();
+		this.current = current.clone();
+	}
+
+	/**
+	 * Returns true if the specified setting changed.
+	 *
+	 * @param setting the setting to check.
+	 * @return true if the previous and current values differ.
+	 */
+	public boolean isChanged(NativeSystem.Setting setting) {
+		return previous[setting.ordinal()] != current[setting.ordinal()];
+	}
+
+	/**
+	 * Returns the value of the specified setting before the change.
+	 *
+	 * @param setting the setting to return.
+	 * @return the previous value or -1 if it was not available.
+	 */
+	public long getPreviousValue(NativeSystem.Setting setting) {
+		return previous[setting.ordinal()];
+	}
+
+	/**
+	 * Returns the value of the specified setting after the change.
+	 *
+	 * @param setting the setting to return.
+	 * @return the current value or -1 if it is not available.
+	 */
+	public long getValue(NativeSystem.Setting setting) {
+		return current[setting.ordinal()];
+	}
+
+	/**
+	 * Returns a parameter string identifying the changed settings.
+	 *
+	 * @return a string identifying the changed settings.
+	 */
+	public String paramString() {
+		StringBuilder param = new StringBuilder("NATIVE_SETTINGS_CHANGED");
+
+		NativeSystem.Setting[] settings = NativeSystem.Setting.values();
+		for (int i = 0; i < settings.length; i++) {
+			if (isChanged(settings[i])) {
+				param.append(',');
+				param.append(settings[i].name());
+				param.append('=');
+				param.append(current[i]);
+			}
+		}
+
+		return param.toString();
+	}
+}
@@ -0,0 +1,52 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+//Imports
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving notifications when the native
+ * keyboard or pointer settings exposed by <code>NativeSystem</code> change.
+ * <p/>
+ *
+ * The class that is interested in settings changes implements this
+ * interface, and the object created with that class is registered with the
+ * <code>GlobalScreen</code> using the
+ * {@link GlobalScreen#addNativeSettingsListener(NativeSettingsListener)}
+ * method.  The listener is only notified when at least one setting has a
+ * different value.
+ * <p/>
+ *
+ * <b>Note:</b> This listener is invoked on the native settings thread and
+ * should return quickly.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeSettingsEvent
+ */
+public interface NativeSettingsListener extends EventListener {
+	/**
+	 * Invoked when one or more native settings have changed.
+	 *
+	 * @param e the settings event.
+	 */
+	public void nativeSettingsChanged(NativeSettingsEvent e);
+}
@@ -17,16 +17,64 @@
  */
 package org.jnativehook;
 
+//Imports
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicLongArray;
+
 /**
  * A small class to determine the native system's operating system family and
- * architecture. The class is only used to determine which native library to
- * unpack and load at runtime. This class is never used if the native library
- * is load using the <code>java.library.path</code> property.
+ * architecture. The family and architecture are used to determine which
+ * native library to unpack and load at runtime.
+ * <p/>
+ *
+ * This class also provides the native keyboard and pointer settings.  Each
+ * setting is queried from the platform the first time it is read and cached
+ * until the native system reports a settings change.  Reading a setting
+ * loads the native library.
  *
  * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
- * @version	1.1
+ * @version	1.2
  */
 public class NativeSystem {
+	/** The cached value of a setting that has not been queried yet. */
+	private static final long UNKNOWN = Long.MIN_VALUE;
+
+	/** The cached native settings indexed by <code>GlobalScreen.PROPERTY_*</code>. */
+	private static final AtomicLongArray properties = new AtomicLongArray(GlobalScreen.PROPERTY_COUNT);
+
+	/** The number of times a setting was queried from the platform. */
+	private static final AtomicLong queries = new AtomicLong();
+
+	static {
+		invalidateProperties();
+	}
+
+	/**
+	 * The native keyboard and pointer settings reported by
+	 * {@link NativeSettingsEvent}.  The ordinal of each setting matches its
+	 * <code>GlobalScreen.PROPERTY_*</code> index.
+	 *
+	 * @since 1.2
+	 */
+	public enum Setting {
+		/** The keyboard auto repeat rate. */
+		AUTO_REPEAT_RATE,
+
+		/** The keyboard auto repeat delay. */
+		AUTO_REPEAT_DELAY,
+
+		/** The pointer acceleration multiplier. */
+		POINTER_ACCELERATION_MULTIPLIER,
+
+		/** The pointer acceleration threshold. */
+		POINTER_ACCELERATION_THRESHOLD,
+
+		/** The pointer sensitivity. */
+		POINTER_SENSITIVITY,
+
+		/** The multi click interval. */
+		MULTI_CLICK_INTERVAL
+	}
 
 	/**
 	 * The operating system family enum.
@@ -191,4 +239,122 @@ public class NativeSystem {
 
 		return arch;
 	}
+
+	/**
+	 * Returns a cached native setting, querying the platform on first access.
+	 *
+	 * @param property one of the <code>GlobalScreen.PROPERTY_*</code> constants.
+	 * @return the setting or -1 if the platform does not report it.
+	 */
+	private static long getProperty(int property) {
+		long value = properties.get(property);
+
+		if (value == UNKNOWN) {
+			// Concurrent first reads may both query the platform, which is harmless.
+			value = GlobalScreen.getNativeProperty(property);
+			queries.incrementAndGet();
+			properties.compareAndSet(property, UNKNOWN, value);
+		}
+
+		return value;
+	}
+
+	/**
+	 * Discard the cached native settings so that they are queried again.  This
+	 * is called when the native system reports a settings change.
+	 *
+	 * @since 1.2
+	 */
+	static void invalidateProperties() {
+		for (int i = 0; i < properties.length(); i++) {
+			properties.set(i, UNKNOWN);
+		}
+	}
+
+	/**
+	 * Returns the number of times a setting was queried from the platform
+	 * instead of the cache.
+	 *
+	 * @return the number of native setting queries.
+	 * @since 1.2
+	 */
+	static long getPropertyQueries() {
+		return queries.get();
+	}
+
+	/**
+	 * Returns every native setting, querying the platform for any setting
+	 * that is not cached.
+	 *
+	 * @return the settings indexed by <code>GlobalScreen.PROPERTY_*</code>.
+	 * @since 1.2
+	 */
+	static long[] getProperties() {
+		long[] values = new long[properties.length()];
+		for (int i = 0; i < values.length; i++) {
+			values[i] = getProperty(i);
+		}
+
+		return values;
+	}
+
+	/**
+	 * Returns the native keyboard auto repeat rate.
+	 *
+	 * @return the auto repeat rate or -1 if it is not available.
+	 * @since 1.2
+	 */
+	public static long getAutoRepeatRate() {
+		return getProperty(GlobalScreen.PROPERTY_AUTO_REPEAT_RATE);
+	}
+
+	/**
+	 * Returns the native keyboard auto repeat delay.
+	 *
+	 * @return the auto repeat delay or -1 if it is not available.
+	 * @since 1.2
+	 */
+	public static long getAutoRepeatDelay() {
+		return getProperty(GlobalScreen.PROPERTY_AUTO_REPEAT_DELAY);
+	}
+
+	/**
+	 * Returns the native pointer acceleration multiplier.
+	 *
+	 * @return the acceleration multiplier or -1 if it is not available.
+	 * @since 1.2
+	 */
+	public static long getPointerAccelerationMultiplier() {
+		return getProperty(GlobalScreen.PROPERTY_POINTER_ACCELERATION_MULTIPLIER);
+	}
+
+	/**
+	 * Returns the native pointer acceleration threshold.
+	 *
+	 * @return the acceleration threshold or -1 if it is not available.
+	 * @since 1.2
+	 */
+	public static long getPointerAccelerationThreshold() {
+		return getProperty(GlobalScreen.PROPERTY_POINTER_ACCELERATION_THRESHOLD);
+	}
+
+	/**
+	 * Returns the native pointer sensitivity.
+	 *
+	 * @return the pointer sensitivity or -1 if it is not available.
+	 * @since 1.2
+	 */
+	public static long getPointerSensitivity() {
+		return getProperty(GlobalScreen.PROPERTY_POINTER_SENSITIVITY);
+	}
+
+	/**
+	 * Returns the native multi click interval in milliseconds.
+	 *
+	 * @return the multi click interval or -1 if it is not available.
+	 * @since 1.2
+	 */
+	public static long getMultiClickInterval() {
+		return getProperty(GlobalScreen.PROPERTY_MULTI_CLICK_INTERVAL);
+	}
 }
@@ -22,6 +22,7 @@ package org.jnativehook.example;
 import org.jnativehook.GlobalScreen;
 import org.jnativehook.NativeHookException;
 import org.jnativehook.NativeInputEvent;
+import org.jnativehook.NativeSystem;
 import org.jnativehook.keyboard.NativeKeyEvent;
 import org.jnativehook.keyboard.NativeKeyListener;
 import org.jnativehook.mouse.NativeMouseEvent;
@@ -406,14 +407,13 @@ public class NativeHookDemo extends JFrame implements ActionListener, ItemListen
 		//Enable the hook, this will cause the GlobalScreen to be initilized.
 		menuItemEnable.setSelected(true);
 
-		//Please note that these properties are not avaiable until after the
-		//GlobalScreen class is initialized.
-		txtEventInfo.setText("Auto Repeat Rate: " + System.getProperty("jnativehook.autoRepeatRate"));
-		txtEventInfo.append("\n" + "Auto Repeat Delay: " + System.getProperty("jnativehook.autoRepeatDelay"));
-		txtEventInfo.append("\n" + "Double Click Time: " + System.getProperty("jnativehook.multiClickInterval"));
-		txtEventInfo.append("\n" + "Pointer Sensitivity: " + System.getProperty("jnativehook.pointerSensitivity"));
-		txtEventInfo.append("\n" + "Pointer Acceleration Multiplier: " + System.getProperty("jnativehook.pointerAccelerationMultiplier"));
-		txtEventInfo.append("\n" + "Pointer Acceleration Threshold: " + System.getProperty("jnativehook.pointerAccelerationThreshold"));
+		//The native settings are queried the first time they are read.
+		txtEventInfo.setText("Auto Repeat Rate: " + NativeSystem.getAutoRepeatRate());
+		txtEventInfo.append("\n" + "Auto Repeat Delay: " + NativeSystem.getAutoRepeatDelay());
+		txtEventInfo.append("\n" + "Double Click Time: " + NativeSystem.getMultiClickInterval());
+		txtEventInfo.append("\n" + "Pointer Sensitivity: " + NativeSystem.getPointerSensitivity());
+		txtEventInfo.append("\n" + "Pointer Acceleration Multiplier: " + NativeSystem.getPointerAccelerationMultiplier());
+		txtEventInfo.append("\n" + "Pointer Acceleration Threshold: " + NativeSystem.getPointerAccelerationThreshold());
 
 		try {
 			txtEventInfo.setCaretPosition(txtEventInfo.getLineStartOffset(txtEventInfo.getLineCount() - 1));
@@ -0,0 +1,48 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.keyboard;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving global hotkey notifications.
+ * <p/>
+ *
+ * Hotkeys are registered with
+ * {@link GlobalScreen#registerNativeHotkey(int, int, int, int, boolean)} and
+ * matched by the native library without creating a <code>NativeKeyEvent</code>.
+ * Only the id of the matching hotkey is passed to the listener.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see GlobalScreen#addNativeHotkeyListener(NativeHotkeyListener)
+ */
+public interface NativeHotkeyListener extends EventListener {
+	/**
+	 * Invoked when the key combination of a registered hotkey has been
+	 * pressed.
+	 *
+	 * @param id the id the hotkey was registered with.
+	 */
+	public void nativeHotkeyPressed(int id);
+}
@@ -0,0 +1,63 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.keyboard;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving native key events as primitive
+ * values.
+ * <p/>
+ *
+ * The native library calls this listener directly with the values of each
+ * native key pressed and released event, so unlike a
+ * <code>NativeKeyListener</code> no <code>NativeKeyEvent</code> is created.
+ * This makes it suitable for high rate consumers that must not allocate
+ * memory for each event.  The listener is registered with the
+ * <code>GlobalScreen</code> using the
+ * {@link GlobalScreen#addNativeKeyPrimitiveListener(NativeKeyPrimitiveListener)}
+ * method.
+ * <p/>
+ *
+ * <b>Note:</b> This listener is invoked inline on the native hook thread and
+ * must return as quickly as possible.  Key typed events are not delivered
+ * because they carry a character instead of a key code.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeKeyListener
+ */
+public interface NativeKeyPrimitiveListener extends EventListener {
+	/**
+	 * Invoked on the native hook thread when a key has been pressed or
+	 * released.
+	 *
+	 * @param id <code>NATIVE_KEY_PRESSED</code> or
+	 * <code>NATIVE_KEY_RELEASED</code>.
+	 * @param keyCode the virtual key code of the key.
+	 * @param rawCode the native key code of the key.
+	 * @param modifiers the modifier flags of the event.
+	 * @param when the native time the event occurred.
+	 */
+	public void onKey(int id, int keyCode, int rawCode, int modifiers, long when);
+}
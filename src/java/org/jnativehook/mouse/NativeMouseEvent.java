@@ -114,6 +114,12 @@ public class NativeMouseEvent extends NativeInputEvent {
 	 */
 	private int button;
 
+	/**
+	 * The number of native motion or wheel events represented by this event.
+	 * @see #getCoalescedCount()
+	 */
+	private int coalescedCount;
+
 	/** The first number in the range of id's used for native mouse events. */
 	public static final int NATIVE_MOUSE_FIRST		= 2500;
 
@@ -216,12 +222,37 @@ public class NativeMouseEvent extends NativeInputEvent {
 	 * @since 1.1
 	 */
 	public NativeMouseEvent(int id, long when, int modifiers, int x, int y, int clickCount, int button) {
+		this(id, when, modifiers, x, y, clickCount, button, 1);
+	}
+
+	/**
+	 * Instantiates a new <code>NativeMouseEvent</code> object.
+	 *
+	 * @param id an integer that identifies the native event type.
+	 * @param when a long integer that gives the time the event occurred
+	 * @param modifiers a modifier mask describing the modifier keys and mouse
+	 * buttons active for the event.
+	 * <code>NativeInputEvent</code> _MASK modifiers should be used as they are
+	 * not compatible with the extended _DOWN_MASK or the old _MASK
+	 * <code>InputEvent</code> modifiers.
+	 * @param x the x coordinate of the native pointer.
+	 * @param y the y coordinate of the native pointer.
+	 * @param clickCount the number of button clicks associated with this event.
+	 * @param button The mouse buttons that has changed state. NOBUTTON,
+	 * BUTTON1, BUTTON2, BUTTON3, BUTTON5 or BUTTON5.
+	 * @param coalescedCount the number of native motion events represented by
+	 * this event.
+	 *
+	 * @since 1.2
+	 */
+	public NativeMouseEvent(int id, long when, int modifiers, int x, int y, int clickCount, int button, int coalescedCount) {
 		super(GlobalScreen.getInstance(), id, when, modifiers);
 
 		this.x = x;
 		this.y = y;
 		this.clickCount = clickCount;
 		this.button = button;
+		this.coalescedCount = coalescedCount;
 	}
 
 	/**
@@ -250,6 +281,22 @@ public class NativeMouseEvent extends NativeInputEvent {
 		return clickCount;
 	}
 
+	/**
+	 * Returns the number of native mouse motion or wheel events represented
+	 * by this event.  This is always 1 unless mouse motion coalescing or
+	 * mouse wheel accumulation is enabled, in which case this event carries
+	 * the coordinates of the latest of the merged events.
+	 *
+	 * @return An integer indicating the number of merged native events
+	 *
+	 * @see GlobalScreen#setMouseMotionCoalescing(boolean)
+	 * @see GlobalScreen#setMouseWheelAccumulation(int, int)
+	 * @since 1.2
+	 */
+	public int getCoalescedCount() {
+		return coalescedCount;
+	}
+
 	/**
 	 * Returns the x,y position of the native event.
 	 *
@@ -338,6 +385,11 @@ public class NativeMouseEvent extends NativeInputEvent {
 		param.append(",clickCount=");
 		param.append(getClickCount());
 
+		if (coalescedCount > 1) {
+			param.append(",coalescedCount=");
+			param.append(coalescedCount);
+		}
+
 		return param.toString();
 	}
 }
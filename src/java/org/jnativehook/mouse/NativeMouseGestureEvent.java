@@ -0,0 +1,214 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.mouse;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+
+/**
+ * An event which indicates that a mouse gesture was recognized by the native
+ * library.  Gestures are assembled from the raw native mouse events on the
+ * native hook thread, so a listener only receives one event per drag, multi
+ * click or wheel burst instead of every native event that produced it.
+ * <p/>
+ *
+ * A <code>NativeMouseGestureEvent</code> object is passed to every
+ * <code>NativeMouseGestureListener</code> object which is registered to
+ * receive mouse gestures using the
+ * {@link GlobalScreen#addNativeMouseGestureListener(NativeMouseGestureListener)}
+ * method.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see GlobalScreen
+ * @see NativeMouseGestureListener
+ */
+public class NativeMouseGestureEvent extends NativeMouseEvent {
+	/** The Constant serialVersionUID. */
+	private static final long serialVersionUID = 4129097239376209282L;
+
+	/** The first number in the range of id's used for native mouse gestures. */
+	public static final int NATIVE_MOUSE_GESTURE_FIRST	= 2510;
+
+	/** The last number in the range of id's used for native mouse gestures. */
+	public static final int NATIVE_MOUSE_GESTURE_LAST	= 2513;
+
+	/**
+	 * The native drag started gesture.  This event is generated when the
+	 * pointer moves a few pixels while a button is held.  The coordinates are
+	 * those of the button press.
+	 */
+	public static final int NATIVE_MOUSE_DRAG_STARTED	= NATIVE_MOUSE_GESTURE_FIRST;
+
+	/**
+	 * The native drag ended gesture.  This event is generated when the button
+	 * of an active drag is released.  The coordinates are those of the
+	 * button release.
+	 */
+	public static final int NATIVE_MOUSE_DRAG_ENDED		= 1 + NATIVE_MOUSE_GESTURE_FIRST;
+
+	/**
+	 * The native multi click gesture.  This event is generated for the second
+	 * and each later click of the same button within the native multi click
+	 * interval.
+	 */
+	public static final int NATIVE_MOUSE_MULTI_CLICKED	= 2 + NATIVE_MOUSE_GESTURE_FIRST;
+
+	/**
+	 * The native wheel burst gesture.  This event is generated when a run of
+	 * wheel events in the same direction ends.
+	 */
+	public static final int NATIVE_MOUSE_WHEEL_BURST	= 3 + NATIVE_MOUSE_GESTURE_FIRST;
+
+	/** The horizontal distance covered by a drag gesture. */
+	private int deltaX;
+
+	/** The vertical distance covered by a drag gesture. */
+	private int deltaY;
+
+	/** The total wheel rotation of a wheel burst gesture. */
+	private int wheelRotation;
+
+	/**
+	 * Instantiates a new <code>NativeMouseGestureEvent</code> object.
+	 *
+	 * @param id an integer that identifies the native gesture type.
+	 * @param when a long integer that gives the time the gesture completed.
+	 * @param modifiers a modifier mask describing the modifier keys and mouse
+	 * buttons active for the event.
+	 * @param x the x coordinate of the native pointer.
+	 * @param y the y coordinate of the native pointer.
+	 * @param clickCount the number of clicks of a multi click gesture, or the
+	 * number of wheel events of a wheel burst.
+	 * @param button the mouse button of a drag or multi click gesture.
+	 * @param deltaX the horizontal distance covered by a drag gesture.
+	 * @param deltaY the vertical distance covered by a drag gesture.
+	 * @param wheelRotation the total rotation of a wheel burst gesture in
+	 * scroll units.
+	 */
+	public NativeMouseGestureEvent(int id, long when, int modifiers, int x, int y, int clickCount, int button, int deltaX, int deltaY, int wheelRotation) {
+		super(id, when, modifiers, x, y, clickCount, button);
+
+		this.deltaX = deltaX;
+		this.deltaY = deltaY;
+		this.wheelRotation = wheelRotation;
+	}
+
+	/**
+	 * Returns the horizontal distance the pointer moved since the button was
+	 * pressed.  Only valid for drag gestures.
+	 *
+	 * @return the horizontal distance in pixels
+	 */
+	public int getDeltaX() {
+		return deltaX;
+	}
+
+	/**
+	 * Returns the vertical distance the pointer moved since the button was
+	 * pressed.  Only valid for drag gestures.
+	 *
+	 * @return the vertical distance in pixels
+	 */
+	public int getDeltaY() {
+		return deltaY;
+	}
+
+	/**
+	 * Returns the summed rotation of every wheel event in the burst,
+	 * multiplied by the native scroll amount.  Only valid for wheel burst
+	 * gestures.
+	 *
+	 * @return negative values if the mouse wheel was rotated up/away from
+	 * the user, and positive values if the mouse wheel was rotated down/
+	 * towards the user.
+	 */
+	public int getWheelRotation() {
+		return wheelRotation;
+	}
+
+	/**
+	 * Returns a parameter string identifying the native gesture.
+	 * This method is useful for event-logging and debugging.
+	 *
+	 * @return a string identifying the native gesture and its attributes.
+	 */
+	@Override
+	public String paramString() {
+		StringBuilder param = new StringBuilder(255);
+
+		switch(getID()) {
+			case NATIVE_MOUSE_DRAG_STARTED:
+				param.append("NATIVE_MOUSE_DRAG_STARTED");
+				break;
+
+			case NATIVE_MOUSE_DRAG_ENDED:
+				param.append("NATIVE_MOUSE_DRAG_ENDED");
+				break;
+
+			case NATIVE_MOUSE_MULTI_CLICKED:
+				param.append("NATIVE_MOUSE_MULTI_CLICKED");
+				break;
+
+			case NATIVE_MOUSE_WHEEL_BURST:
+				param.append("NATIVE_MOUSE_WHEEL_BURST");
+				break;
+
+			default:
+				param.append("unknown type");
+				break;
+		}
+
+		param.append(",(");
+		param.append(getX());
+		param.append(',');
+		param.append(getY());
+		param.append("),");
+
+		param.append("button=");
+		param.append(getButton());
+
+		if (getModifiers() != 0) {
+			param.append(",modifiers=");
+			param.append(getModifiersText(getModifiers()));
+		}
+
+		param.append(",clickCount=");
+		param.append(getClickCount());
+
+		switch(getID()) {
+			case NATIVE_MOUSE_DRAG_STARTED:
+			case NATIVE_MOUSE_DRAG_ENDED:
+				param.append(",delta=(");
+				param.append(deltaX);
+				param.append(',');
+				param.append(deltaY);
+				param.append(')');
+				break;
+
+			case NATIVE_MOUSE_WHEEL_BURST:
+				param.append(",wheelRotation=");
+				param.append(wheelRotation);
+				break;
+		}
+
+		return param.toString();
+	}
+}
@@ -0,0 +1,70 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.mouse;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving native mouse gestures.
+ * <p>
+ * The class that is interested in processing a
+ * <code>NativeMouseGestureEvent</code> implements this interface, and the
+ * object created with that class is registered with the
+ * <code>GlobalScreen</code> using the
+ * {@link GlobalScreen#addNativeMouseGestureListener(NativeMouseGestureListener)}
+ * method.  Gesture listeners do not require a <code>NativeMouseListener</code>
+ * or <code>NativeMouseWheelListener</code>; the raw events are only passed to
+ * Java if such a listener is also registered.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeMouseGestureEvent
+ */
+public interface NativeMouseGestureListener extends EventListener {
+	/**
+	 * Invoked when the pointer starts moving while a button is held.
+	 *
+	 * @param e the native mouse gesture event.
+	 */
+	public void nativeMouseDragStarted(NativeMouseGestureEvent e);
+
+	/**
+	 * Invoked when the button of an active drag is released.
+	 *
+	 * @param e the native mouse gesture event.
+	 */
+	public void nativeMouseDragEnded(NativeMouseGestureEvent e);
+
+	/**
+	 * Invoked for the second and each later click of a multi click.
+	 *
+	 * @param e the native mouse gesture event.
+	 */
+	public void nativeMouseMultiClicked(NativeMouseGestureEvent e);
+
+	/**
+	 * Invoked when a run of wheel events in the same direction ends.
+	 *
+	 * @param e the native mouse gesture event.
+	 */
+	public void nativeMouseWheelBurst(NativeMouseGestureEvent e);
+}
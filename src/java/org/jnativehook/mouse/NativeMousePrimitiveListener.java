@@ -0,0 +1,66 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.mouse;
+
+//Imports
+import org.jnativehook.GlobalScreen;
+
+import java.util.EventListener;
+
+/**
+ * The listener interface for receiving native mouse button and motion events
+ * as primitive values.
+ * <p/>
+ *
+ * The native library calls this listener directly with the values of each
+ * native mouse clicked, pressed, released, moved and dragged event, so
+ * unlike a <code>NativeMouseListener</code> or
+ * <code>NativeMouseMotionListener</code> no <code>NativeMouseEvent</code> is
+ * created.  This makes it suitable for high rate consumers that must not
+ * allocate memory for each event.  The listener is registered with the
+ * <code>GlobalScreen</code> using the
+ * {@link GlobalScreen#addNativeMousePrimitiveListener(NativeMousePrimitiveListener)}
+ * method.
+ * <p/>
+ *
+ * <b>Note:</b> This listener is invoked inline on the native hook thread and
+ * must return as quickly as possible.  Every native motion event is
+ * delivered, even while mouse motion coalescing is enabled.
+ *
+ * @author	Alexander Barker (<a href="mailto:alex@1stleg.com">alex@1stleg.com</a>)
+ * @version	1.2
+ * @since	1.2
+ *
+ * @see NativeMouseListener
+ * @see NativeMouseMotionListener
+ */
+public interface NativeMousePrimitiveListener extends EventListener {
+	/**
+	 * Invoked on the native hook thread when a mouse button changed state or
+	 * the mouse moved.
+	 *
+	 * @param id the <code>NativeMouseEvent</code> event type.
+	 * @param x the x coordinate of the native pointer.
+	 * @param y the y coordinate of the native pointer.
+	 * @param button the mouse button that changed state, or
+	 * <code>NOBUTTON</code>.
+	 * @param modifiers the modifier flags of the event.
+	 * @param when the native time the event occurred.
+	 */
+	public void onMouse(int id, int x, int y, int button, int modifiers, long when);
+}
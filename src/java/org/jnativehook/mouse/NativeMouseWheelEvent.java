@@ -125,6 +125,35 @@ public class NativeMouseWheelEvent extends NativeMouseEvent {
 		this.wheelRotation = wheelRotation;
 	}
 
+	/**
+	 * Instantiates a new <code>NativeMouseWheelEvent</code> object that
+	 * represents several merged native wheel events.
+	 *
+	 * @param id an integer that identifies the native event type.
+	 * @param when a long integer that gives the time the event occurred
+	 * @param modifiers a modifier mask describing the modifier keys and mouse
+	 * buttons active for the event.
+	 * @param x the x coordinate of the native pointer.
+	 * @param y the y coordinate of the native pointer.
+	 * @param clickCount the number of button clicks associated with this event.
+	 * @param scrollType the type of scrolling which should take place in
+	 * response to this event.
+	 * @param scrollAmount for scrollType <code>WHEEL_UNIT_SCROLL</code>, the
+	 * number of units to be scrolled.
+	 * @param wheelRotation the summed rotation of the merged events.
+	 * @param coalescedCount the number of native wheel events represented by
+	 * this event.
+	 *
+	 * @since 1.2
+	 */
+	public NativeMouseWheelEvent(int id, long when, int modifiers, int x, int y, int clickCount, int scrollType, int scrollAmount, int wheelRotation, int coalescedCount) {
+		super(id, when, modifiers, x, y, clickCount, NOBUTTON, coalescedCount);
+
+		this.scrollType = scrollType;
+		this.scrollAmount = scrollAmount;
+		this.wheelRotation = wheelRotation;
+	}
+
     /**
      * Returns the number of units that should be scrolled per
      * click of mouse wheel rotation.
@@ -0,0 +1,99 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Native side of the org.jnativehook.bench.NativeDispatchBenchmark and
+ * org.jnativehook.soak.NativeEventSoak drivers.  This file is only compiled
+ * into the library by the bench and soak targets, which define USE_BENCHMARK.
+ */
+#ifdef USE_BENCHMARK
+
+#include <jni.h>
+#include <stdint.h>
+#include <string.h>
+#include <uiohook.h>
+
+#include "jni_Converter.h"
+#include "jni_Errors.h"
+#include "jni_EventDispathcer.h"
+#include "jni_Globals.h"
+#include "jni_Statistics.h"
+
+/* Call jni_EventDispatcher() count times with a synthetic native event of the
+ * specified Java event type on the calling thread, bypassing the platform
+ * hook.  Returns the elapsed time in nanoseconds.
+ */
+static jlong jni_DispatchSyntheticEvents(JNIEnv *env, jint id, jint count) {
+	jlong elapsed = 0;
+
+	virtual_event event;
+	memset(&event, 0, sizeof(event));
+
+	if (jni_ConvertToNativeType(id, &event.type) != JNI_OK || count < 0) {
+		ThrowException(java_lang_IllegalArgumentException, "Unsupported benchmark event type or count.");
+	}
+	else if (jni_CreateGlobalScreenObject(env) == JNI_OK) {
+		switch (jni_GetEventClass(event.type)) {
+			case EVENT_CLASS_KEY:
+				event.data.keyboard.keycode = VC_A;
+				event.data.keyboard.rawcode = 0x41;
+				event.data.keyboard.keychar = event.type == EVENT_KEY_TYPED ? 'a' : CHAR_UNDEFINED;
+				break;
+
+			case EVENT_CLASS_MOUSE:
+				event.data.mouse.button = MOUSE_BUTTON1;
+				event.data.mouse.clicks = 1;
+				break;
+
+			case EVENT_CLASS_MOUSE_WHEEL:
+				event.data.wheel.type = WHEEL_UNIT_SCROLL;
+				event.data.wheel.amount = 3;
+				event.data.wheel.rotation = 1;
+				break;
+		}
+
+		uint64_t start = jni_GetNanoTime();
+
+		jint i;
+		for (i = 0; i < count; i++) {
+			// Vary the event so that nothing can be cached between iterations.
+			event.time++;
+			event.reserved = 0x00;
+			if (jni_GetEventClass(event.type) == EVENT_CLASS_MOUSE_MOTION) {
+				event.data.mouse.x = (int16_t) (i & 0x03FF);
+				event.data.mouse.y = (int16_t) ((i >> 10) & 0x03FF);
+			}
+
+			jni_EventDispatcher(&event);
+		}
+
+		elapsed = (jlong) (jni_GetNanoTime() - start);
+	}
+
+	return elapsed;
+}
+
+JNIEXPORT jlong JNICALL Java_org_jnativehook_bench_NativeDispatchBenchmark_dispatchNativeEvents(JNIEnv *env, jclass cls, jint id, jint count) {
+	return jni_DispatchSyntheticEvents(env, id, count);
+}
+
+// The soak harness drives the same synthetic events for hours at a time.
+JNIEXPORT jlong JNICALL Java_org_jnativehook_soak_NativeEventSoak_dispatchNativeEvents(JNIEnv *env, jclass cls, jint id, jint count) {
+	return jni_DispatchSyntheticEvents(env, id, count);
+}
+
+#endif
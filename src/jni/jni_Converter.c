@@ -17,6 +17,7 @@
  */
 
 #include <jni.h>
+#include <stdint.h>
 #include <uiohook.h>
 
 #include "jni_Converter.h"
@@ -25,88 +26,126 @@
 #include "org_jnativehook_mouse_NativeMouseEvent.h"
 #include "org_jnativehook_mouse_NativeMouseWheelEvent.h"
 
+// The Java event ids are looked up relative to the first key event id.
+#define JAVA_TYPE_FIRST		org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_FIRST
+#define JAVA_TYPE_LAST		org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_LAST
+
+#if org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_FIRST <= org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_LAST
+#error "NativeMouseEvent ids must follow the NativeKeyEvent ids"
+#endif
+
+#if org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD > 0xFF
+#error "NativeKeyEvent locations must fit in the location table"
+#endif
+
+// Native event type to Java event id and event class.
+static const struct {
+	jint type;
+	uint8_t event_class;
+} java_types[EVENT_TYPE_COUNT] = {
+	[EVENT_KEY_TYPED]		= { org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_TYPED,		EVENT_CLASS_KEY },
+	[EVENT_KEY_PRESSED]		= { org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_PRESSED,		EVENT_CLASS_KEY },
+	[EVENT_KEY_RELEASED]	= { org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_RELEASED,	EVENT_CLASS_KEY },
+	[EVENT_MOUSE_CLICKED]	= { org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_CLICKED,	EVENT_CLASS_MOUSE },
+	[EVENT_MOUSE_PRESSED]	= { org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_PRESSED,	EVENT_CLASS_MOUSE },
+	[EVENT_MOUSE_RELEASED]	= { org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_RELEASED,	EVENT_CLASS_MOUSE },
+	[EVENT_MOUSE_MOVED]		= { org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_MOVED,		EVENT_CLASS_MOUSE_MOTION },
+	[EVENT_MOUSE_DRAGGED]	= { org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_DRAGGED,	EVENT_CLASS_MOUSE_MOTION },
+	[EVENT_MOUSE_WHEEL]		= { org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_WHEEL,		EVENT_CLASS_MOUSE_WHEEL }
+};
+
+// Java event id, relative to JAVA_TYPE_FIRST, to native event type.
+static const event_type native_types[JAVA_TYPE_LAST - JAVA_TYPE_FIRST + 1] = {
+	[org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_TYPED - JAVA_TYPE_FIRST]		= EVENT_KEY_TYPED,
+	[org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_PRESSED - JAVA_TYPE_FIRST]		= EVENT_KEY_PRESSED,
+	[org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_RELEASED - JAVA_TYPE_FIRST]		= EVENT_KEY_RELEASED,
+	[org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_CLICKED - JAVA_TYPE_FIRST]		= EVENT_MOUSE_CLICKED,
+	[org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_PRESSED - JAVA_TYPE_FIRST]		= EVENT_MOUSE_PRESSED,
+	[org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_RELEASED - JAVA_TYPE_FIRST]	= EVENT_MOUSE_RELEASED,
+	[org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_MOVED - JAVA_TYPE_FIRST]		= EVENT_MOUSE_MOVED,
+	[org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_DRAGGED - JAVA_TYPE_FIRST]		= EVENT_MOUSE_DRAGGED,
+	[org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_WHEEL - JAVA_TYPE_FIRST]		= EVENT_MOUSE_WHEEL
+};
+
+/* Virtual key code to Java key location.  The entries are stored relative to
+ * LOCATION_STANDARD so that the implicit zero entries of every other key code
+ * map to the standard location.
+ */
+#define LOCATION_ENTRY(location)	((location) ^ org_jnativehook_keyboard_NativeKeyEvent_LOCATION_STANDARD)
+
+static const uint8_t java_locations[0x10000] = {
+	[VC_SHIFT_L]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_LEFT),
+	[VC_CONTROL_L]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_LEFT),
+	[VC_ALT_L]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_LEFT),
+	[VC_META_L]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_LEFT),
+
+	[VC_SHIFT_R]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_RIGHT),
+	[VC_CONTROL_R]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_RIGHT),
+	[VC_ALT_R]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_RIGHT),
+	[VC_META_R]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_RIGHT),
+
+	[VC_KP_0]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_1]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_2]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_3]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_4]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_5]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_6]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_7]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_8]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_9]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+
+	[VC_NUM_LOCK]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_ENTER]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_MULTIPLY]	= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_ADD]			= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_SEPARATOR]	= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_SUBTRACT]	= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD),
+	[VC_KP_DIVIDE]		= LOCATION_ENTRY(org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD)
+};
 
 jint jni_ConvertToJavaType(event_type nativeType, jint *javaType) {
-	jint status = JNI_OK;
+	jint status = JNI_ERR;
 
-	if (nativeType < EVENT_MOUSE_PRESSED) {
-		*javaType = org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_FIRST + (nativeType - 1);
-	}
-	else if (nativeType <= EVENT_MOUSE_WHEEL) {
-		*javaType = org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_FIRST + (nativeType - 1);
+	if ((unsigned int) nativeType < EVENT_TYPE_COUNT && java_types[nativeType].type != 0) {
+		*javaType = java_types[nativeType].type;
+		status = JNI_OK;
 	}
 	else {
 		*javaType = 0;
-		status = JNI_ERR;
 	}
 
 	return status;
 }
 
-
 jint jni_ConvertToNativeType(jint javaType, event_type *nativeType) {
-	jint status = JNI_OK;
+	jint status = JNI_ERR;
 
-	if (javaType < org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_FIRST) {
-		*nativeType = (javaType - 1) - org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_FIRST;
-	}
-	else if (javaType <= org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_LAST) {
-		*nativeType = (javaType - 1) -
-				org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_FIRST + 
-				(org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_LAST - 
-				org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_FIRST);
+	// The unsigned comparison also rejects ids below JAVA_TYPE_FIRST.
+	if ((unsigned int) (javaType - JAVA_TYPE_FIRST) <= JAVA_TYPE_LAST - JAVA_TYPE_FIRST
+			&& native_types[javaType - JAVA_TYPE_FIRST] != 0) {
+		*nativeType = native_types[javaType - JAVA_TYPE_FIRST];
+		status = JNI_OK;
 	}
 	else {
 		*nativeType = 0;
-		status = JNI_ERR;
 	}
 
 	return status;
 }
 
 jint jni_ConvertToJavaLocation(unsigned short int nativeKeyCode, jint *javaKeyLocation) {
-	jint status = JNI_OK;
-
-	switch (nativeKeyCode) {
-		case VC_SHIFT_L:
-		case VC_CONTROL_L:
-		case VC_ALT_L:
-		case VC_META_L:
-			*javaKeyLocation = org_jnativehook_keyboard_NativeKeyEvent_LOCATION_LEFT;
-			break;
-
-		case VC_SHIFT_R:
-		case VC_CONTROL_R:
-		case VC_ALT_R:
-		case VC_META_R:
-			*javaKeyLocation = org_jnativehook_keyboard_NativeKeyEvent_LOCATION_RIGHT;
-			break;
-
-		case VC_KP_0:
-		case VC_KP_1:
-		case VC_KP_2:
-		case VC_KP_3:
-		case VC_KP_4:
-		case VC_KP_5:
-		case VC_KP_6:
-		case VC_KP_7:
-		case VC_KP_8:
-		case VC_KP_9:
-
-		case VC_NUM_LOCK:
-		case VC_KP_ENTER:
-		case VC_KP_MULTIPLY:
-		case VC_KP_ADD:
-		case VC_KP_SEPARATOR:
-		case VC_KP_SUBTRACT:
-		case VC_KP_DIVIDE:
-			*javaKeyLocation = org_jnativehook_keyboard_NativeKeyEvent_LOCATION_NUMPAD;
-			break;
-
-		default:
-			*javaKeyLocation = org_jnativehook_keyboard_NativeKeyEvent_LOCATION_STANDARD;
-			break;
+	*javaKeyLocation = java_locations[nativeKeyCode] ^ org_jnativehook_keyboard_NativeKeyEvent_LOCATION_STANDARD;
+
+	return JNI_OK;
+}
+
+uint8_t jni_GetEventClass(event_type nativeType) {
+	uint8_t event_class = EVENT_CLASS_NONE;
+
+	if ((unsigned int) nativeType < EVENT_TYPE_COUNT) {
+		event_class = java_types[nativeType].event_class;
 	}
 
-	return status;
+	return event_class;
 }
@@ -20,12 +20,30 @@
 #define _Included_jni_Converter_h
 
 #include <jni.h>
+#include <stdint.h>
 #include <uiohook.h>
 
+// The size of the tables indexed by native event type.
+#define EVENT_TYPE_COUNT			(EVENT_MOUSE_WHEEL + 1)
+
+// The Java class used for each native event type.
+#define EVENT_CLASS_NONE			0
+#define EVENT_CLASS_KEY				1
+#define EVENT_CLASS_MOUSE			2
+#define EVENT_CLASS_MOUSE_MOTION	3
+#define EVENT_CLASS_MOUSE_WHEEL		4
+
+/* The conversion functions below are constant table lookups.  The tables are
+ * built from the javah headers in src/jni/include and uiohook.h with
+ * designated initializers, so a constant outside of a table fails to compile.
+ */
 extern jint jni_ConvertToJavaType(event_type nativeType, jint *javaType);
 
 extern jint jni_ConvertToNativeType(jint javaType, event_type *nativeType);
 
 extern jint jni_ConvertToJavaLocation(unsigned short int nativeKeyCode, jint *javaKeyLocation);
 
+// Returns the EVENT_CLASS_* of a native event type.
+extern uint8_t jni_GetEventClass(event_type nativeType);
+
 #endif
@@ -20,9 +20,12 @@
 #define _Included_jni_Errors_h
 
 // Exception class definitions.
+#define java_lang_IllegalArgumentException	"java/lang/IllegalArgumentException"
 #define java_lang_InternalError				"java/lang/InternalError"
 #define java_lang_OutOfMemoryError			"java/lang/OutOfMemoryError"
 #define java_lang_NoClassDefFoundError		"java/lang/NoClassDefFoundError"
+#define java_lang_NullPointerException		"java/lang/NullPointerException"
+#define java_io_IOException					"java/io/IOException"
 
 #define org_jnativehook_NativeHookException	"org/jnativehook/NativeHookException"
 
@@ -0,0 +1,467 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <uiohook.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "jni_EventCapture.h"
+#include "jni_Logger.h"
+
+// The capture file grows by at least this many bytes at a time.
+#define EVENT_CAPTURE_CHUNK		(1 << 20)
+
+static volatile bool capture_enabled = false;
+
+/* The mapping is only replaced by the hook thread while it holds this lock.
+ * Starting and stopping a capture only swaps the state under the lock and
+ * performs the file operations outside of it.
+ */
+static volatile bool capture_lock = false;
+
+static uint8_t *capture_map = NULL;
+static uint64_t capture_capacity = 0;
+static uint64_t capture_length = 0;
+
+// The delta encoding baseline of the active capture.
+static capture_state capture;
+
+#ifdef _WIN32
+static HANDLE capture_file = INVALID_HANDLE_VALUE;
+static HANDLE capture_mapping = NULL;
+#else
+static int capture_file = -1;
+#endif
+
+static inline void jni_LockCapture() {
+	while (__atomic_test_and_set(&capture_lock, __ATOMIC_ACQUIRE)) {
+		// Spin, the lock is only contended while a capture starts or stops.
+	}
+}
+
+static inline void jni_UnlockCapture() {
+	__atomic_clear(&capture_lock, __ATOMIC_RELEASE);
+}
+
+static inline size_t jni_PutVarint(uint8_t *out, uint64_t value) {
+	size_t size = 0;
+
+	while (value >= 0x80) {
+		out[size++] = (uint8_t) (value | 0x80);
+		value >>= 7;
+	}
+	out[size++] = (uint8_t) value;
+
+	return size;
+}
+
+static inline uint64_t jni_ZigZag(int64_t value) {
+	return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+static inline size_t jni_PutCoordinate(uint8_t *out, int16_t value, int16_t *previous) {
+	int64_t encoded = value;
+	if (capture.flags & EVENT_CAPTURE_DELTA) {
+		encoded -= *previous;
+	}
+	*previous = value;
+
+	return jni_PutVarint(out, jni_ZigZag(encoded));
+}
+
+// Read a varint and return its size, or zero if it is truncated.
+static inline size_t jni_GetVarint(const uint8_t *in, size_t size, uint64_t *value) {
+	size_t count = 0;
+	unsigned int shift = 0;
+	bool complete = false;
+
+	*value = 0;
+	while (!complete && count < size && shift < 64) {
+		uint8_t byte = in[count++];
+		*value |= (uint64_t) (byte & 0x7F) << shift;
+
+		complete = (byte & 0x80) == 0;
+		shift += 7;
+	}
+
+	return complete ? count : 0;
+}
+
+static inline int64_t jni_UnZigZag(uint64_t value) {
+	return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+static inline int16_t jni_GetCoordinate(uint64_t value, const capture_state *state, int16_t previous) {
+	int64_t decoded = jni_UnZigZag(value);
+	if (state->flags & EVENT_CAPTURE_DELTA) {
+		decoded += previous;
+	}
+
+	return (int16_t) decoded;
+}
+
+// Encode the record payload and return its size, or zero for unknown events.
+static size_t jni_EncodeEvent(virtual_event * const event, uint8_t *out) {
+	size_t size = 0;
+	uint64_t previous_time = capture.time;
+
+	out[size++] = (uint8_t) event->type;
+	size += jni_PutVarint(out + size, event->mask);
+
+	if (capture.flags & EVENT_CAPTURE_DELTA) {
+		size += jni_PutVarint(out + size, jni_ZigZag((int64_t) (event->time - capture.time)));
+	}
+	else {
+		size += jni_PutVarint(out + size, event->time);
+	}
+	capture.time = event->time;
+
+	switch (event->type) {
+		case EVENT_KEY_TYPED:
+			size += jni_PutVarint(out + size, event->data.keyboard.keychar);
+			size += jni_PutVarint(out + size, event->data.keyboard.rawcode);
+			break;
+
+		case EVENT_KEY_PRESSED:
+		case EVENT_KEY_RELEASED:
+			size += jni_PutVarint(out + size, event->data.keyboard.keycode);
+			size += jni_PutVarint(out + size, event->data.keyboard.rawcode);
+			break;
+
+		case EVENT_MOUSE_CLICKED:
+		case EVENT_MOUSE_PRESSED:
+		case EVENT_MOUSE_RELEASED:
+		case EVENT_MOUSE_MOVED:
+		case EVENT_MOUSE_DRAGGED:
+			size += jni_PutCoordinate(out + size, event->data.mouse.x, &capture.x);
+			size += jni_PutCoordinate(out + size, event->data.mouse.y, &capture.y);
+			size += jni_PutVarint(out + size, event->data.mouse.button);
+			size += jni_PutVarint(out + size, event->data.mouse.clicks);
+			break;
+
+		case EVENT_MOUSE_WHEEL:
+			size += jni_PutCoordinate(out + size, event->data.wheel.x, &capture.x);
+			size += jni_PutCoordinate(out + size, event->data.wheel.y, &capture.y);
+			size += jni_PutVarint(out + size, event->data.wheel.clicks);
+			size += jni_PutVarint(out + size, event->data.wheel.type);
+			size += jni_PutVarint(out + size, event->data.wheel.amount);
+			size += jni_PutVarint(out + size, jni_ZigZag(event->data.wheel.rotation));
+			break;
+
+		default:
+			// Nothing is written so the delta baseline must not move.
+			capture.time = previous_time;
+			size = 0;
+			break;
+	}
+
+	return size;
+}
+
+// Map the first capacity bytes of the capture file, growing it if required.
+static uint8_t * jni_MapCaptureFile(uint64_t capacity) {
+	uint8_t *map = NULL;
+
+	#ifdef _WIN32
+	capture_mapping = CreateFileMapping(capture_file, NULL, PAGE_READWRITE,
+			(DWORD) (capacity >> 32), (DWORD) capacity, NULL);
+	if (capture_mapping != NULL) {
+		map = (uint8_t *) MapViewOfFile(capture_mapping, FILE_MAP_WRITE, 0, 0, (SIZE_T) capacity);
+		if (map == NULL) {
+			CloseHandle(capture_mapping);
+			capture_mapping = NULL;
+		}
+	}
+	#else
+	if (ftruncate(capture_file, (off_t) capacity) == 0) {
+		void *address = mmap(NULL, (size_t) capacity, PROT_READ | PROT_WRITE, MAP_SHARED, capture_file, 0);
+		if (address != MAP_FAILED) {
+			map = (uint8_t *) address;
+		}
+	}
+	#endif
+
+	return map;
+}
+
+static void jni_UnmapCaptureFile(uint8_t *map, uint64_t capacity) {
+	#ifdef _WIN32
+	UnmapViewOfFile(map);
+	CloseHandle(capture_mapping);
+	capture_mapping = NULL;
+	#else
+	munmap(map, (size_t) capacity);
+	#endif
+}
+
+// Trim the capture file to the bytes written and close it.
+static void jni_CloseCaptureFile(uint64_t length) {
+	#ifdef _WIN32
+	LARGE_INTEGER size;
+	size.QuadPart = (LONGLONG) length;
+	if (SetFilePointerEx(capture_file, size, NULL, FILE_BEGIN)) {
+		SetEndOfFile(capture_file);
+	}
+	CloseHandle(capture_file);
+	capture_file = INVALID_HANDLE_VALUE;
+	#else
+	if (ftruncate(capture_file, (off_t) length) != 0) {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Failed to trim the capture file!\n",
+				__FUNCTION__, __LINE__);
+	}
+	close(capture_file);
+	capture_file = -1;
+	#endif
+}
+
+bool jni_StartEventCapture(const char *path, uint8_t flags) {
+	bool status = false;
+
+	// Only one capture may be active at a time.
+	if (!__atomic_exchange_n(&capture_enabled, true, __ATOMIC_SEQ_CST)) {
+		#ifdef _WIN32
+		capture_file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+				CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		bool opened = capture_file != INVALID_HANDLE_VALUE;
+		#else
+		capture_file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		bool opened = capture_file >= 0;
+		#endif
+
+		if (opened) {
+			uint8_t *map = jni_MapCaptureFile(EVENT_CAPTURE_CHUNK);
+			if (map != NULL) {
+				memcpy(map, EVENT_CAPTURE_MAGIC, 4);
+				map[4] = EVENT_CAPTURE_VERSION;
+				map[5] = flags;
+				map[6] = 0x00;
+				map[7] = 0x00;
+
+				jni_LockCapture();
+				capture_map = map;
+				capture_capacity = EVENT_CAPTURE_CHUNK;
+				capture_length = EVENT_CAPTURE_HEADER_SIZE;
+				capture.flags = flags;
+				capture.time = 0;
+				capture.x = 0;
+				capture.y = 0;
+				jni_UnlockCapture();
+
+				status = true;
+			}
+			else {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to map the capture file!\n",
+						__FUNCTION__, __LINE__);
+
+				jni_CloseCaptureFile(0);
+			}
+		}
+		else {
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to create the capture file!\n",
+					__FUNCTION__, __LINE__);
+		}
+
+		if (!status) {
+			__atomic_store_n(&capture_enabled, false, __ATOMIC_SEQ_CST);
+		}
+	}
+	else {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: An event capture is already active!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	return status;
+}
+
+bool jni_StopEventCapture(uint64_t *length) {
+	bool status = false;
+
+	// Detach the mapping so the hook thread stops writing to it.
+	jni_LockCapture();
+	uint8_t *map = capture_map;
+	uint64_t capacity = capture_capacity;
+	uint64_t size = capture_length;
+	capture_map = NULL;
+	jni_UnlockCapture();
+
+	if (map != NULL) {
+		jni_UnmapCaptureFile(map, capacity);
+		jni_CloseCaptureFile(size);
+
+		if (length != NULL) {
+			*length = size;
+		}
+
+		__atomic_store_n(&capture_enabled, false, __ATOMIC_SEQ_CST);
+		status = true;
+	}
+
+	return status;
+}
+
+void jni_CaptureEvent(virtual_event * const event) {
+	if (__atomic_load_n(&capture_enabled, __ATOMIC_RELAXED)) {
+		jni_LockCapture();
+		if (capture_map != NULL) {
+			// Make sure the largest possible record will fit.
+			if (capture_length + 1 + EVENT_CAPTURE_RECORD_MAX > capture_capacity) {
+				jni_UnmapCaptureFile(capture_map, capture_capacity);
+
+				capture_capacity *= 2;
+				capture_map = jni_MapCaptureFile(capture_capacity);
+				if (capture_map == NULL) {
+					jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to grow the capture file, capture stopped!\n",
+							__FUNCTION__, __LINE__);
+
+					// Keep what was written before the failure.
+					jni_CloseCaptureFile(capture_length);
+					__atomic_store_n(&capture_enabled, false, __ATOMIC_SEQ_CST);
+				}
+			}
+
+			if (capture_map != NULL) {
+				uint8_t *record = capture_map + capture_length;
+				size_t size = jni_EncodeEvent(event, record + 1);
+				if (size > 0) {
+					record[0] = (uint8_t) size;
+					capture_length += 1 + size;
+				}
+			}
+		}
+		jni_UnlockCapture();
+	}
+}
+
+bool jni_ReadCaptureHeader(const uint8_t *header, capture_state *state) {
+	bool status = false;
+
+	if (memcmp(header, EVENT_CAPTURE_MAGIC, 4) == 0 && header[4] == EVENT_CAPTURE_VERSION) {
+		state->flags = header[5];
+		state->time = 0;
+		state->x = 0;
+		state->y = 0;
+
+		status = true;
+	}
+
+	return status;
+}
+
+size_t jni_DecodeCaptureRecord(const uint8_t *data, size_t size, capture_state *state, virtual_event *event) {
+	size_t count = 0;
+
+	if (size > 1 && data[0] > 0 && (size_t) data[0] + 1 <= size) {
+		const uint8_t *in = data + 2;
+		size_t available = data[0] - 1;
+
+		// The payload always contains the mask, time and up to six fields.
+		uint64_t values[8];
+		size_t fields = 0, used;
+		while (available > 0 && fields < 8 && (used = jni_GetVarint(in, available, &values[fields])) > 0) {
+			in += used;
+			available -= used;
+			fields++;
+		}
+
+		memset(event, 0, sizeof(virtual_event));
+		event->type = (event_type) data[1];
+
+		bool valid = available == 0 && fields >= 2;
+		if (valid) {
+			event->mask = (uint16_t) values[0];
+
+			if (state->flags & EVENT_CAPTURE_DELTA) {
+				event->time = state->time + (uint64_t) jni_UnZigZag(values[1]);
+			}
+			else {
+				event->time = values[1];
+			}
+		}
+
+		switch (event->type) {
+			case EVENT_KEY_TYPED:
+				valid = valid && fields == 4;
+				if (valid) {
+					event->data.keyboard.keychar = (uint16_t) values[2];
+					event->data.keyboard.rawcode = (uint16_t) values[3];
+				}
+				break;
+
+			case EVENT_KEY_PRESSED:
+			case EVENT_KEY_RELEASED:
+				valid = valid && fields == 4;
+				if (valid) {
+					event->data.keyboard.keycode = (uint16_t) values[2];
+					event->data.keyboard.rawcode = (uint16_t) values[3];
+				}
+				break;
+
+			case EVENT_MOUSE_CLICKED:
+			case EVENT_MOUSE_PRESSED:
+			case EVENT_MOUSE_RELEASED:
+			case EVENT_MOUSE_MOVED:
+			case EVENT_MOUSE_DRAGGED:
+				valid = valid && fields == 6;
+				if (valid) {
+					event->data.mouse.x = jni_GetCoordinate(values[2], state, state->x);
+					event->data.mouse.y = jni_GetCoordinate(values[3], state, state->y);
+					event->data.mouse.button = (uint16_t) values[4];
+					event->data.mouse.clicks = (uint16_t) values[5];
+
+					state->x = event->data.mouse.x;
+					state->y = event->data.mouse.y;
+				}
+				break;
+
+			case EVENT_MOUSE_WHEEL:
+				valid = valid && fields == 8;
+				if (valid) {
+					event->data.wheel.x = jni_GetCoordinate(values[2], state, state->x);
+					event->data.wheel.y = jni_GetCoordinate(values[3], state, state->y);
+					event->data.wheel.clicks = (uint16_t) values[4];
+					event->data.wheel.type = (uint8_t) values[5];
+					event->data.wheel.amount = (uint16_t) values[6];
+					event->data.wheel.rotation = (int16_t) jni_UnZigZag(values[7]);
+
+					state->x = event->data.wheel.x;
+					state->y = event->data.wheel.y;
+				}
+				break;
+
+			default:
+				valid = false;
+				break;
+		}
+
+		if (valid) {
+			state->time = event->time;
+			count = (size_t) data[0] + 1;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,81 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_EventCapture_h
+#define _Included_jni_EventCapture_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+/* The event capture writes every native event received by the dispatcher to
+ * a memory mapped file before any Java objects are created.  The file starts
+ * with an EVENT_CAPTURE_HEADER_SIZE byte header:
+ *
+ *   [0..3] "JNHC"
+ *   [4]    EVENT_CAPTURE_VERSION
+ *   [5]    EVENT_CAPTURE_* flags
+ *   [6..7] reserved
+ *
+ * followed by length prefixed records.  Each record is a single byte payload
+ * length, the event type byte and a sequence of unsigned LEB128 values: the
+ * modifier mask, the timestamp and the event data fields.  Signed values are
+ * zig-zag encoded.  When EVENT_CAPTURE_DELTA is set, the timestamp and the
+ * pointer coordinates are stored relative to the previous record.
+ */
+#define EVENT_CAPTURE_MAGIC			"JNHC"
+#define EVENT_CAPTURE_VERSION		1
+#define EVENT_CAPTURE_HEADER_SIZE	8
+
+#define EVENT_CAPTURE_DELTA			0x01
+
+// The largest possible record payload.
+#define EVENT_CAPTURE_RECORD_MAX	48
+
+// The values of the previous record used as the delta encoding baseline.
+typedef struct _capture_state {
+	uint8_t flags;
+	uint64_t time;
+	int16_t x;
+	int16_t y;
+} capture_state;
+
+// Create the capture file and start writing events to it.
+extern bool jni_StartEventCapture(const char *path, uint8_t flags);
+
+/* Stop writing events, trim the capture file and close it.  If length is not
+ * NULL it receives the final size of the file.  Returns false if no capture
+ * was active.
+ */
+extern bool jni_StopEventCapture(uint64_t *length);
+
+// Called on the hook thread for every native event.
+extern void jni_CaptureEvent(virtual_event * const event);
+
+/* Validate the capture file header and initialize the decoder state.
+ * Returns false if the header is not a supported capture header.
+ */
+extern bool jni_ReadCaptureHeader(const uint8_t *header, capture_state *state);
+
+/* Decode the record at the start of the supplied data.  Returns the number of
+ * bytes consumed, including the length prefix, or zero if the data does not
+ * contain a complete, valid record.
+ */
+extern size_t jni_DecodeCaptureRecord(const uint8_t *data, size_t size, capture_state *state, virtual_event *event);
+
+#endif
@@ -0,0 +1,256 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <uiohook.h>
+
+#include "jni_EventCoalescer.h"
+#include "jni_Statistics.h"
+
+static volatile bool coalescing_enabled = false;
+
+/* The state below is shared between the hook thread, the Java dispatch thread
+ * and the event queue consumer.  It is only held for a structure copy, so a
+ * spin lock is used to avoid blocking the hook thread on an operating system
+ * primitive.
+ */
+static volatile bool motion_lock = false;
+
+// The number of motion events handed to Java that have not completed yet.
+static unsigned int motion_busy = 0;
+
+// The latest merged motion event, its capture stamp and the number of events
+// it represents.
+static virtual_event motion_pending;
+static uint64_t motion_pending_stamp;
+static volatile unsigned int motion_pending_count = 0;
+
+// The wheel accumulation window limits, 0 if the limit is not used.
+static volatile unsigned int wheel_window_time = 0;
+static volatile unsigned int wheel_window_count = 0;
+
+/* The accumulated wheel event, the number of events it represents, the event
+ * time the window opened and the jni_GetNanoTime() deadline of the window.
+ * These are updated on the hook thread and taken by the event queue consumer
+ * when a time window expires.  A wheel event and a motion event are never
+ * pending at the same time because each flushes the other.
+ */
+static virtual_event wheel_pending;
+static uint64_t wheel_pending_stamp;
+static volatile unsigned int wheel_pending_count = 0;
+static uint64_t wheel_pending_start;
+static uint64_t wheel_pending_deadline;
+
+static inline void jni_LockMotion() {
+	while (__atomic_test_and_set(&motion_lock, __ATOMIC_ACQUIRE)) {
+		// Spin, the lock is never held for more than a few instructions.
+	}
+}
+
+static inline void jni_UnlockMotion() {
+	__atomic_clear(&motion_lock, __ATOMIC_RELEASE);
+}
+
+void jni_SetMotionCoalescing(bool enabled) {
+	__atomic_store_n(&coalescing_enabled, enabled, __ATOMIC_RELAXED);
+}
+
+void jni_SetWheelAccumulation(unsigned int time, unsigned int count) {
+	__atomic_store_n(&wheel_window_time, time, __ATOMIC_RELAXED);
+	__atomic_store_n(&wheel_window_count, count, __ATOMIC_RELAXED);
+}
+
+static bool jni_AccumulateWheel(virtual_event * const event, uint64_t stamp, virtual_event *flush, uint64_t *flush_stamp, unsigned int *flush_count) {
+	bool status = false;
+
+	unsigned int time = __atomic_load_n(&wheel_window_time, __ATOMIC_RELAXED);
+	unsigned int count = __atomic_load_n(&wheel_window_count, __ATOMIC_RELAXED);
+
+	bool wheel = event->type == EVENT_MOUSE_WHEEL && (time > 0 || count > 1);
+
+	// Other events only need the lock if a wheel event is pending.
+	if (wheel || __atomic_load_n(&wheel_pending_count, __ATOMIC_RELAXED) > 0) {
+		jni_LockMotion();
+		if (wheel_pending_count > 0) {
+			// Only events that scroll the same distance per unit in the same
+			// direction are summed, so the total distance is never lost.
+			bool extend = wheel
+					&& event->data.wheel.type == wheel_pending.data.wheel.type
+					&& event->data.wheel.amount == wheel_pending.data.wheel.amount
+					&& (event->data.wheel.rotation < 0) == (wheel_pending.data.wheel.rotation < 0)
+					&& abs(wheel_pending.data.wheel.rotation + event->data.wheel.rotation) <= INT16_MAX
+					&& (time == 0 || event->time - wheel_pending_start < time);
+
+			if (!extend) {
+				*flush = wheel_pending;
+				*flush_stamp = wheel_pending_stamp;
+				*flush_count = wheel_pending_count;
+				wheel_pending_count = 0;
+			}
+		}
+
+		if (wheel) {
+			if (wheel_pending_count == 0) {
+				wheel_pending = *event;
+				wheel_pending_start = event->time;
+				wheel_pending_deadline = time > 0 ? jni_GetNanoTime() + (uint64_t) time * 1000000 : UINT64_MAX;
+			}
+			else {
+				// Keep the latest position, modifiers and time.
+				wheel_pending.time = event->time;
+				wheel_pending.mask = event->mask;
+				wheel_pending.data.wheel.x = event->data.wheel.x;
+				wheel_pending.data.wheel.y = event->data.wheel.y;
+				wheel_pending.data.wheel.rotation += event->data.wheel.rotation;
+			}
+			wheel_pending_stamp = stamp;
+			wheel_pending_count++;
+
+			// A window completed by this event can only follow another wheel event
+			// of the same window, so nothing else was flushed above.
+			if (count > 1 && wheel_pending_count >= count) {
+				*flush = wheel_pending;
+				*flush_stamp = wheel_pending_stamp;
+				*flush_count = wheel_pending_count;
+				wheel_pending_count = 0;
+			}
+
+			status = true;
+		}
+		jni_UnlockMotion();
+	}
+
+	return status;
+}
+
+uint64_t jni_GetWheelDeadline() {
+	uint64_t deadline = 0;
+
+	if (__atomic_load_n(&wheel_pending_count, __ATOMIC_SEQ_CST) > 0) {
+		jni_LockMotion();
+		if (wheel_pending_count > 0 && wheel_pending_deadline != UINT64_MAX) {
+			deadline = wheel_pending_deadline;
+		}
+		jni_UnlockMotion();
+	}
+
+	return deadline;
+}
+
+bool jni_TakeWheelAccumulation(uint64_t now, virtual_event *flush, uint64_t *flush_stamp, unsigned int *flush_count) {
+	bool status = false;
+
+	jni_LockMotion();
+	if (wheel_pending_count > 0 && wheel_pending_deadline <= now) {
+		*flush = wheel_pending;
+		*flush_stamp = wheel_pending_stamp;
+		*flush_count = wheel_pending_count;
+		wheel_pending_count = 0;
+
+		status = true;
+	}
+	jni_UnlockMotion();
+
+	return status;
+}
+
+void jni_ResetEventCoalescer() {
+	jni_LockMotion();
+	motion_busy = 0;
+	motion_pending_count = 0;
+	wheel_pending_count = 0;
+	jni_UnlockMotion();
+}
+
+void jni_BeginMotionDispatch() {
+	jni_LockMotion();
+	motion_busy++;
+	jni_UnlockMotion();
+}
+
+void jni_CancelMotionDispatch() {
+	jni_LockMotion();
+	if (motion_busy > 0) {
+		motion_busy--;
+	}
+	jni_UnlockMotion();
+}
+
+bool jni_CompleteMotionDispatch(virtual_event *event, uint64_t *stamp, unsigned int *count) {
+	bool status = false;
+
+	jni_LockMotion();
+	if (motion_pending_count > 0) {
+		// Hand the pending event to the caller, the dispatcher stays busy.
+		*event = motion_pending;
+		*stamp = motion_pending_stamp;
+		*count = motion_pending_count;
+		motion_pending_count = 0;
+
+		status = true;
+	}
+	else if (motion_busy > 0) {
+		motion_busy--;
+	}
+	jni_UnlockMotion();
+
+	return status;
+}
+
+bool jni_CoalesceEvent(virtual_event * const event, uint64_t stamp, virtual_event *flush, uint64_t *flush_stamp, unsigned int *flush_count) {
+	*flush_count = 0;
+
+	// A pending wheel event is flushed here before any motion event is merged.
+	bool status = jni_AccumulateWheel(event, stamp, flush, flush_stamp, flush_count);
+
+	bool motion = (event->type == EVENT_MOUSE_MOVED || event->type == EVENT_MOUSE_DRAGGED)
+			&& __atomic_load_n(&coalescing_enabled, __ATOMIC_RELAXED);
+
+	// Only the hook thread makes a pending event available, so there is
+	// nothing to flush if it has not done so.
+	if (motion || __atomic_load_n(&motion_pending_count, __ATOMIC_RELAXED) > 0) {
+		jni_LockMotion();
+		if (motion && motion_busy > 0) {
+			if (motion_pending_count > 0 && motion_pending.type != event->type) {
+				// Moved and dragged events are never merged with each other.
+				*flush = motion_pending;
+				*flush_stamp = motion_pending_stamp;
+				*flush_count = motion_pending_count;
+				motion_pending_count = 0;
+			}
+
+			motion_pending = *event;
+			motion_pending_stamp = stamp;
+			motion_pending_count++;
+
+			status = true;
+		}
+		else if (motion_pending_count > 0) {
+			// Any other event must not overtake the pending motion event.
+			*flush = motion_pending;
+			*flush_stamp = motion_pending_stamp;
+			*flush_count = motion_pending_count;
+			motion_pending_count = 0;
+		}
+		jni_UnlockMotion();
+	}
+
+	return status;
+}
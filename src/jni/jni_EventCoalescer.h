@@ -0,0 +1,96 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_EventCoalescer_h
+#define _Included_jni_EventCoalescer_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+/* Mouse motion coalescing merges consecutive EVENT_MOUSE_MOVED or
+ * EVENT_MOUSE_DRAGGED events that arrive while Java is still dispatching an
+ * earlier motion event.  Only the latest coordinates are kept along with the
+ * number of native events that were merged.  When the Java dispatcher finishes
+ * with a motion event it collects the pending event, if any, and delivers it
+ * immediately.
+ *
+ * Mouse wheel accumulation merges consecutive EVENT_MOUSE_WHEEL events of the
+ * same scroll type, scroll amount and direction into a single event carrying
+ * the summed rotation.  An accumulation window closes after a fixed number of
+ * events, or with the first wheel event that arrives a fixed number of
+ * milliseconds after the window opened.  Any other event that reaches the
+ * coalescer closes the window early, and the pending window is delivered once
+ * the hook has stopped.  While the native event queue is enabled, its consumer also
+ * closes a time window when it expires.  Otherwise a time window only closes
+ * when the next event arrives.
+ */
+
+// Enable or disable merging of new motion events.
+extern void jni_SetMotionCoalescing(bool enabled);
+
+/* Configure mouse wheel accumulation.  The window closes after time
+ * milliseconds or count events, whichever comes first.  A value of 0 disables
+ * that limit; accumulation is disabled if both are 0 or count is 1.
+ */
+extern void jni_SetWheelAccumulation(unsigned int time, unsigned int count);
+
+/* Returns the jni_GetNanoTime() deadline of the pending wheel accumulation
+ * window, or 0 if no wheel event is pending or the window has no time limit.
+ */
+extern uint64_t jni_GetWheelDeadline();
+
+/* Take the pending wheel event if its window expires at or before now.  Pass
+ * UINT64_MAX to take the pending wheel event regardless of its window.
+ * Returns true and copies the event, its capture stamp and its merge count if
+ * an event was taken.
+ */
+extern bool jni_TakeWheelAccumulation(uint64_t now, virtual_event *flush, uint64_t *flush_stamp, unsigned int *flush_count);
+
+/* Forget the motion events still counted as in flight and discard any pending
+ * motion or wheel event.  This must only be called while the hook is not
+ * running, as motion events dropped by a previous shutdown never complete.
+ */
+extern void jni_ResetEventCoalescer();
+
+// Called by Java when a motion event has been queued for dispatch.
+extern void jni_BeginMotionDispatch();
+
+/* Called by Java after a motion event has been delivered to all listeners.
+ * Returns true and copies the pending event, its capture stamp and its merge
+ * count if another motion event arrived in the meantime.  Otherwise returns
+ * false.
+ */
+extern bool jni_CompleteMotionDispatch(virtual_event *event, uint64_t *stamp, unsigned int *count);
+
+/* Called by Java if a motion event passed to jni_BeginMotionDispatch() could
+ * not be queued for dispatch.  A pending event is left for the hook thread to
+ * flush with the next event.
+ */
+extern void jni_CancelMotionDispatch();
+
+/* Called on the hook thread for every event.  Returns true if the event has
+ * been merged into the pending motion or wheel event and must not be
+ * dispatched.  If a previously pending event must be dispatched first to
+ * preserve event order, or a wheel accumulation window was completed by this
+ * event, it is copied into flush and flush_count is set to a non-zero value.
+ * The capture stamp of a merged event is that of the latest event merged.
+ */
+extern bool jni_CoalesceEvent(virtual_event * const event, uint64_t stamp, virtual_event *flush, uint64_t *flush_stamp, unsigned int *flush_count);
+
+#endif
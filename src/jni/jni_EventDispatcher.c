@@ -18,166 +18,290 @@
 
 #include <jni.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <uiohook.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 #include "jni_Converter.h"
+#include "jni_EventCapture.h"
+#include "jni_EventCoalescer.h"
+#include "jni_EventDispathcer.h"
+#include "jni_EventPool.h"
+#include "jni_EventQueue.h"
+#include "jni_Gestures.h"
 #include "jni_Globals.h"
+#include "jni_Hotkeys.h"
 #include "jni_Logger.h"
+#include "jni_Statistics.h"
+#include "org_jnativehook_GlobalScreen.h"
 #include "org_jnativehook_NativeInputEvent.h"
 #include "org_jnativehook_keyboard_NativeKeyEvent.h"
 #include "org_jnativehook_mouse_NativeMouseEvent.h"
 #include "org_jnativehook_mouse_NativeMouseWheelEvent.h"
 
-void jni_EventDispatcher(virtual_event * const event) {
+// The Java name of the native hook thread.
+#define HOOK_THREAD_NAME	"JNativeHook Hook Thread"
+
+// Set while native events are stamped with the capture time.
+static volatile bool timestamps_enabled = false;
+
+// Set while the dispatcher is closed for shutdown.
+static volatile bool dispatch_closed = false;
+
+// The number of events currently inside jni_EventDispatcher().
+static volatile unsigned int dispatch_active = 0;
+
+// The event groups that currently have listeners in Java.
+static volatile jint event_mask = 0x00;
+
+// The event groups that have synchronous filters in Java.
+static volatile jint filter_mask = 0x00;
+
+// The event groups that have primitive listeners in Java.
+static volatile jint primitive_mask = 0x00;
+
+void jni_SetEventTimestamps(bool enabled) {
+	__atomic_store_n(&timestamps_enabled, enabled, __ATOMIC_RELAXED);
+}
+
+void jni_SetEventMask(jint mask) {
+	__atomic_store_n(&event_mask, mask, __ATOMIC_RELAXED);
+}
+
+void jni_SetFilterMask(jint mask) {
+	__atomic_store_n(&filter_mask, mask, __ATOMIC_RELAXED);
+}
+
+void jni_SetPrimitiveMask(jint mask) {
+	__atomic_store_n(&primitive_mask, mask, __ATOMIC_RELAXED);
+}
+
+// Map the native event type to the listener group that receives it.
+// The GlobalScreen.EVENT_MASK_* group of each EVENT_CLASS_*.
+static const jint event_masks[] = {
+	[EVENT_CLASS_NONE]			= 0x00,
+	[EVENT_CLASS_KEY]			= org_jnativehook_GlobalScreen_EVENT_MASK_KEY,
+	[EVENT_CLASS_MOUSE]			= org_jnativehook_GlobalScreen_EVENT_MASK_MOUSE,
+	[EVENT_CLASS_MOUSE_MOTION]	= org_jnativehook_GlobalScreen_EVENT_MASK_MOUSE_MOTION,
+	[EVENT_CLASS_MOUSE_WHEEL]	= org_jnativehook_GlobalScreen_EVENT_MASK_MOUSE_WHEEL
+};
+
+static inline jint jni_GetEventMask(event_type type) {
+	return event_masks[jni_GetEventClass(type)];
+}
+
+// Overwrite every field of a pooled event object with the native event.
+static void jni_InitEventObject(JNIEnv *env, jobject NativeInputEvent_object, virtual_event * const event, jint id, unsigned int count, uint64_t stamp) {
+	jint location;
+
+	(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_NativeInputEvent->id, id);
+	(*env)->SetLongField(env, NativeInputEvent_object, org_jnativehook_NativeInputEvent->when, (jlong) event->time);
+	(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_NativeInputEvent->modifiers, (jint) event->mask);
+	(*env)->SetShortField(env, NativeInputEvent_object, org_jnativehook_NativeInputEvent->reserved, (jshort) 0x00);
+	(*env)->SetLongField(env, NativeInputEvent_object, org_jnativehook_NativeInputEvent->captureTime, (jlong) stamp);
+	(*env)->SetLongField(env, NativeInputEvent_object, org_jnativehook_NativeInputEvent->dispatchTime, (jlong) 0);
+
+	switch (jni_GetEventClass(event->type)) {
+		case EVENT_CLASS_KEY:
+			jni_ConvertToJavaLocation(event->data.keyboard.keycode, &location);
+
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_keyboard_NativeKeyEvent->rawCode, (jint) event->data.keyboard.rawcode);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_keyboard_NativeKeyEvent->keyLocation, location);
+
+			// Typed events carry a character instead of a key code.
+			if (event->type == EVENT_KEY_TYPED) {
+				(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_keyboard_NativeKeyEvent->keyCode, (jint) org_jnativehook_keyboard_NativeKeyEvent_VK_UNDEFINED);
+				(*env)->SetCharField(env, NativeInputEvent_object, org_jnativehook_keyboard_NativeKeyEvent->keyChar, (jchar) event->data.keyboard.keychar);
+			}
+			else {
+				(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_keyboard_NativeKeyEvent->keyCode, (jint) event->data.keyboard.keycode);
+				(*env)->SetCharField(env, NativeInputEvent_object, org_jnativehook_keyboard_NativeKeyEvent->keyChar, (jchar) org_jnativehook_keyboard_NativeKeyEvent_CHAR_UNDEFINED);
+			}
+			break;
+
+		case EVENT_CLASS_MOUSE:
+		case EVENT_CLASS_MOUSE_MOTION:
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->x, (jint) event->data.mouse.x);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->y, (jint) event->data.mouse.y);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->clickCount, (jint) event->data.mouse.clicks);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->button, (jint) event->data.mouse.button);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->coalescedCount, count > 1 ? (jint) count : 1);
+			break;
+
+		case EVENT_CLASS_MOUSE_WHEEL:
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->x, (jint) event->data.wheel.x);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->y, (jint) event->data.wheel.y);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->clickCount, (jint) event->data.wheel.clicks);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseWheelEvent->scrollType, (jint) event->data.wheel.type);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseWheelEvent->scrollAmount, (jint) event->data.wheel.amount);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseWheelEvent->wheelRotation, (jint) event->data.wheel.rotation);
+			(*env)->SetIntField(env, NativeInputEvent_object, org_jnativehook_mouse_NativeMouseEvent->coalescedCount, count > 1 ? (jint) count : 1);
+			break;
+	}
+}
+
+jobject jni_CreateEventObject(JNIEnv *env, virtual_event * const event, unsigned int count, uint64_t stamp) {
+	jint id, location;
+
+	jobject NativeInputEvent_object = NULL;
+
+	jni_ConvertToJavaType(event->type, &id);
+
+	switch (jni_GetEventClass(event->type)) {
+		case EVENT_CLASS_KEY:
+			jni_ConvertToJavaLocation(event->data.keyboard.keycode, &location);
+
+			// Typed events carry a character instead of a key code.
+			if (event->type == EVENT_KEY_TYPED) {
+				NativeInputEvent_object = (*env)->NewObject(
+										env,
+										org_jnativehook_keyboard_NativeKeyEvent->cls,
+										org_jnativehook_keyboard_NativeKeyEvent->init,
+										id,
+										(jlong) event->time,
+										(jint) event->mask,
+										(jint) event->data.keyboard.rawcode,
+										(jint) org_jnativehook_keyboard_NativeKeyEvent_VK_UNDEFINED,
+										(jchar) event->data.keyboard.keychar,
+										location);
+			}
+			else {
+				NativeInputEvent_object = (*env)->NewObject(
+										env,
+										org_jnativehook_keyboard_NativeKeyEvent->cls,
+										org_jnativehook_keyboard_NativeKeyEvent->init,
+										id,
+										(jlong) event->time,
+										(jint) event->mask,
+										(jint) event->data.keyboard.rawcode,
+										(jint) event->data.keyboard.keycode,
+										(jchar) org_jnativehook_keyboard_NativeKeyEvent_CHAR_UNDEFINED,
+										location);
+			}
+			break;
+
+		case EVENT_CLASS_MOUSE:
+		case EVENT_CLASS_MOUSE_MOTION:
+			NativeInputEvent_object = (*env)->NewObject(
+										env,
+										org_jnativehook_mouse_NativeMouseEvent->cls,
+										org_jnativehook_mouse_NativeMouseEvent->init,
+										id,
+										(jlong) event->time,
+										(jint) event->mask,
+										(jint) event->data.mouse.x,
+										(jint) event->data.mouse.y,
+										(jint) event->data.mouse.clicks,
+										(jint) event->data.mouse.button);
+			break;
+
+		case EVENT_CLASS_MOUSE_WHEEL:
+			NativeInputEvent_object = (*env)->NewObject(
+										env,
+										org_jnativehook_mouse_NativeMouseWheelEvent->cls,
+										org_jnativehook_mouse_NativeMouseWheelEvent->init,
+										id,
+										(jlong) event->time,
+										(jint) event->mask,
+										(jint) event->data.wheel.x,
+										(jint) event->data.wheel.y,
+										(jint) event->data.wheel.clicks,
+										(jint) event->data.wheel.type,
+										(jint) event->data.wheel.amount,
+										(jint) event->data.wheel.rotation);
+			break;
+	}
+
+	// Record how many native events a coalesced motion or wheel event represents.
+	if (count > 1 && NativeInputEvent_object != NULL) {
+		(*env)->SetIntField(
+				env,
+				NativeInputEvent_object,
+				org_jnativehook_mouse_NativeMouseEvent->coalescedCount,
+				(jint) count);
+	}
+
+	if (stamp != 0 && NativeInputEvent_object != NULL) {
+		(*env)->SetLongField(
+				env,
+				NativeInputEvent_object,
+				org_jnativehook_NativeInputEvent->captureTime,
+				(jlong) stamp);
+	}
+
+	return NativeInputEvent_object;
+}
+
+/* The hook thread stays attached to the JVM, so an exception thrown by an
+ * upcall must be cleared before any other JNI function is called on it.
+ * Returns true if an exception was pending.
+ */
+static bool jni_ClearUpcallException(JNIEnv *env, const char *upcall) {
+	bool pending = false;
+
+	if ((*env)->ExceptionCheck(env) == JNI_TRUE) {
+		(*env)->ExceptionDescribe(env);
+		(*env)->ExceptionClear(env);
+		pending = true;
+
+		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: Uncaught exception in GlobalScreen.%s()!\n",
+				__FUNCTION__, __LINE__, upcall);
+	}
+
+	return pending;
+}
+
+static void jni_DeliverEvent(virtual_event * const event, unsigned int count, uint64_t stamp) {
 	JNIEnv *env = NULL;
 
+	bool measure = jni_IsStatisticsEnabled();
+	uint64_t start = 0, end;
+	if (measure) {
+		jni_RecordEvent(event->type);
+		start = jni_GetNanoTime();
+	}
+
+	// When the native event queue is enabled, events are handed off to the
+	// GlobalScreen drain thread without crossing into Java on this thread.
+	// Events that may be consumed by a filter must be delivered synchronously.
+	if (jni_IsEventQueueEnabled()
+			&& (jni_GetEventMask(event->type) & __atomic_load_n(&filter_mask, __ATOMIC_RELAXED)) == 0x00) {
+		jni_PushEventQueue(event, count, stamp);
+
+		if (measure) {
+			jni_RecordLatency(event->type, STATISTICS_STAGE_CONVERSION, jni_GetNanoTime() - start);
+		}
+		return;
+	}
+
 	// NOTE: This function executes on the hook thread!  If you need to block
 	// please do so on another thread via your own event dispatcher.
-	if ((*jvm)->AttachCurrentThread(jvm, (void **)(&env), NULL) == JNI_OK) {
-		// Create the global screen references up front to save time in the callback.
-		jobject GlobalScreen_object = (*env)->CallStaticObjectMethod(
-				env,
-				org_jnativehook_GlobalScreen->cls,
-				org_jnativehook_GlobalScreen->getInstance);
+	if (jni_GetEnv(&env, HOOK_THREAD_NAME) == JNI_OK) {
+		// Use the global screen reference created when the hook was registered.
+		jobject GlobalScreen_object = org_jnativehook_GlobalScreen_object;
 
 		if (GlobalScreen_object != NULL) {
-			jobject NativeInputEvent_object = NULL;
-			jint location;
-
-			switch (event->type) {
-				case EVENT_KEY_PRESSED:
-					jni_ConvertToJavaLocation(event->data.keyboard.keycode, &location);
-
-					NativeInputEvent_object = (*env)->NewObject(
-											env,
-											org_jnativehook_keyboard_NativeKeyEvent->cls,
-											org_jnativehook_keyboard_NativeKeyEvent->init,
-											org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_PRESSED,
-											(jlong) event->time,
-											(jint) event->mask,
-											(jint) event->data.keyboard.rawcode,
-											(jint) event->data.keyboard.keycode,
-											(jchar) org_jnativehook_keyboard_NativeKeyEvent_CHAR_UNDEFINED,
-											location);
-					break;
-
-				case EVENT_KEY_RELEASED:
-					jni_ConvertToJavaLocation(event->data.keyboard.keycode, &location);
-
-					NativeInputEvent_object = (*env)->NewObject(
-											env,
-											org_jnativehook_keyboard_NativeKeyEvent->cls,
-											org_jnativehook_keyboard_NativeKeyEvent->init,
-											org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_RELEASED,
-											(jlong) event->time,
-											(jint) event->mask,
-											(jint) event->data.keyboard.rawcode,
-											(jint) event->data.keyboard.keycode,
-											(jchar) org_jnativehook_keyboard_NativeKeyEvent_CHAR_UNDEFINED,
-											location);
-					break;
-
-				case EVENT_KEY_TYPED:
-					jni_ConvertToJavaLocation(event->data.keyboard.keycode, &location);
-
-					NativeInputEvent_object = (*env)->NewObject(
-											env,
-											org_jnativehook_keyboard_NativeKeyEvent->cls,
-											org_jnativehook_keyboard_NativeKeyEvent->init,
-											org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_TYPED,
-											(jlong) event->time,
-											(jint) event->mask,
-											(jint) event->data.keyboard.rawcode,
-											(jint) org_jnativehook_keyboard_NativeKeyEvent_VK_UNDEFINED,
-											(jchar) event->data.keyboard.keychar,
-											location);
-					break;
-
-				case EVENT_MOUSE_PRESSED:
-					NativeInputEvent_object = (*env)->NewObject(
-												env,
-												org_jnativehook_mouse_NativeMouseEvent->cls,
-												org_jnativehook_mouse_NativeMouseEvent->init,
-												org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_PRESSED,
-												(jlong) event->time,
-												(jint) event->mask,
-												(jint) event->data.mouse.x,
-												(jint) event->data.mouse.y,
-												(jint) event->data.mouse.clicks,
-												(jint) event->data.mouse.button);
-					break;
-
-				case EVENT_MOUSE_RELEASED:
-					NativeInputEvent_object = (*env)->NewObject(
-												env,
-												org_jnativehook_mouse_NativeMouseEvent->cls,
-												org_jnativehook_mouse_NativeMouseEvent->init,
-												org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_RELEASED,
-												(jlong) event->time,
-												(jint) event->mask,
-												(jint) event->data.mouse.x,
-												(jint) event->data.mouse.y,
-												(jint) event->data.mouse.clicks,
-												(jint) event->data.mouse.button);
-					break;
-
-				case EVENT_MOUSE_CLICKED:
-					NativeInputEvent_object = (*env)->NewObject(
-												env,
-												org_jnativehook_mouse_NativeMouseEvent->cls,
-												org_jnativehook_mouse_NativeMouseEvent->init,
-												org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_CLICKED,
-												(jlong) event->time,
-												(jint) event->mask,
-												(jint) event->data.mouse.x,
-												(jint) event->data.mouse.y,
-												(jint) event->data.mouse.clicks,
-												(jint) event->data.mouse.button);
-					break;
-
-				case EVENT_MOUSE_MOVED:
-					NativeInputEvent_object = (*env)->NewObject(
-												env,
-												org_jnativehook_mouse_NativeMouseEvent->cls,
-												org_jnativehook_mouse_NativeMouseEvent->init,
-												org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_MOVED,
-												(jlong) event->time,
-												(jint) event->mask,
-												(jint) event->data.mouse.x,
-												(jint) event->data.mouse.y,
-												(jint) event->data.mouse.clicks,
-												(jint) event->data.mouse.button);
-					break;
-
-				case EVENT_MOUSE_DRAGGED:
-					NativeInputEvent_object = (*env)->NewObject(
-												env,
-												org_jnativehook_mouse_NativeMouseEvent->cls,
-												org_jnativehook_mouse_NativeMouseEvent->init,
-												org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_DRAGGED,
-												(jlong) event->time,
-												(jint) event->mask,
-												(jint) event->data.mouse.x,
-												(jint) event->data.mouse.y,
-												(jint) event->data.mouse.clicks,
-												(jint) event->data.mouse.button);
-					break;
-
-				case EVENT_MOUSE_WHEEL:
-					NativeInputEvent_object = (*env)->NewObject(
-												env,
-												org_jnativehook_mouse_NativeMouseWheelEvent->cls,
-												org_jnativehook_mouse_NativeMouseWheelEvent->init,
-												org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_WHEEL,
-												(jlong) event->time,
-												(jint) event->mask,
-												(jint) event->data.wheel.x,
-												(jint) event->data.wheel.y,
-												(jint) event->data.wheel.clicks,
-												(jint) event->data.wheel.type,
-												(jint) event->data.wheel.amount,
-												(jint) event->data.wheel.rotation);
-					break;
+			// Pooled objects are only handed out on the hook thread, so an object
+			// cannot be reused before its reserved flags are read back below.
+			jobject NativeInputEvent_object = jni_AcquireEventObject(env, jni_GetEventClass(event->type));
+			if (NativeInputEvent_object != NULL) {
+				jint id;
+				jni_ConvertToJavaType(event->type, &id);
+				jni_InitEventObject(env, NativeInputEvent_object, event, id, count, stamp);
+			}
+			else {
+				NativeInputEvent_object = jni_CreateEventObject(env, event, count, stamp);
+			}
+
+			if (measure) {
+				end = jni_GetNanoTime();
+				jni_RecordLatency(event->type, STATISTICS_STAGE_CONVERSION, end - start);
+				start = end;
 			}
 
 			if (NativeInputEvent_object != NULL) {
@@ -187,11 +311,18 @@ void jni_EventDispatcher(virtual_event * const event) {
 						org_jnativehook_GlobalScreen->dispatchEvent,
 						NativeInputEvent_object);
 
-				// Set the propagate flag from java.
-				event->reserved = (unsigned short) (*env)->GetShortField(
-						env, 
-						NativeInputEvent_object, 
-						org_jnativehook_NativeInputEvent->reserved);
+				if (measure) {
+					jni_RecordLatency(event->type, STATISTICS_STAGE_UPCALL, jni_GetNanoTime() - start);
+				}
+
+				// Events are propagated if the dispatch failed.
+				if (!jni_ClearUpcallException(env, "dispatchEvent")) {
+					// Set the propagate flag from java.
+					event->reserved = (unsigned short) (*env)->GetShortField(
+							env,
+							NativeInputEvent_object,
+							org_jnativehook_NativeInputEvent->reserved);
+				}
 				(*env)->DeleteLocalRef(env, NativeInputEvent_object);
 			}
 		}
@@ -205,7 +336,221 @@ void jni_EventDispatcher(virtual_event * const event) {
 	else {
 		// FIXME an exception should be thrown!
 
-		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: AttachCurrentThread() failed!\n",
+		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: jni_GetEnv() failed!\n",
 				__FUNCTION__, __LINE__);
 	}
 }
+
+static void jni_DeliverHotkey(jint id) {
+	JNIEnv *env = NULL;
+
+	if (jni_GetEnv(&env, HOOK_THREAD_NAME) == JNI_OK && org_jnativehook_GlobalScreen_object != NULL) {
+		(*env)->CallVoidMethod(
+				env,
+				org_jnativehook_GlobalScreen_object,
+				org_jnativehook_GlobalScreen->dispatchHotkey,
+				id);
+
+		jni_ClearUpcallException(env, "dispatchHotkey");
+	}
+	else {
+		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: Failed to deliver hotkey %i!\n",
+				__FUNCTION__, __LINE__, id);
+	}
+}
+
+static void jni_DeliverGesture(gesture_event * const gesture) {
+	JNIEnv *env = NULL;
+
+	if (jni_GetEnv(&env, HOOK_THREAD_NAME) == JNI_OK && org_jnativehook_GlobalScreen_object != NULL) {
+		(*env)->CallVoidMethod(
+				env,
+				org_jnativehook_GlobalScreen_object,
+				org_jnativehook_GlobalScreen->dispatchGesture,
+				gesture->type,
+				(jlong) gesture->time,
+				(jint) gesture->mask,
+				(jint) gesture->x,
+				(jint) gesture->y,
+				(jint) gesture->button,
+				(jint) gesture->count,
+				(jint) gesture->delta_x,
+				(jint) gesture->delta_y,
+				(jint) gesture->rotation);
+
+		jni_ClearUpcallException(env, "dispatchGesture");
+	}
+	else {
+		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: Failed to deliver gesture %i!\n",
+				__FUNCTION__, __LINE__, gesture->type);
+	}
+}
+
+// Pass the fields of a native event straight to the primitive listeners.
+static void jni_DeliverPrimitive(virtual_event * const event) {
+	JNIEnv *env = NULL;
+	jint id;
+
+	if (jni_GetEnv(&env, HOOK_THREAD_NAME) == JNI_OK && org_jnativehook_GlobalScreen_object != NULL) {
+		jni_ConvertToJavaType(event->type, &id);
+
+		switch (jni_GetEventClass(event->type)) {
+			case EVENT_CLASS_KEY:
+				(*env)->CallVoidMethod(
+						env,
+						org_jnativehook_GlobalScreen_object,
+						org_jnativehook_GlobalScreen->dispatchKeyPrimitive,
+						id,
+						(jint) event->data.keyboard.keycode,
+						(jint) event->data.keyboard.rawcode,
+						(jint) event->mask,
+						(jlong) event->time);
+
+				jni_ClearUpcallException(env, "dispatchKeyPrimitive");
+				break;
+
+			case EVENT_CLASS_MOUSE:
+			case EVENT_CLASS_MOUSE_MOTION:
+				(*env)->CallVoidMethod(
+						env,
+						org_jnativehook_GlobalScreen_object,
+						org_jnativehook_GlobalScreen->dispatchMousePrimitive,
+						id,
+						(jint) event->data.mouse.x,
+						(jint) event->data.mouse.y,
+						(jint) event->data.mouse.button,
+						(jint) event->mask,
+						(jlong) event->time);
+
+				jni_ClearUpcallException(env, "dispatchMousePrimitive");
+				break;
+
+			default:
+				break;
+		}
+	}
+	else {
+		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: Failed to deliver primitive event %u!\n",
+				__FUNCTION__, __LINE__, event->type);
+	}
+}
+
+static void jni_DispatchEvent(virtual_event * const event, uint64_t stamp) {
+	virtual_event flush;
+	uint64_t flush_stamp;
+	unsigned int flush_count;
+
+	// Events are captured before they are filtered, merged or converted.
+	jni_CaptureEvent(event);
+
+	// Hotkeys are matched before the event mask so that they work without
+	// any key listeners.  Consumed hotkey events are never delivered.
+	if (jni_GetEventClass(event->type) == EVENT_CLASS_KEY && jni_HasHotkeys()) {
+		jint hotkey;
+		bool consume = jni_MatchHotkey(event, &hotkey);
+
+		if (hotkey >= 0) {
+			jni_DeliverHotkey(hotkey);
+		}
+
+		if (consume) {
+			event->reserved = 0x01;
+			return;
+		}
+	}
+
+	// Gestures are also produced ahead of the event mask so that gesture
+	// listeners do not require the raw mouse events to cross into Java.
+	if (jni_IsGesturesEnabled()) {
+		gesture_event gestures[GESTURE_MAX];
+		unsigned int count = jni_ProcessGestures(event, gestures);
+
+		unsigned int i;
+		for (i = 0; i < count; i++) {
+			jni_DeliverGesture(&gestures[i]);
+		}
+	}
+
+	// Primitive listeners see every raw event before it is merged and
+	// without an event object.  Typed events carry a character, not a key.
+	if ((jni_GetEventMask(event->type) & __atomic_load_n(&primitive_mask, __ATOMIC_RELAXED)) != 0x00
+			&& event->type != EVENT_KEY_TYPED) {
+		jni_DeliverPrimitive(event);
+	}
+
+	// Nobody is listening for this type of event.
+	if ((jni_GetEventMask(event->type) & __atomic_load_n(&event_mask, __ATOMIC_RELAXED)) == 0x00) {
+		return;
+	}
+
+	bool merged = jni_CoalesceEvent(event, stamp, &flush, &flush_stamp, &flush_count);
+
+	// A pending motion or wheel event is always delivered before the event that follows it.
+	if (flush_count > 0) {
+		jni_DeliverEvent(&flush, flush_count, flush_stamp);
+	}
+
+	// The queue consumer closes a wheel time window that no event closes.
+	if (merged && event->type == EVENT_MOUSE_WHEEL && jni_IsEventQueueEnabled()) {
+		jni_NotifyEventQueue();
+	}
+
+	if (!merged) {
+		jni_DeliverEvent(event, 1, stamp);
+	}
+}
+
+void jni_EventDispatcher(virtual_event * const event) {
+	// The counter is raised before the closed flag is checked so that a
+	// shutdown either sees this event or this event sees the shutdown.
+	__atomic_add_fetch(&dispatch_active, 1, __ATOMIC_SEQ_CST);
+
+	if (!__atomic_load_n(&dispatch_closed, __ATOMIC_SEQ_CST)) {
+		// Stamp the event before any other processing.
+		uint64_t stamp = 0;
+		if (__atomic_load_n(&timestamps_enabled, __ATOMIC_RELAXED)) {
+			stamp = jni_GetNanoTime();
+		}
+
+		jni_DispatchEvent(event, stamp);
+	}
+
+	__atomic_sub_fetch(&dispatch_active, 1, __ATOMIC_SEQ_CST);
+}
+
+void jni_FlushEventDispatcher() {
+	virtual_event flush;
+	uint64_t flush_stamp;
+	unsigned int flush_count;
+
+	__atomic_add_fetch(&dispatch_active, 1, __ATOMIC_SEQ_CST);
+
+	// No later event will close the wheel accumulation window.
+	if (!__atomic_load_n(&dispatch_closed, __ATOMIC_SEQ_CST)
+			&& jni_TakeWheelAccumulation(UINT64_MAX, &flush, &flush_stamp, &flush_count)) {
+		jni_DeliverEvent(&flush, flush_count, flush_stamp);
+	}
+
+	__atomic_sub_fetch(&dispatch_active, 1, __ATOMIC_SEQ_CST);
+}
+
+void jni_OpenEventDispatcher() {
+	__atomic_store_n(&dispatch_closed, false, __ATOMIC_SEQ_CST);
+}
+
+bool jni_CloseEventDispatcher(uint64_t deadline) {
+	__atomic_store_n(&dispatch_closed, true, __ATOMIC_SEQ_CST);
+
+	bool idle;
+	while (!(idle = __atomic_load_n(&dispatch_active, __ATOMIC_SEQ_CST) == 0) && jni_GetNanoTime() < deadline) {
+		// The event in flight is waiting on Java, check back in a millisecond.
+		#ifdef _WIN32
+		Sleep(1);
+		#else
+		struct timespec duration = { 0, 1000000 };
+		nanosleep(&duration, NULL);
+		#endif
+	}
+
+	return idle;
+}
@@ -19,9 +19,59 @@
 #ifndef _Included_jni_EventDispathcer_h
 #define _Included_jni_EventDispathcer_h
 
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <uiohook.h>
 
 // This is a simple forwarding function to the Java event dispatcher.
 extern void jni_EventDispatcher(virtual_event * const event);
 
+/* Deliver the pending wheel accumulation event, if any, on the calling thread.
+ * This must only be called once the hook thread has stopped, as it is the
+ * only other producer of the native event queue.
+ */
+extern void jni_FlushEventDispatcher();
+
+// Allow the event dispatcher to call into Java.  This is the initial state.
+extern void jni_OpenEventDispatcher();
+
+/* Stop the event dispatcher from calling into Java and wait for the events
+ * already inside the dispatcher to finish.  The deadline uses the
+ * jni_GetNanoTime() clock.  Returns false if an event was still being
+ * dispatched at the deadline.
+ */
+extern bool jni_CloseEventDispatcher(uint64_t deadline);
+
+/* Create the Java event object for a native event.  The count is the number of
+ * native motion events represented by a coalesced event and should be 1 for
+ * all other events.  The stamp is the jni_GetNanoTime() capture time, or 0 if
+ * the event was not stamped.  Returns a local reference or NULL for unknown
+ * events.
+ */
+extern jobject jni_CreateEventObject(JNIEnv *env, virtual_event * const event, unsigned int count, uint64_t stamp);
+
+/* Enable or disable stamping each native event with the jni_GetNanoTime()
+ * clock as it enters the dispatcher.
+ */
+extern void jni_SetEventTimestamps(bool enabled);
+
+/* Set the org_jnativehook_GlobalScreen_EVENT_MASK_* groups that have at least
+ * one Java listener.  Events outside of the mask are discarded before any JNI
+ * calls are made.
+ */
+extern void jni_SetEventMask(jint mask);
+
+/* Set the org_jnativehook_GlobalScreen_EVENT_MASK_* groups that have at least
+ * one synchronous Java filter.  Events in these groups always cross into Java
+ * on the hook thread so that the filter may consume them.
+ */
+extern void jni_SetFilterMask(jint mask);
+
+/* Set the org_jnativehook_GlobalScreen_EVENT_MASK_* groups that have at least
+ * one primitive Java listener.  Events in these groups are passed to Java as
+ * primitive values on the hook thread before they are coalesced.
+ */
+extern void jni_SetPrimitiveMask(jint mask);
+
 #endif
@@ -0,0 +1,212 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+#include "jni_Converter.h"
+#include "jni_EventPool.h"
+#include "jni_Globals.h"
+#include "jni_Logger.h"
+#include "org_jnativehook_keyboard_NativeKeyEvent.h"
+#include "org_jnativehook_mouse_NativeMouseEvent.h"
+#include "org_jnativehook_mouse_NativeMouseWheelEvent.h"
+
+#if EVENT_POOL_SIZE > 64
+#error "EVENT_POOL_SIZE must fit in the 64-bit free slot bitmap"
+#endif
+
+// The pools for NativeKeyEvent, NativeMouseEvent and NativeMouseWheelEvent.
+#define EVENT_POOL_KEY			0
+#define EVENT_POOL_MOUSE		1
+#define EVENT_POOL_MOUSE_WHEEL	2
+#define EVENT_POOL_COUNT		3
+
+#define EVENT_POOL_ALL			(EVENT_POOL_SIZE == 64 ? UINT64_MAX : (((uint64_t) 1 << EVENT_POOL_SIZE) - 1))
+
+// The pool used for each EVENT_CLASS_*, or -1 if the class is not pooled.
+static const int8_t event_pools[] = {
+	[EVENT_CLASS_NONE]			= -1,
+	[EVENT_CLASS_KEY]			= EVENT_POOL_KEY,
+	[EVENT_CLASS_MOUSE]			= EVENT_POOL_MOUSE,
+	[EVENT_CLASS_MOUSE_MOTION]	= EVENT_POOL_MOUSE,
+	[EVENT_CLASS_MOUSE_WHEEL]	= EVENT_POOL_MOUSE_WHEEL
+};
+
+static jobject pool_objects[EVENT_POOL_COUNT][EVENT_POOL_SIZE];
+
+// A set bit marks a free slot.
+static volatile uint64_t pool_free[EVENT_POOL_COUNT];
+
+static volatile bool pool_enabled = false;
+static bool pool_created = false;
+
+// Create a placeholder object for a pool, the fields are set on every use.
+static jobject jni_CreatePoolObject(JNIEnv *env, int pool) {
+	jobject object = NULL;
+
+	switch (pool) {
+		case EVENT_POOL_KEY:
+			object = (*env)->NewObject(
+					env,
+					org_jnativehook_keyboard_NativeKeyEvent->cls,
+					org_jnativehook_keyboard_NativeKeyEvent->init,
+					org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_PRESSED,
+					(jlong) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) org_jnativehook_keyboard_NativeKeyEvent_VK_UNDEFINED,
+					(jchar) org_jnativehook_keyboard_NativeKeyEvent_CHAR_UNDEFINED,
+					(jint) org_jnativehook_keyboard_NativeKeyEvent_LOCATION_UNKNOWN);
+			break;
+
+		case EVENT_POOL_MOUSE:
+			object = (*env)->NewObject(
+					env,
+					org_jnativehook_mouse_NativeMouseEvent->cls,
+					org_jnativehook_mouse_NativeMouseEvent->init,
+					org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_MOVED,
+					(jlong) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0);
+			break;
+
+		case EVENT_POOL_MOUSE_WHEEL:
+			object = (*env)->NewObject(
+					env,
+					org_jnativehook_mouse_NativeMouseWheelEvent->cls,
+					org_jnativehook_mouse_NativeMouseWheelEvent->init,
+					org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_WHEEL,
+					(jlong) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0,
+					(jint) 0);
+			break;
+	}
+
+	return object;
+}
+
+bool jni_EnableEventPool(JNIEnv *env) {
+	bool status = true;
+
+	if (!pool_created) {
+		int pool, slot;
+		for (pool = 0; pool < EVENT_POOL_COUNT && status; pool++) {
+			for (slot = 0; slot < EVENT_POOL_SIZE && status; slot++) {
+				jobject object = jni_CreatePoolObject(env, pool);
+
+				if (object != NULL) {
+					(*env)->SetIntField(env, object, org_jnativehook_NativeInputEvent->poolIndex,
+							(jint) (pool * EVENT_POOL_SIZE + slot));
+
+					pool_objects[pool][slot] = (*env)->NewGlobalRef(env, object);
+					(*env)->DeleteLocalRef(env, object);
+				}
+
+				status = pool_objects[pool][slot] != NULL;
+			}
+
+			pool_free[pool] = EVENT_POOL_ALL;
+		}
+
+		pool_created = true;
+		if (!status) {
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to create the event object pool!\n",
+					__FUNCTION__, __LINE__);
+
+			jni_DestroyEventPool(env);
+		}
+	}
+
+	if (status) {
+		__atomic_store_n(&pool_enabled, true, __ATOMIC_SEQ_CST);
+	}
+
+	return status;
+}
+
+void jni_DisableEventPool() {
+	__atomic_store_n(&pool_enabled, false, __ATOMIC_SEQ_CST);
+}
+
+void jni_DestroyEventPool(JNIEnv *env) {
+	jni_DisableEventPool();
+
+	if (pool_created) {
+		int pool, slot;
+		for (pool = 0; pool < EVENT_POOL_COUNT; pool++) {
+			pool_free[pool] = 0;
+
+			for (slot = 0; slot < EVENT_POOL_SIZE; slot++) {
+				if (pool_objects[pool][slot] != NULL) {
+					(*env)->DeleteGlobalRef(env, pool_objects[pool][slot]);
+					pool_objects[pool][slot] = NULL;
+				}
+			}
+		}
+
+		pool_created = false;
+	}
+}
+
+jobject jni_AcquireEventObject(JNIEnv *env, uint8_t event_class) {
+	jobject object = NULL;
+
+	if (__atomic_load_n(&pool_enabled, __ATOMIC_ACQUIRE) && event_class < sizeof(event_pools) && event_pools[event_class] >= 0) {
+		int pool = event_pools[event_class];
+
+		uint64_t free = __atomic_load_n(&pool_free[pool], __ATOMIC_ACQUIRE);
+		int slot = -1;
+		while (free != 0 && slot < 0) {
+			int candidate = __builtin_ctzll(free);
+
+			if (__atomic_compare_exchange_n(&pool_free[pool], &free, free & ~((uint64_t) 1 << candidate),
+					false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+				slot = candidate;
+			}
+		}
+
+		if (slot >= 0) {
+			object = (*env)->NewLocalRef(env, pool_objects[pool][slot]);
+		}
+	}
+
+	return object;
+}
+
+void jni_ReleaseEventObject(jint index) {
+	if (index >= 0 && index < EVENT_POOL_COUNT * EVENT_POOL_SIZE) {
+		uint64_t bit = (uint64_t) 1 << (index % EVENT_POOL_SIZE);
+
+		uint64_t free = __atomic_fetch_or(&pool_free[index / EVENT_POOL_SIZE], bit, __ATOMIC_RELEASE);
+		if (free & bit) {
+			jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Pooled event %i was released twice!\n",
+					__FUNCTION__, __LINE__, index);
+		}
+	}
+}
@@ -0,0 +1,55 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_EventPool_h
+#define _Included_jni_EventPool_h
+
+#include <jni.h>
+#include <stdbool.h>
+#include <uiohook.h>
+
+/* The event pool keeps a fixed number of NativeKeyEvent, NativeMouseEvent
+ * and NativeMouseWheelEvent objects as global references.  While pooling is
+ * enabled, the hook thread reinitializes a free pooled object with
+ * Set*Field instead of running a constructor.  Java returns each pooled
+ * object by its NativeInputEvent.poolIndex once all listeners are finished.
+ * Free slots are tracked with one atomic bitmap per class so neither side
+ * ever waits.
+ */
+
+// The number of pooled objects for each event class.
+#define EVENT_POOL_SIZE			64
+
+// Create the pooled objects if required and start handing them out.
+extern bool jni_EnableEventPool(JNIEnv *env);
+
+// Stop handing out pooled objects.  Objects in use may still be released.
+extern void jni_DisableEventPool();
+
+// Free all of the pooled objects.  This is called when the library unloads.
+extern void jni_DestroyEventPool(JNIEnv *env);
+
+/* Returns a new local reference to a free pooled object for the EVENT_CLASS_*
+ * or NULL if pooling is disabled or every object of that class is in use.
+ */
+extern jobject jni_AcquireEventObject(JNIEnv *env, uint8_t event_class);
+
+// Return the pooled object with the specified pool index.
+extern void jni_ReleaseEventObject(jint index);
+
+#endif
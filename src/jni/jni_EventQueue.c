@@ -0,0 +1,393 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <uiohook.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "jni_Converter.h"
+#include "jni_EventCoalescer.h"
+#include "jni_EventQueue.h"
+#include "jni_Logger.h"
+#include "jni_Statistics.h"
+#include "org_jnativehook_GlobalScreen.h"
+#include "org_jnativehook_keyboard_NativeKeyEvent.h"
+
+// The number of records in the queue, this must be a power of two.
+#define EVENT_QUEUE_CAPACITY	4096
+#define EVENT_QUEUE_MASK		(EVENT_QUEUE_CAPACITY - 1)
+
+#define EVENT_RECORD_SIZE		org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE
+
+// The largest accumulated wheel count that fits in a record.
+#define WHEEL_COUNT_MAX			0xFFFF
+
+// Pack two 32-bit values into a single record slot.
+#define PACK_INT(high, low)		((jlong) (((uint64_t) (uint32_t) (high) << 32) | (uint32_t) (low)))
+
+// Unpack the two 32-bit values from a record slot.
+#define UNPACK_HIGH(slot)		((jint) ((uint64_t) (slot) >> 32))
+#define UNPACK_LOW(slot)		((jint) (uint32_t) (slot))
+
+static jlong queue[EVENT_QUEUE_CAPACITY][EVENT_RECORD_SIZE];
+
+// The head is only written by the consumer and the tail only by the producer.
+static volatile uint32_t queue_head = 0;
+static volatile uint32_t queue_tail = 0;
+
+static volatile bool queue_enabled = false;
+static volatile bool queue_waiting = false;
+
+// The number of consumers currently inside jni_DrainEventQueue().
+static volatile unsigned int queue_active = 0;
+
+// The number of events discarded because the queue was full.
+static volatile uint64_t queue_dropped = 0;
+
+#ifdef _WIN32
+static CRITICAL_SECTION queue_mutex;
+static CONDITION_VARIABLE queue_cond;
+#else
+static pthread_mutex_t queue_mutex;
+static pthread_cond_t queue_cond;
+#endif
+
+int jni_CreateEventQueue() {
+	#ifdef _WIN32
+	InitializeCriticalSection(&queue_mutex);
+	InitializeConditionVariable(&queue_cond);
+	#else
+	pthread_mutex_init(&queue_mutex, NULL);
+	pthread_cond_init(&queue_cond, NULL);
+	#endif
+
+	return JNI_OK;
+}
+
+bool jni_DestroyEventQueue(uint64_t deadline) {
+	jni_DisableEventQueue();
+
+	bool idle;
+	while (!(idle = __atomic_load_n(&queue_active, __ATOMIC_SEQ_CST) == 0) && jni_GetNanoTime() < deadline) {
+		// The consumer may still be copying a batch, check back in a millisecond.
+		#ifdef _WIN32
+		Sleep(1);
+		#else
+		struct timespec duration = { 0, 1000000 };
+		nanosleep(&duration, NULL);
+		#endif
+	}
+
+	if (idle) {
+		#ifdef _WIN32
+		DeleteCriticalSection(&queue_mutex);
+		#else
+		pthread_cond_destroy(&queue_cond);
+		pthread_mutex_destroy(&queue_mutex);
+		#endif
+	}
+	else {
+		// Leak the synchronization objects rather than free them while in use.
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: The event queue consumer did not exit before the deadline!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	return idle;
+}
+
+static void jni_SignalEventQueue() {
+	#ifdef _WIN32
+	EnterCriticalSection(&queue_mutex);
+	WakeConditionVariable(&queue_cond);
+	LeaveCriticalSection(&queue_mutex);
+	#else
+	pthread_mutex_lock(&queue_mutex);
+	pthread_cond_signal(&queue_cond);
+	pthread_mutex_unlock(&queue_mutex);
+	#endif
+}
+
+void jni_EnableEventQueue() {
+	__atomic_store_n(&queue_enabled, true, __ATOMIC_SEQ_CST);
+}
+
+void jni_DisableEventQueue() {
+	__atomic_store_n(&queue_enabled, false, __ATOMIC_SEQ_CST);
+
+	// Wake the consumer so it can observe the change.
+	jni_SignalEventQueue();
+}
+
+void jni_NotifyEventQueue() {
+	if (__atomic_load_n(&queue_waiting, __ATOMIC_SEQ_CST)) {
+		jni_SignalEventQueue();
+	}
+}
+
+bool jni_IsEventQueueEnabled() {
+	return __atomic_load_n(&queue_enabled, __ATOMIC_RELAXED);
+}
+
+// Store an event in the queue record layout.  Returns false for unknown events.
+static bool jni_PackEventRecord(jlong *record, virtual_event * const event, unsigned int count, uint64_t stamp) {
+	bool known = true;
+	jint id, location;
+
+	jni_ConvertToJavaType(event->type, &id);
+
+	record[0] = (jlong) event->time;
+	record[1] = PACK_INT(id, event->mask);
+	record[2] = 0;
+	record[3] = 0;
+	record[4] = 0;
+	record[5] = (jlong) stamp;
+
+	switch (jni_GetEventClass(event->type)) {
+		case EVENT_CLASS_KEY:
+			jni_ConvertToJavaLocation(event->data.keyboard.keycode, &location);
+			if (event->type == EVENT_KEY_TYPED) {
+				record[2] = PACK_INT(event->data.keyboard.rawcode, org_jnativehook_keyboard_NativeKeyEvent_VK_UNDEFINED);
+				record[3] = PACK_INT(event->data.keyboard.keychar, location);
+			}
+			else {
+				record[2] = PACK_INT(event->data.keyboard.rawcode, event->data.keyboard.keycode);
+				record[3] = PACK_INT(org_jnativehook_keyboard_NativeKeyEvent_CHAR_UNDEFINED, location);
+			}
+			break;
+
+		case EVENT_CLASS_MOUSE:
+			record[2] = PACK_INT(event->data.mouse.x, event->data.mouse.y);
+			record[3] = PACK_INT(event->data.mouse.clicks, event->data.mouse.button);
+			break;
+
+		case EVENT_CLASS_MOUSE_MOTION:
+			record[2] = PACK_INT(event->data.mouse.x, event->data.mouse.y);
+			record[3] = PACK_INT(event->data.mouse.clicks, event->data.mouse.button);
+
+			// Motion events carry the number of coalesced native events.
+			record[4] = PACK_INT(0, count);
+			break;
+
+		case EVENT_CLASS_MOUSE_WHEEL:
+			record[2] = PACK_INT(event->data.wheel.x, event->data.wheel.y);
+
+			// Wheel events carry the number of accumulated native events next
+			// to the scroll type.
+			record[3] = PACK_INT(event->data.wheel.clicks, (count < WHEEL_COUNT_MAX ? count : WHEEL_COUNT_MAX) << 16 | event->data.wheel.type);
+			record[4] = PACK_INT(event->data.wheel.amount, event->data.wheel.rotation);
+			break;
+
+		default:
+			// Unknown events are not recorded.
+			known = false;
+			break;
+	}
+
+	return known;
+}
+
+bool jni_PushEventQueue(virtual_event * const event, unsigned int count, uint64_t stamp) {
+	bool status = false;
+
+	uint32_t tail = __atomic_load_n(&queue_tail, __ATOMIC_RELAXED);
+	uint32_t head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+
+	if (tail - head < EVENT_QUEUE_CAPACITY) {
+		bool known = jni_PackEventRecord(queue[tail & EVENT_QUEUE_MASK], event, count, stamp);
+
+		if (known) {
+			// Publish the record to the consumer.
+			__atomic_store_n(&queue_tail, tail + 1, __ATOMIC_SEQ_CST);
+
+			// Only pay for the signal if the consumer is asleep.
+			if (__atomic_load_n(&queue_waiting, __ATOMIC_SEQ_CST)) {
+				jni_SignalEventQueue();
+			}
+		}
+
+		status = true;
+	}
+	else {
+		__atomic_add_fetch(&queue_dropped, 1, __ATOMIC_RELAXED);
+	}
+
+	return status;
+}
+
+jint jni_DrainEventQueue(jlong *out, jsize capacity) {
+	jint count = 0;
+
+	// The counter is raised before the enabled flag is checked so that a
+	// shutdown either waits for this consumer or this consumer never waits.
+	__atomic_add_fetch(&queue_active, 1, __ATOMIC_SEQ_CST);
+
+	if (capacity > 0) {
+		uint32_t head = __atomic_load_n(&queue_head, __ATOMIC_RELAXED);
+		uint32_t tail = __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+
+		// Wait for the producer if the queue is empty.
+		if (head == tail && __atomic_load_n(&queue_enabled, __ATOMIC_SEQ_CST)) {
+			#ifdef _WIN32
+			EnterCriticalSection(&queue_mutex);
+			#else
+			pthread_mutex_lock(&queue_mutex);
+			#endif
+
+			__atomic_store_n(&queue_waiting, true, __ATOMIC_SEQ_CST);
+			while (count == 0 && (tail = __atomic_load_n(&queue_tail, __ATOMIC_SEQ_CST)) == head
+					&& __atomic_load_n(&queue_enabled, __ATOMIC_SEQ_CST)) {
+				// The hook thread only closes a wheel accumulation window when
+				// the next event arrives, so close an idle time window here.
+				uint64_t deadline = jni_GetWheelDeadline();
+				uint64_t now = deadline != 0 ? jni_GetNanoTime() : 0;
+
+				if (deadline == 0) {
+					#ifdef _WIN32
+					SleepConditionVariableCS(&queue_cond, &queue_mutex, INFINITE);
+					#else
+					pthread_cond_wait(&queue_cond, &queue_mutex);
+					#endif
+				}
+				else if (now < deadline) {
+					#ifdef _WIN32
+					SleepConditionVariableCS(&queue_cond, &queue_mutex, (DWORD) ((deadline - now + 999999) / 1000000));
+					#else
+					struct timespec expires;
+					clock_gettime(CLOCK_REALTIME, &expires);
+					uint64_t nanos = (uint64_t) expires.tv_nsec + (deadline - now);
+					expires.tv_sec += (time_t) (nanos / 1000000000);
+					expires.tv_nsec = (long) (nanos % 1000000000);
+
+					pthread_cond_timedwait(&queue_cond, &queue_mutex, &expires);
+					#endif
+				}
+				else {
+					virtual_event wheel;
+					uint64_t wheel_stamp;
+					unsigned int wheel_count;
+
+					// The wheel event is newer than every queued event, and
+					// the queue is empty, so it goes out on its own.
+					if (jni_TakeWheelAccumulation(now, &wheel, &wheel_stamp, &wheel_count)
+							&& jni_PackEventRecord(out, &wheel, wheel_count, wheel_stamp)) {
+						count = 1;
+					}
+				}
+			}
+			__atomic_store_n(&queue_waiting, false, __ATOMIC_SEQ_CST);
+
+			#ifdef _WIN32
+			LeaveCriticalSection(&queue_mutex);
+			#else
+			pthread_mutex_unlock(&queue_mutex);
+			#endif
+		}
+
+		// The count is already set if an expired wheel window was copied
+		// while waiting.
+		if (count == 0 && head == tail) {
+			// The queue was disabled while we were waiting.
+			count = -1;
+		}
+		else if (count == 0) {
+			uint32_t available = tail - head;
+			if (available > (uint32_t) capacity) {
+				available = (uint32_t) capacity;
+			}
+
+			// Copy the records in at most two contiguous chunks.
+			uint32_t start = head & EVENT_QUEUE_MASK;
+			uint32_t first = EVENT_QUEUE_CAPACITY - start;
+			if (first > available) {
+				first = available;
+			}
+
+			memcpy(out, queue[start], first * sizeof(queue[0]));
+			if (available > first) {
+				memcpy(out + first * EVENT_RECORD_SIZE, queue[0], (available - first) * sizeof(queue[0]));
+			}
+
+			// Release the slots back to the producer.
+			__atomic_store_n(&queue_head, head + available, __ATOMIC_RELEASE);
+
+			count = (jint) available;
+		}
+	}
+
+	__atomic_sub_fetch(&queue_active, 1, __ATOMIC_SEQ_CST);
+
+	return count;
+}
+
+uint64_t jni_GetEventQueueDropped() {
+	return __atomic_load_n(&queue_dropped, __ATOMIC_RELAXED);
+}
+
+bool jni_UnpackEventRecord(const jlong *record, virtual_event *event) {
+	bool status = true;
+
+	memset(event, 0, sizeof(virtual_event));
+	event->time = (uint64_t) record[0];
+	event->mask = (uint16_t) UNPACK_LOW(record[1]);
+
+	jni_ConvertToNativeType(UNPACK_HIGH(record[1]), &(event->type));
+
+	switch (jni_GetEventClass(event->type)) {
+		case EVENT_CLASS_KEY:
+			event->data.keyboard.rawcode = (uint16_t) UNPACK_HIGH(record[2]);
+			if (event->type == EVENT_KEY_TYPED) {
+				event->data.keyboard.keychar = (uint16_t) UNPACK_HIGH(record[3]);
+			}
+			else {
+				event->data.keyboard.keycode = (uint16_t) UNPACK_LOW(record[2]);
+			}
+			break;
+
+		case EVENT_CLASS_MOUSE:
+		case EVENT_CLASS_MOUSE_MOTION:
+			event->data.mouse.x = (int16_t) UNPACK_HIGH(record[2]);
+			event->data.mouse.y = (int16_t) UNPACK_LOW(record[2]);
+			event->data.mouse.clicks = (uint16_t) UNPACK_HIGH(record[3]);
+			event->data.mouse.button = (uint16_t) UNPACK_LOW(record[3]);
+			break;
+
+		case EVENT_CLASS_MOUSE_WHEEL:
+			event->data.wheel.x = (int16_t) UNPACK_HIGH(record[2]);
+			event->data.wheel.y = (int16_t) UNPACK_LOW(record[2]);
+			event->data.wheel.clicks = (uint16_t) UNPACK_HIGH(record[3]);
+			event->data.wheel.type = (uint8_t) UNPACK_LOW(record[3]);
+			event->data.wheel.amount = (uint16_t) UNPACK_HIGH(record[4]);
+			event->data.wheel.rotation = (int16_t) UNPACK_LOW(record[4]);
+			break;
+
+		default:
+			status = false;
+			break;
+	}
+
+	return status;
+}
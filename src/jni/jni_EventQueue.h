@@ -0,0 +1,81 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_EventQueue_h
+#define _Included_jni_EventQueue_h
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+/* The native event queue is a single producer, single consumer ring buffer.
+ * The hook thread is the only producer and the GlobalScreen drain thread is
+ * the only consumer.  Each event is stored as a fixed size record of
+ * org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE longs so that a batch of
+ * events can be copied straight into the direct buffer read by Java.
+ */
+
+// Initialize the synchronization objects used by the queue.
+extern int jni_CreateEventQueue();
+
+/* Disable the queue and free the synchronization objects once the consumer has
+ * left jni_DrainEventQueue(), waiting until the jni_GetNanoTime() deadline.
+ * Returns false and leaves the objects allocated if the consumer is still
+ * inside the queue at the deadline.
+ */
+extern bool jni_DestroyEventQueue(uint64_t deadline);
+
+// Start accepting events.
+extern void jni_EnableEventQueue();
+
+// Stop accepting events and wake up a waiting consumer.
+extern void jni_DisableEventQueue();
+
+/* Wake a waiting consumer so that it picks up the deadline of a new wheel
+ * accumulation window.  This is cheap if the consumer is busy.
+ */
+extern void jni_NotifyEventQueue();
+
+// Returns true if the event dispatcher should use the queue.
+extern bool jni_IsEventQueueEnabled();
+
+/* Append an event to the queue.  The count is the number of native events
+ * represented by a coalesced motion event.  The stamp is the jni_GetNanoTime()
+ * capture time, or 0 if the event was not stamped.  Returns false if the queue
+ * is full.
+ */
+extern bool jni_PushEventQueue(virtual_event * const event, unsigned int count, uint64_t stamp);
+
+/* Copy up to capacity records into the out buffer.  This will block until at
+ * least one event is available.  While waiting, an expired wheel accumulation
+ * window is taken from the coalescer and returned as a single record.  Returns
+ * the number of events copied or -1 if the queue was disabled and is empty.
+ */
+extern jint jni_DrainEventQueue(jlong *out, jsize capacity);
+
+// Returns the number of events discarded because the queue was full.
+extern uint64_t jni_GetEventQueueDropped();
+
+/* Convert a record in the queue layout back into a virtual event.  This is
+ * used to inject batches of events supplied by Java.  Returns false if the
+ * record does not contain a known event type.
+ */
+extern bool jni_UnpackEventRecord(const jlong *record, virtual_event *event);
+
+#endif
@@ -0,0 +1,252 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <uiohook.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "jni_EventCapture.h"
+#include "jni_EventReplay.h"
+#include "jni_Logger.h"
+#include "jni_Statistics.h"
+
+// The number of capture bytes read from the file at once.
+#define REPLAY_BUFFER_SIZE		(64 * 1024)
+
+/* The replay thread sleeps until this many nanoseconds before a deadline and
+ * then spins.  This covers the wake up latency of a typical scheduler.  On
+ * Windows the timer resolution is raised to 1 ms for the replay, and a sleep
+ * may still end up to a full tick late.
+ */
+#ifdef _WIN32
+#define REPLAY_SPIN_THRESHOLD	3000000
+#else
+#define REPLAY_SPIN_THRESHOLD	2000000
+#endif
+
+// The Windows timer resolution requested while a replay is running.
+#define REPLAY_TIMER_PERIOD		1
+
+// The longest single sleep so that a cancel request is noticed quickly.
+#define REPLAY_SLEEP_MAX		10000000
+
+static volatile bool replay_active = false;
+static volatile bool replay_cancel = false;
+
+static bool replay_started = false;
+static FILE *replay_file = NULL;
+static double replay_speed = 1.0;
+
+#ifdef _WIN32
+static HANDLE replay_thread = NULL;
+#else
+static pthread_t replay_thread;
+#endif
+
+static void jni_SleepNanos(uint64_t nanos) {
+	#ifdef _WIN32
+	Sleep((DWORD) (nanos / 1000000));
+	#else
+	struct timespec duration;
+	duration.tv_sec = (time_t) (nanos / 1000000000);
+	duration.tv_nsec = (long) (nanos % 1000000000);
+	nanosleep(&duration, NULL);
+	#endif
+}
+
+// Wait until the deadline, returns false if the replay was cancelled.
+static bool jni_WaitUntil(uint64_t deadline) {
+	uint64_t now = jni_GetNanoTime();
+
+	while (now < deadline && !__atomic_load_n(&replay_cancel, __ATOMIC_RELAXED)) {
+		uint64_t remaining = deadline - now;
+
+		if (remaining > REPLAY_SPIN_THRESHOLD) {
+			remaining -= REPLAY_SPIN_THRESHOLD;
+			if (remaining > REPLAY_SLEEP_MAX) {
+				remaining = REPLAY_SLEEP_MAX;
+			}
+
+			jni_SleepNanos(remaining);
+		}
+
+		now = jni_GetNanoTime();
+	}
+
+	return !__atomic_load_n(&replay_cancel, __ATOMIC_RELAXED);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI jni_ReplayProc(LPVOID arg) {
+#else
+static void * jni_ReplayProc(void *arg) {
+#endif
+	#ifdef _WIN32
+	// Sleep() otherwise wakes on the default 15.6 ms timer tick.
+	bool period = timeBeginPeriod(REPLAY_TIMER_PERIOD) == TIMERR_NOERROR;
+	#endif
+
+	uint8_t buffer[REPLAY_BUFFER_SIZE];
+	size_t length = fread(buffer, 1, sizeof(buffer), replay_file);
+	size_t offset = EVENT_CAPTURE_HEADER_SIZE;
+
+	capture_state state;
+	if (length >= EVENT_CAPTURE_HEADER_SIZE && jni_ReadCaptureHeader(buffer, &state)) {
+		bool running = true;
+		bool first = true;
+		uint64_t start_clock = 0, start_time = 0;
+
+		while (running) {
+			// Refill the buffer once a maximum size record may not fit.
+			if (length - offset < 1 + EVENT_CAPTURE_RECORD_MAX && !feof(replay_file)) {
+				memmove(buffer, buffer + offset, length - offset);
+				length -= offset;
+				offset = 0;
+
+				length += fread(buffer + length, 1, sizeof(buffer) - length, replay_file);
+			}
+
+			virtual_event event;
+			size_t used = jni_DecodeCaptureRecord(buffer + offset, length - offset, &state, &event);
+			if (used > 0) {
+				offset += used;
+
+				if (first) {
+					start_clock = jni_GetNanoTime();
+					start_time = event.time;
+					first = false;
+				}
+
+				// Capture timestamps are in milliseconds.
+				uint64_t elapsed = event.time > start_time ? event.time - start_time : 0;
+				uint64_t deadline = start_clock + (uint64_t) ((double) elapsed * 1000000.0 / replay_speed);
+
+				running = jni_WaitUntil(deadline);
+				if (running) {
+					hook_post_event(&event);
+				}
+			}
+			else {
+				if (offset < length) {
+					jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Stopping replay at an invalid capture record!\n",
+							__FUNCTION__, __LINE__);
+				}
+
+				running = false;
+			}
+		}
+	}
+	else {
+		jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Invalid capture file header!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	fclose(replay_file);
+	replay_file = NULL;
+
+	__atomic_store_n(&replay_active, false, __ATOMIC_SEQ_CST);
+
+	#ifdef _WIN32
+	if (period) {
+		timeEndPeriod(REPLAY_TIMER_PERIOD);
+	}
+
+	return 0;
+	#else
+	return NULL;
+	#endif
+}
+
+// Wait for the previous replay thread and release it.
+static void jni_JoinReplayThread() {
+	if (replay_started) {
+		#ifdef _WIN32
+		WaitForSingleObject(replay_thread, INFINITE);
+		CloseHandle(replay_thread);
+		replay_thread = NULL;
+		#else
+		pthread_join(replay_thread, NULL);
+		#endif
+
+		replay_started = false;
+	}
+}
+
+bool jni_StartEventReplay(const char *path, double speed) {
+	bool status = false;
+
+	if (!__atomic_load_n(&replay_active, __ATOMIC_SEQ_CST)) {
+		// A previous replay may have finished on its own.
+		jni_JoinReplayThread();
+
+		replay_file = fopen(path, "rb");
+		if (replay_file != NULL) {
+			replay_speed = speed;
+			__atomic_store_n(&replay_cancel, false, __ATOMIC_SEQ_CST);
+			__atomic_store_n(&replay_active, true, __ATOMIC_SEQ_CST);
+
+			#ifdef _WIN32
+			replay_thread = CreateThread(NULL, 0, jni_ReplayProc, NULL, 0, NULL);
+			replay_started = replay_thread != NULL;
+			#else
+			replay_started = pthread_create(&replay_thread, NULL, jni_ReplayProc, NULL) == 0;
+			#endif
+
+			if (replay_started) {
+				status = true;
+			}
+			else {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to create the replay thread!\n",
+						__FUNCTION__, __LINE__);
+
+				__atomic_store_n(&replay_active, false, __ATOMIC_SEQ_CST);
+				fclose(replay_file);
+				replay_file = NULL;
+			}
+		}
+		else {
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to open the capture file!\n",
+					__FUNCTION__, __LINE__);
+		}
+	}
+	else {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: An event replay is already active!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	return status;
+}
+
+void jni_StopEventReplay() {
+	__atomic_store_n(&replay_cancel, true, __ATOMIC_SEQ_CST);
+	jni_JoinReplayThread();
+}
+
+bool jni_IsEventReplayActive() {
+	return __atomic_load_n(&replay_active, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,40 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_EventReplay_h
+#define _Included_jni_EventReplay_h
+
+#include <stdbool.h>
+
+/* The replay engine streams a capture file written by jni_EventCapture through
+ * hook_post_event() on a dedicated native thread.  The original spacing of the
+ * events is reproduced against a monotonic clock, sleeping until shortly
+ * before each deadline and spinning for the remainder.  The start and stop
+ * functions must not be called concurrently.
+ */
+
+// Open the capture file and start replaying it at the specified speed.
+extern bool jni_StartEventReplay(const char *path, double speed);
+
+// Cancel the active replay and wait for the replay thread to exit.
+extern void jni_StopEventReplay();
+
+// Returns true while the replay thread is posting events.
+extern bool jni_IsEventReplayActive();
+
+#endif
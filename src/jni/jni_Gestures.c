@@ -0,0 +1,189 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <uiohook.h>
+
+#include "jni_Gestures.h"
+#include "org_jnativehook_GlobalScreen.h"
+
+static volatile bool gestures_enabled = false;
+static volatile unsigned int gestures_interval = 500;
+
+// Incremented by Java each time the stage is enabled so the hook thread resets.
+static volatile unsigned int gestures_generation = 0;
+
+/* The remaining state is only used on the hook thread. */
+static unsigned int state_generation = 0;
+
+static bool drag_pressed = false;
+static bool drag_active = false;
+static uint16_t drag_button;
+static int16_t drag_x, drag_y;
+
+static uint16_t click_button = 0;
+static uint16_t click_count = 0;
+static uint64_t click_time;
+static int16_t click_x, click_y;
+
+static bool burst_active = false;
+static gesture_event burst;
+static uint8_t burst_scroll_type;
+
+void jni_SetGestures(bool enabled, unsigned int multi_click_interval) {
+	__atomic_store_n(&gestures_interval, multi_click_interval, __ATOMIC_RELAXED);
+
+	if (enabled && !__atomic_load_n(&gestures_enabled, __ATOMIC_RELAXED)) {
+		__atomic_add_fetch(&gestures_generation, 1, __ATOMIC_RELEASE);
+	}
+	__atomic_store_n(&gestures_enabled, enabled, __ATOMIC_RELEASE);
+}
+
+bool jni_IsGesturesEnabled() {
+	return __atomic_load_n(&gestures_enabled, __ATOMIC_ACQUIRE);
+}
+
+static void jni_ResetGestures() {
+	drag_pressed = false;
+	drag_active = false;
+	click_count = 0;
+	burst_active = false;
+}
+
+static void jni_InitGesture(gesture_event *gesture, jint type, virtual_event * const event, int16_t x, int16_t y, uint16_t button) {
+	memset(gesture, 0, sizeof(gesture_event));
+	gesture->type = type;
+	gesture->time = event->time;
+	gesture->mask = event->mask;
+	gesture->x = x;
+	gesture->y = y;
+	gesture->button = button;
+}
+
+unsigned int jni_ProcessGestures(virtual_event * const event, gesture_event *gestures) {
+	unsigned int count = 0;
+
+	unsigned int generation = __atomic_load_n(&gestures_generation, __ATOMIC_ACQUIRE);
+	if (generation != state_generation) {
+		state_generation = generation;
+		jni_ResetGestures();
+	}
+
+	// Any other kind of event, a change of direction or a pause ends a burst.
+	if (burst_active) {
+		bool extend = event->type == EVENT_MOUSE_WHEEL
+				&& event->data.wheel.type == burst_scroll_type
+				&& (event->data.wheel.rotation < 0) == (burst.rotation < 0)
+				&& event->time - burst.time <= GESTURE_WHEEL_GAP;
+
+		if (!extend) {
+			gestures[count++] = burst;
+			burst_active = false;
+		}
+	}
+
+	switch (event->type) {
+		case EVENT_MOUSE_WHEEL:
+			if (!burst_active) {
+				jni_InitGesture(&burst, org_jnativehook_GlobalScreen_GESTURE_WHEEL_BURST, event,
+						event->data.wheel.x, event->data.wheel.y, 0);
+				burst_scroll_type = event->data.wheel.type;
+				burst_active = true;
+			}
+
+			// The burst time tracks the latest event to measure the gap.
+			burst.time = event->time;
+			burst.mask = event->mask;
+			burst.count++;
+			burst.rotation += event->data.wheel.rotation * event->data.wheel.amount;
+			break;
+
+		case EVENT_MOUSE_PRESSED:
+			drag_pressed = true;
+			drag_active = false;
+			drag_button = event->data.mouse.button;
+			drag_x = event->data.mouse.x;
+			drag_y = event->data.mouse.y;
+			break;
+
+		case EVENT_MOUSE_DRAGGED:
+			if (drag_pressed && !drag_active
+					&& (abs(event->data.mouse.x - drag_x) >= GESTURE_DRAG_THRESHOLD
+					|| abs(event->data.mouse.y - drag_y) >= GESTURE_DRAG_THRESHOLD)) {
+				drag_active = true;
+
+				jni_InitGesture(&gestures[count], org_jnativehook_GlobalScreen_GESTURE_DRAG_STARTED, event,
+						drag_x, drag_y, drag_button);
+				gestures[count].delta_x = event->data.mouse.x - drag_x;
+				gestures[count].delta_y = event->data.mouse.y - drag_y;
+				count++;
+			}
+			break;
+
+		case EVENT_MOUSE_RELEASED:
+			if (drag_pressed && event->data.mouse.button == drag_button) {
+				if (drag_active) {
+					jni_InitGesture(&gestures[count], org_jnativehook_GlobalScreen_GESTURE_DRAG_ENDED, event,
+							event->data.mouse.x, event->data.mouse.y, drag_button);
+					gestures[count].delta_x = event->data.mouse.x - drag_x;
+					gestures[count].delta_y = event->data.mouse.y - drag_y;
+					count++;
+
+					// A drag is never part of a multi click.
+					click_count = 0;
+				}
+
+				drag_pressed = false;
+				drag_active = false;
+			}
+			break;
+
+		case EVENT_MOUSE_CLICKED:
+			if (click_count > 0
+					&& event->data.mouse.button == click_button
+					&& event->time - click_time <= __atomic_load_n(&gestures_interval, __ATOMIC_RELAXED)
+					&& abs(event->data.mouse.x - click_x) < GESTURE_DRAG_THRESHOLD
+					&& abs(event->data.mouse.y - click_y) < GESTURE_DRAG_THRESHOLD) {
+				click_count++;
+			}
+			else {
+				click_count = 1;
+			}
+
+			click_button = event->data.mouse.button;
+			click_time = event->time;
+			click_x = event->data.mouse.x;
+			click_y = event->data.mouse.y;
+
+			if (click_count >= 2) {
+				jni_InitGesture(&gestures[count], org_jnativehook_GlobalScreen_GESTURE_MULTI_CLICKED, event,
+						event->data.mouse.x, event->data.mouse.y, click_button);
+				gestures[count].count = click_count;
+				count++;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return count;
+}
@@ -0,0 +1,79 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_Gestures_h
+#define _Included_jni_Gestures_h
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+/* The gesture stage runs on the hook thread ahead of the event mask and
+ * aggregates raw mouse events into a few high level gestures:
+ *
+ * GESTURE_DRAG_STARTED		once a pressed button moves GESTURE_DRAG_THRESHOLD
+ * 							pixels, with the press position and delta.
+ * GESTURE_DRAG_ENDED		when the button is released, with the total delta.
+ * GESTURE_MULTI_CLICKED	for the second and later click of the same button
+ * 							within the multi click interval, with the count.
+ * GESTURE_WHEEL_BURST		for consecutive wheel events of the same type and
+ * 							direction, with the summed rotation.  A burst ends
+ * 							with the next event of any other kind or the first
+ * 							wheel event after GESTURE_WHEEL_GAP milliseconds.
+ *
+ * Gestures are produced in addition to the raw events, which are still
+ * delivered to any raw listeners.
+ */
+
+// The distance in pixels a pressed button must move to start a drag.
+#define GESTURE_DRAG_THRESHOLD	4
+
+// The longest pause in milliseconds between two events of a wheel burst.
+#define GESTURE_WHEEL_GAP		150
+
+// The maximum number of gestures produced by a single native event.
+#define GESTURE_MAX				2
+
+typedef struct _gesture_event {
+	jint type;
+	uint64_t time;
+	uint16_t mask;
+	int16_t x;
+	int16_t y;
+	uint16_t button;
+	uint16_t count;
+	int32_t delta_x;
+	int32_t delta_y;
+	int32_t rotation;
+} gesture_event;
+
+/* Enable or disable the gesture stage.  The multi click interval is in
+ * milliseconds and is refreshed by Java when the native settings change.
+ */
+extern void jni_SetGestures(bool enabled, unsigned int multi_click_interval);
+
+// Returns true if the gesture stage is enabled.
+extern bool jni_IsGesturesEnabled();
+
+/* Feed a native event to the gesture stage.  Up to GESTURE_MAX completed
+ * gestures are copied into gestures.  Returns the number of gestures.
+ */
+extern unsigned int jni_ProcessGestures(virtual_event * const event, gesture_event *gestures);
+
+#endif
@@ -17,8 +17,15 @@
  */
 
 #include <jni.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "jni_Errors.h"
 #include "jni_Globals.h"
 #include "jni_Logger.h"
@@ -28,20 +35,122 @@ NativeInputEvent *org_jnativehook_NativeInputEvent = NULL;
 NativeKeyEvent *org_jnativehook_keyboard_NativeKeyEvent = NULL;
 NativeMouseEvent *org_jnativehook_mouse_NativeMouseEvent = NULL;
 NativeMouseWheelEvent *org_jnativehook_mouse_NativeMouseWheelEvent = NULL;
-System *java_lang_System = NULL;
 Logger *java_util_logging_Logger = NULL;
+Level *java_util_logging_Level = NULL;
+
+jobject org_jnativehook_GlobalScreen_object = NULL;
+jobject java_util_logging_Logger_object = NULL;
+
+// Thread local storage for the JNI interface pointer of attached threads.
+#ifdef _WIN32
+static DWORD env_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t env_key;
+#endif
+static bool env_key_created = false;
+
+// Called by the thread local storage when an attached thread exits.
+#ifdef _WIN32
+static VOID WINAPI jni_DetachThread(PVOID data) {
+#else
+static void jni_DetachThread(void *data) {
+#endif
+	if (data != NULL && jvm != NULL) {
+		(*jvm)->DetachCurrentThread(jvm);
+	}
+}
+
+jint jni_GetEnv(JNIEnv **env, const char *name) {
+	jint status = JNI_ERR;
+
+	// Check for a thread we have already attached.
+	*env = NULL;
+	if (env_key_created) {
+		#ifdef _WIN32
+		*env = (JNIEnv *) FlsGetValue(env_key);
+		#else
+		*env = (JNIEnv *) pthread_getspecific(env_key);
+		#endif
+	}
+
+	if (*env != NULL) {
+		status = JNI_OK;
+	}
+	else {
+		status = (*jvm)->GetEnv(jvm, (void **)(env), jni_version);
+
+		if (status == JNI_EDETACHED) {
+			// Daemon threads will not prevent the virtual machine from exiting.
+			JavaVMAttachArgs args = {
+				.version = jni_version,
+				.name = (char *) (name != NULL ? name : "JNativeHook Native Thread"),
+				.group = NULL
+			};
+
+			status = (*jvm)->AttachCurrentThreadAsDaemon(jvm, (void **)(env), &args);
+			if (status == JNI_OK && env_key_created) {
+				#ifdef _WIN32
+				FlsSetValue(env_key, *env);
+				#else
+				pthread_setspecific(env_key, *env);
+				#endif
+			}
+		}
+	}
+
+	return status;
+}
+
+// Create a global reference to one of the java.util.logging.Level constants.
+static jobject jni_GetLevelConstant(JNIEnv *env, const char *name) {
+	jobject Level_object = NULL;
+
+	// A failed lookup leaves NoSuchFieldError pending, which fails jni_CreateGlobals().
+	jfieldID field = NULL;
+	if ((*env)->ExceptionCheck(env) == JNI_FALSE) {
+		field = (*env)->GetStaticFieldID(env, java_util_logging_Level->cls, name, "Ljava/util/logging/Level;");
+	}
+
+	if (field != NULL) {
+		jobject constant = (*env)->GetStaticObjectField(env, java_util_logging_Level->cls, field);
+		if (constant != NULL) {
+			Level_object = (*env)->NewGlobalRef(env, constant);
+			(*env)->DeleteLocalRef(env, constant);
+		}
+	}
+
+	if (Level_object == NULL) {
+		jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire Level.%s!\n",
+				__FUNCTION__, __LINE__, name);
+	}
+
+	return Level_object;
+}
 
 int jni_CreateGlobals(JNIEnv *env) {
 	int status = JNI_ERR;
 
+	// Set once every Level constant used by jni_UpdateLogLevel() was found.
+	bool levels = false;
+
+	// Create the thread local storage used by jni_GetEnv().
+	if (!env_key_created) {
+		#ifdef _WIN32
+		env_key = FlsAlloc(&jni_DetachThread);
+		env_key_created = (env_key != FLS_OUT_OF_INDEXES);
+		#else
+		env_key_created = (pthread_key_create(&env_key, &jni_DetachThread) == 0);
+		#endif
+	}
+
 	// Allocate memory for the Java object structure representation.
 	org_jnativehook_GlobalScreen = malloc(sizeof(GlobalScreen));
 	org_jnativehook_NativeInputEvent = malloc(sizeof(NativeInputEvent));
 	org_jnativehook_keyboard_NativeKeyEvent = malloc(sizeof(NativeKeyEvent));
 	org_jnativehook_mouse_NativeMouseEvent = malloc(sizeof(NativeMouseEvent));
 	org_jnativehook_mouse_NativeMouseWheelEvent = malloc(sizeof(NativeMouseWheelEvent));
-	java_lang_System = malloc(sizeof(System));
 	java_util_logging_Logger = malloc(sizeof(Logger));
+	java_util_logging_Level = malloc(sizeof(Level));
 
 	// Check to make sure memory was allocated properly.
 	if (org_jnativehook_GlobalScreen != NULL
@@ -49,8 +158,8 @@ int jni_CreateGlobals(JNIEnv *env) {
 			&& org_jnativehook_keyboard_NativeKeyEvent != NULL
 			&& org_jnativehook_mouse_NativeMouseEvent != NULL
 			&& org_jnativehook_mouse_NativeMouseWheelEvent != NULL
-			&& java_lang_System != NULL
-			&& java_util_logging_Logger != NULL) {
+			&& java_util_logging_Logger != NULL
+			&& java_util_logging_Level != NULL) {
 
 		// Lookup a local reference for the GlobalScreen class and create a global reference.
 		jclass GlobalScreen_class = (*env)->FindClass(env, "org/jnativehook/GlobalScreen");
@@ -81,6 +190,71 @@ int jni_CreateGlobals(JNIEnv *env) {
 				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for GlobalScreen.dispatchEvent(Lorg/jnativehook/NativeInputEvent;)V!\n",
 						__FUNCTION__, __LINE__);
 			}
+
+
+			// Get the method ID for GlobalScreen.dispatchHotkey().
+			org_jnativehook_GlobalScreen->dispatchHotkey = (*env)->GetMethodID(
+					env,
+					org_jnativehook_GlobalScreen->cls,
+					"dispatchHotkey",
+					"(I)V");
+
+			if (org_jnativehook_GlobalScreen->dispatchHotkey == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for GlobalScreen.dispatchHotkey(I)V!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the method ID for GlobalScreen.dispatchGesture().
+			org_jnativehook_GlobalScreen->dispatchGesture = (*env)->GetMethodID(
+					env,
+					org_jnativehook_GlobalScreen->cls,
+					"dispatchGesture",
+					"(IJIIIIIIII)V");
+
+			if (org_jnativehook_GlobalScreen->dispatchGesture == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for GlobalScreen.dispatchGesture(IJIIIIIIII)V!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the method ID for GlobalScreen.dispatchKeyPrimitive().
+			org_jnativehook_GlobalScreen->dispatchKeyPrimitive = (*env)->GetMethodID(
+					env,
+					org_jnativehook_GlobalScreen->cls,
+					"dispatchKeyPrimitive",
+					"(IIIIJ)V");
+
+			if (org_jnativehook_GlobalScreen->dispatchKeyPrimitive == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for GlobalScreen.dispatchKeyPrimitive(IIIIJ)V!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the method ID for GlobalScreen.dispatchMousePrimitive().
+			org_jnativehook_GlobalScreen->dispatchMousePrimitive = (*env)->GetMethodID(
+					env,
+					org_jnativehook_GlobalScreen->cls,
+					"dispatchMousePrimitive",
+					"(IIIIIJ)V");
+
+			if (org_jnativehook_GlobalScreen->dispatchMousePrimitive == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for GlobalScreen.dispatchMousePrimitive(IIIIIJ)V!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the method ID for GlobalScreen.settingsChanged().
+			org_jnativehook_GlobalScreen->settingsChanged = (*env)->GetStaticMethodID(
+					env,
+					org_jnativehook_GlobalScreen->cls,
+					"settingsChanged",
+					"()V");
+
+			if (org_jnativehook_GlobalScreen->settingsChanged == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for GlobalScreen.settingsChanged()V!\n",
+						__FUNCTION__, __LINE__);
+			}
 		}
 		else {
 			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to locate the GlobalScreen class!\n",
@@ -106,6 +280,19 @@ int jni_CreateGlobals(JNIEnv *env) {
 			}
 
 
+			// Get the field ID for NativeInputEvent.poolIndex.
+			org_jnativehook_NativeInputEvent->poolIndex = (*env)->GetFieldID(
+					env,
+					org_jnativehook_NativeInputEvent->cls,
+					"poolIndex",
+					"I");
+
+			if (org_jnativehook_NativeInputEvent->poolIndex == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeInputEvent.poolIndex I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
 			// Get the method ID for NativeInputEvent constructor.
 			org_jnativehook_NativeInputEvent->init = (*env)->GetMethodID(
 					env,
@@ -119,28 +306,65 @@ int jni_CreateGlobals(JNIEnv *env) {
 			}
 
 
-			// Get the method ID for NativeInputEvent.getID().
-			org_jnativehook_NativeInputEvent->getID = (*env)->GetMethodID(
+			// Get the field ID for NativeInputEvent.id.
+			org_jnativehook_NativeInputEvent->id = (*env)->GetFieldID(
+					env,
+					org_jnativehook_NativeInputEvent->cls,
+					"id",
+					"I");
+
+			if (org_jnativehook_NativeInputEvent->id == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeInputEvent.id I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the field ID for NativeInputEvent.when.
+			org_jnativehook_NativeInputEvent->when = (*env)->GetFieldID(
 					env,
 					org_jnativehook_NativeInputEvent->cls,
-					"getID",
-					"()I");
+					"when",
+					"J");
 
-			if (org_jnativehook_NativeInputEvent->getID == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeInputEvent.getID()I!\n",
+			if (org_jnativehook_NativeInputEvent->when == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeInputEvent.when J!\n",
 						__FUNCTION__, __LINE__);
 			}
 
 
-			// Get the method ID for NativeInputEvent.getModifiers().
-			org_jnativehook_NativeInputEvent->getModifiers = (*env)->GetMethodID(
+			// Get the field ID for NativeInputEvent.modifiers.
+			org_jnativehook_NativeInputEvent->modifiers = (*env)->GetFieldID(
 					env,
 					org_jnativehook_NativeInputEvent->cls,
-					"getModifiers",
-					"()I");
+					"modifiers",
+					"I");
 
-			if (org_jnativehook_NativeInputEvent->getModifiers == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeInputEvent.getModifiers()I!\n",
+			if (org_jnativehook_NativeInputEvent->modifiers == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeInputEvent.modifiers I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+			// Get the field ID for NativeInputEvent.captureTime.
+			org_jnativehook_NativeInputEvent->captureTime = (*env)->GetFieldID(
+					env,
+					org_jnativehook_NativeInputEvent->cls,
+					"captureTime",
+					"J");
+
+			if (org_jnativehook_NativeInputEvent->captureTime == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeInputEvent.captureTime J!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+			// Get the field ID for NativeInputEvent.dispatchTime.
+			org_jnativehook_NativeInputEvent->dispatchTime = (*env)->GetFieldID(
+					env,
+					org_jnativehook_NativeInputEvent->cls,
+					"dispatchTime",
+					"J");
+
+			if (org_jnativehook_NativeInputEvent->dispatchTime == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeInputEvent.dispatchTime J!\n",
 						__FUNCTION__, __LINE__);
 			}
 		}
@@ -171,41 +395,54 @@ int jni_CreateGlobals(JNIEnv *env) {
 			}
 
 			
-			// Get the method ID for NativeKeyEvent.getKeyCode().
-			org_jnativehook_keyboard_NativeKeyEvent->getKeyCode = (*env)->GetMethodID(
+			// Get the field ID for NativeKeyEvent.rawCode.
+			org_jnativehook_keyboard_NativeKeyEvent->rawCode = (*env)->GetFieldID(
+					env,
+					org_jnativehook_keyboard_NativeKeyEvent->cls,
+					"rawCode",
+					"I");
+
+			if (org_jnativehook_keyboard_NativeKeyEvent->rawCode == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeKeyEvent.rawCode I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the field ID for NativeKeyEvent.keyCode.
+			org_jnativehook_keyboard_NativeKeyEvent->keyCode = (*env)->GetFieldID(
 					env,
 					org_jnativehook_keyboard_NativeKeyEvent->cls,
-					"getKeyCode",
-					"()I");
+					"keyCode",
+					"I");
 
-			if (org_jnativehook_keyboard_NativeKeyEvent->getKeyCode == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeKeyEvent.getKeyCode()!\n",
+			if (org_jnativehook_keyboard_NativeKeyEvent->keyCode == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeKeyEvent.keyCode I!\n",
 						__FUNCTION__, __LINE__);
 			}
 
 
-			// Get the method ID for NativeKeyEvent.getKeyLocation().
-			org_jnativehook_keyboard_NativeKeyEvent->getKeyLocation = (*env)->GetMethodID(
+			// Get the field ID for NativeKeyEvent.keyChar.
+			org_jnativehook_keyboard_NativeKeyEvent->keyChar = (*env)->GetFieldID(
 					env,
 					org_jnativehook_keyboard_NativeKeyEvent->cls,
-					"getKeyLocation",
-					"()I");
+					"keyChar",
+					"C");
 
-			if (org_jnativehook_keyboard_NativeKeyEvent->getKeyLocation == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeKeyEvent.getKeyLocation()!\n",
+			if (org_jnativehook_keyboard_NativeKeyEvent->keyChar == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeKeyEvent.keyChar C!\n",
 						__FUNCTION__, __LINE__);
 			}
 
 
-			// Get the method ID for NativeKeyEvent.getKeyChar().
-			org_jnativehook_keyboard_NativeKeyEvent->getKeyChar = (*env)->GetMethodID(
+			// Get the field ID for NativeKeyEvent.keyLocation.
+			org_jnativehook_keyboard_NativeKeyEvent->keyLocation = (*env)->GetFieldID(
 					env,
 					org_jnativehook_keyboard_NativeKeyEvent->cls,
-					"getKeyChar",
-					"()C");
+					"keyLocation",
+					"I");
 
-			if (org_jnativehook_keyboard_NativeKeyEvent->getKeyChar == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeKeyEvent.getKeyChar()!\n",
+			if (org_jnativehook_keyboard_NativeKeyEvent->keyLocation == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeKeyEvent.keyLocation I!\n",
 						__FUNCTION__, __LINE__);
 			}
 		}
@@ -235,16 +472,67 @@ int jni_CreateGlobals(JNIEnv *env) {
 						__FUNCTION__, __LINE__);
 			}
 
+			// Get the field ID for NativeMouseEvent.coalescedCount.
+			org_jnativehook_mouse_NativeMouseEvent->coalescedCount = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseEvent->cls,
+					"coalescedCount",
+					"I");
+
+			if (org_jnativehook_mouse_NativeMouseEvent->coalescedCount == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseEvent.coalescedCount!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the field ID for NativeMouseEvent.x.
+			org_jnativehook_mouse_NativeMouseEvent->x = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseEvent->cls,
+					"x",
+					"I");
+
+			if (org_jnativehook_mouse_NativeMouseEvent->x == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseEvent.x I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the field ID for NativeMouseEvent.y.
+			org_jnativehook_mouse_NativeMouseEvent->y = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseEvent->cls,
+					"y",
+					"I");
+
+			if (org_jnativehook_mouse_NativeMouseEvent->y == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseEvent.y I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the field ID for NativeMouseEvent.clickCount.
+			org_jnativehook_mouse_NativeMouseEvent->clickCount = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseEvent->cls,
+					"clickCount",
+					"I");
+
+			if (org_jnativehook_mouse_NativeMouseEvent->clickCount == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseEvent.clickCount I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
 
-			// Get the method ID for NativeKeyEvent.getKeyCode().
-			org_jnativehook_mouse_NativeMouseEvent->getButton = (*env)->GetMethodID(
+			// Get the field ID for NativeMouseEvent.button.
+			org_jnativehook_mouse_NativeMouseEvent->button = (*env)->GetFieldID(
 					env,
 					org_jnativehook_mouse_NativeMouseEvent->cls,
-					"getButton",
-					"()I");
+					"button",
+					"I");
 
-			if (org_jnativehook_keyboard_NativeKeyEvent->getKeyCode == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeKeyEvent.getKeyCode()!\n",
+			if (org_jnativehook_mouse_NativeMouseEvent->button == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseEvent.button I!\n",
 						__FUNCTION__, __LINE__);
 			}
 		}
@@ -273,49 +561,52 @@ int jni_CreateGlobals(JNIEnv *env) {
 				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for NativeMouseEvent.<init>(IJIIIIIII)V!\n",
 						__FUNCTION__, __LINE__);
 			}
-		}
-		else {
-			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to locate the NativeMouseWheelEvent class!\n",
-					__FUNCTION__, __LINE__);
-		}
 
-		
-		// Class and Constructor for the Logger Object.
-		jclass System_class = (*env)->FindClass(env, "java/lang/System");
-		if (System_class != NULL) {
-			java_lang_System->cls = (jclass) (*env)->NewGlobalRef(env, System_class);
-			
-			// Get the method ID for System.setProperty().
-			java_lang_System->setProperty = (*env)->GetStaticMethodID(
-					env, 
-					java_lang_System->cls, 
-					"setProperty", 
-					"(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;");
 
-			if (java_lang_System->setProperty == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for System.setProperty(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;!\n",
+			// Get the field ID for NativeMouseWheelEvent.scrollType.
+			org_jnativehook_mouse_NativeMouseWheelEvent->scrollType = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseWheelEvent->cls,
+					"scrollType",
+					"I");
+
+			if (org_jnativehook_mouse_NativeMouseWheelEvent->scrollType == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseWheelEvent.scrollType I!\n",
 						__FUNCTION__, __LINE__);
 			}
 
 
-			// Get the method ID for System.setProperty().
-			java_lang_System->clearProperty = (*env)->GetStaticMethodID(
-					env, 
-					java_lang_System->cls, 
-					"clearProperty", 
-					"(Ljava/lang/String;)Ljava/lang/String;");
+			// Get the field ID for NativeMouseWheelEvent.scrollAmount.
+			org_jnativehook_mouse_NativeMouseWheelEvent->scrollAmount = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseWheelEvent->cls,
+					"scrollAmount",
+					"I");
+
+			if (org_jnativehook_mouse_NativeMouseWheelEvent->scrollAmount == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseWheelEvent.scrollAmount I!\n",
+						__FUNCTION__, __LINE__);
+			}
+
+
+			// Get the field ID for NativeMouseWheelEvent.wheelRotation.
+			org_jnativehook_mouse_NativeMouseWheelEvent->wheelRotation = (*env)->GetFieldID(
+					env,
+					org_jnativehook_mouse_NativeMouseWheelEvent->cls,
+					"wheelRotation",
+					"I");
 
-			if (java_lang_System->clearProperty == NULL) {
-				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for System.clearProperty(Ljava/lang/String;)Ljava/lang/String;!\n",
+			if (org_jnativehook_mouse_NativeMouseWheelEvent->wheelRotation == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the field ID for NativeMouseWheelEvent.wheelRotation I!\n",
 						__FUNCTION__, __LINE__);
 			}
 		}
 		else {
-			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to locate the System class!\n",
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to locate the NativeMouseWheelEvent class!\n",
 					__FUNCTION__, __LINE__);
 		}
 
-
+		
 		// Class and Constructor for the Logger Object.
 		jclass Logger_class = (*env)->FindClass(env, "java/util/logging/Logger");
 		if (Logger_class != NULL) {
@@ -333,6 +624,17 @@ int jni_CreateGlobals(JNIEnv *env) {
 						__FUNCTION__, __LINE__);
 			}
 
+			java_util_logging_Logger->isLoggable = (*env)->GetMethodID(
+					env,
+					java_util_logging_Logger->cls,
+					"isLoggable",
+					"(Ljava/util/logging/Level;)Z");
+
+			if (java_util_logging_Logger->isLoggable == NULL) {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the method ID for Logger.isLoggable(Ljava/util/logging/Level;)Z!\n",
+						__FUNCTION__, __LINE__);
+			}
+
 			
 			java_util_logging_Logger->fine = (*env)->GetMethodID(
 					env, 
@@ -382,6 +684,50 @@ int jni_CreateGlobals(JNIEnv *env) {
 			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to locate the Logger class!\n",
 					__FUNCTION__, __LINE__);
 		}
+
+		// Class and constants for the Level Object.
+		jclass Level_class = (*env)->FindClass(env, "java/util/logging/Level");
+		if (Level_class != NULL) {
+			java_util_logging_Level->cls = (jclass) (*env)->NewGlobalRef(env, Level_class);
+
+			java_util_logging_Level->FINE = jni_GetLevelConstant(env, "FINE");
+			java_util_logging_Level->INFO = jni_GetLevelConstant(env, "INFO");
+			java_util_logging_Level->WARNING = jni_GetLevelConstant(env, "WARNING");
+			java_util_logging_Level->SEVERE = jni_GetLevelConstant(env, "SEVERE");
+
+			levels = java_util_logging_Level->FINE != NULL
+					&& java_util_logging_Level->INFO != NULL
+					&& java_util_logging_Level->WARNING != NULL
+					&& java_util_logging_Level->SEVERE != NULL;
+		}
+		else {
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to locate the Level class!\n",
+					__FUNCTION__, __LINE__);
+		}
+
+		// Resolve the logger used for native messages once.  The logger level
+		// can only be mirrored if all of the Level constants are available.
+		if (levels && java_util_logging_Logger->getLogger != NULL) {
+			jstring name = (*env)->NewStringUTF(env, "org.jnativehook");
+			jobject Logger_object = (*env)->CallStaticObjectMethod(
+					env,
+					java_util_logging_Logger->cls,
+					java_util_logging_Logger->getLogger,
+					name);
+
+			if (Logger_object != NULL) {
+				java_util_logging_Logger_object = (*env)->NewGlobalRef(env, Logger_object);
+				(*env)->DeleteLocalRef(env, Logger_object);
+
+				// Mirror the current level so disabled messages are discarded early.
+				jni_UpdateLogLevel(env);
+			}
+			else {
+				jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire the org.jnativehook logger!\n",
+						__FUNCTION__, __LINE__);
+			}
+			(*env)->DeleteLocalRef(env, name);
+		}
 	}
 	else {
 		status = JNI_ENOMEM;
@@ -393,14 +739,46 @@ int jni_CreateGlobals(JNIEnv *env) {
 	}
 
 	// Check and make sure everything is correct.
-	if ((*env)->ExceptionCheck(env) == JNI_FALSE) {
+	if ((*env)->ExceptionCheck(env) == JNI_FALSE && levels) {
 		status = JNI_OK;
 	}
 
 	return status;
 }
 
+int jni_CreateGlobalScreenObject(JNIEnv *env) {
+	int status = JNI_OK;
+
+	// The singleton never changes so it only needs to be resolved once.
+	if (org_jnativehook_GlobalScreen_object == NULL) {
+		jobject GlobalScreen_object = (*env)->CallStaticObjectMethod(
+				env,
+				org_jnativehook_GlobalScreen->cls,
+				org_jnativehook_GlobalScreen->getInstance);
+
+		if (GlobalScreen_object != NULL) {
+			org_jnativehook_GlobalScreen_object = (*env)->NewGlobalRef(env, GlobalScreen_object);
+			(*env)->DeleteLocalRef(env, GlobalScreen_object);
+		}
+
+		if (org_jnativehook_GlobalScreen_object == NULL) {
+			status = JNI_ERR;
+
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to acquire GlobalScreen singleton!\n",
+					__FUNCTION__, __LINE__);
+		}
+	}
+
+	return status;
+}
+
 int jni_DestroyGlobals(JNIEnv *env) {
+	// Free the global reference to the GlobalScreen singleton.
+	if (org_jnativehook_GlobalScreen_object != NULL) {
+		(*env)->DeleteGlobalRef(env, org_jnativehook_GlobalScreen_object);
+		org_jnativehook_GlobalScreen_object = NULL;
+	}
+
 	// Free any memory being used for Java object structures.
 	if (org_jnativehook_GlobalScreen != NULL) {
 		(*env)->DeleteGlobalRef(env, org_jnativehook_GlobalScreen->cls);
@@ -432,10 +810,9 @@ int jni_DestroyGlobals(JNIEnv *env) {
 		org_jnativehook_mouse_NativeMouseWheelEvent = NULL;
 	}
 
-	if (java_lang_System != NULL) {
-		(*env)->DeleteGlobalRef(env, java_lang_System->cls);
-		free(java_lang_System);
-		java_lang_System = NULL;
+	if (java_util_logging_Logger_object != NULL) {
+		(*env)->DeleteGlobalRef(env, java_util_logging_Logger_object);
+		java_util_logging_Logger_object = NULL;
 	}
 
 	if (java_util_logging_Logger != NULL) {
@@ -444,5 +821,25 @@ int jni_DestroyGlobals(JNIEnv *env) {
 		java_util_logging_Logger = NULL;
 	}
 
+	if (java_util_logging_Level != NULL) {
+		(*env)->DeleteGlobalRef(env, java_util_logging_Level->FINE);
+		(*env)->DeleteGlobalRef(env, java_util_logging_Level->INFO);
+		(*env)->DeleteGlobalRef(env, java_util_logging_Level->WARNING);
+		(*env)->DeleteGlobalRef(env, java_util_logging_Level->SEVERE);
+		(*env)->DeleteGlobalRef(env, java_util_logging_Level->cls);
+		free(java_util_logging_Level);
+		java_util_logging_Level = NULL;
+	}
+
+	// Free the thread local storage used by jni_GetEnv().
+	if (env_key_created) {
+		#ifdef _WIN32
+		FlsFree(env_key);
+		#else
+		pthread_key_delete(env_key);
+		#endif
+		env_key_created = false;
+	}
+
 	return JNI_OK;
 }
@@ -37,61 +37,93 @@ typedef struct _org_jnativehook_GlobalScreen {
 	jclass cls;
 	jmethodID getInstance;
 	jmethodID dispatchEvent;
+	jmethodID dispatchHotkey;
+	jmethodID dispatchGesture;
+	jmethodID dispatchKeyPrimitive;
+	jmethodID dispatchMousePrimitive;
+	jmethodID settingsChanged;
 } GlobalScreen;
 
 typedef struct _org_jnativehook_NativeInputEvent {
 	jclass cls;
 	jfieldID reserved;
+	jfieldID poolIndex;
 	jmethodID init;
-	jmethodID getID;
-	jmethodID getModifiers;
+	jfieldID id;
+	jfieldID when;
+	jfieldID modifiers;
+	jfieldID captureTime;
+	jfieldID dispatchTime;
 } NativeInputEvent;
 
 typedef struct _org_jnativehook_keyboard_NativeKeyEvent {
 	jclass cls;
 	jmethodID init;
 	NativeInputEvent *parent;
-	jmethodID getKeyCode;
-	jmethodID getKeyLocation;
-	jmethodID getKeyChar;
+	jfieldID rawCode;
+	jfieldID keyCode;
+	jfieldID keyChar;
+	jfieldID keyLocation;
 } NativeKeyEvent;
 
 typedef struct _org_jnativehook_mouse_NativeMouseEvent {
 	jclass cls;
 	jmethodID init;
 	NativeInputEvent *parent;
-	jmethodID getButton;
+	jfieldID coalescedCount;
+	jfieldID x;
+	jfieldID y;
+	jfieldID clickCount;
+	jfieldID button;
 } NativeMouseEvent;
 
 typedef struct _org_jnativehook_mouse_NativeMouseWheelEvent {
 	jclass cls;
 	jmethodID init;
 	NativeMouseEvent *parent;
+	jfieldID scrollType;
+	jfieldID scrollAmount;
+	jfieldID wheelRotation;
 } NativeMouseWheelEvent;
 
-typedef struct _java_lang_System {
-	jclass cls;
-	jmethodID setProperty;
-	jmethodID clearProperty;
-} System;
-
 typedef struct _java_util_logging_Logger {
 	jclass cls;
 	jmethodID getLogger;
+	jmethodID isLoggable;
 	jmethodID fine;
 	jmethodID info;
 	jmethodID warning;
 	jmethodID severe;
 } Logger;
 
+typedef struct _java_util_logging_Level {
+	jclass cls;
+	jobject FINE;
+	jobject INFO;
+	jobject WARNING;
+	jobject SEVERE;
+} Level;
+
 // Global variables for Java object struct representation.
 extern GlobalScreen *org_jnativehook_GlobalScreen;
 extern NativeInputEvent *org_jnativehook_NativeInputEvent;
 extern NativeKeyEvent *org_jnativehook_keyboard_NativeKeyEvent;
 extern NativeMouseEvent *org_jnativehook_mouse_NativeMouseEvent;
 extern NativeMouseWheelEvent *org_jnativehook_mouse_NativeMouseWheelEvent;
-extern System *java_lang_System;
 extern Logger *java_util_logging_Logger;
+extern Level *java_util_logging_Level;
+
+/* Global reference to the GlobalScreen singleton.  This reference is resolved
+ * once when the native hook is registered so that the hook thread does not
+ * need to call the synchronized GlobalScreen.getInstance() for every event.
+ */
+extern jobject org_jnativehook_GlobalScreen_object;
+
+/* Global reference to the org.jnativehook logger.  This reference is resolved
+ * once in jni_CreateGlobals() so that native log messages do not need to look
+ * up the logger by name.
+ */
+extern jobject java_util_logging_Logger_object;
 
 // Create all of the JNI global references used throughout the native library.
 extern int jni_CreateGlobals(JNIEnv *env);
@@ -99,4 +131,16 @@ extern int jni_CreateGlobals(JNIEnv *env);
 // Free all of the JNI globals created by the CreateJNIGlobals() function.
 extern int jni_DestroyGlobals(JNIEnv *env);
 
+// Resolve the GlobalScreen singleton and create a global reference for it.
+extern int jni_CreateGlobalScreenObject(JNIEnv *env);
+
+/* Get the JNI interface pointer for the current thread.  Threads that are not
+ * already known to the virtual machine, such as the native hook thread, are
+ * attached as daemon threads exactly once and the interface pointer is kept in
+ * thread local storage.  The name is only used if the thread is attached by
+ * this call, a NULL name selects a generic native thread name.  These threads
+ * are automatically detached when they exit.
+ */
+extern jint jni_GetEnv(JNIEnv **env, const char *name);
+
 #endif
@@ -0,0 +1,204 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <uiohook.h>
+
+#include "jni_Converter.h"
+#include "jni_Hotkeys.h"
+#include "org_jnativehook_NativeInputEvent.h"
+
+// The number of slots in the hash table, this must be a power of two.
+#define HOTKEY_TABLE_SIZE		(HOTKEY_MAX * 2)
+#define HOTKEY_TABLE_MASK		(HOTKEY_TABLE_SIZE - 1)
+
+// Marks a used slot so that key code zero can be registered.
+#define HOTKEY_USED				0x80000000
+
+// The left and right modifier masks for each side of a modifier group.
+#define HOTKEY_LEFT_MASK		(org_jnativehook_NativeInputEvent_SHIFT_L_MASK \
+								| org_jnativehook_NativeInputEvent_CTRL_L_MASK \
+								| org_jnativehook_NativeInputEvent_META_L_MASK \
+								| org_jnativehook_NativeInputEvent_ALT_L_MASK)
+#define HOTKEY_RIGHT_MASK		(org_jnativehook_NativeInputEvent_SHIFT_R_MASK \
+								| org_jnativehook_NativeInputEvent_CTRL_R_MASK \
+								| org_jnativehook_NativeInputEvent_META_R_MASK \
+								| org_jnativehook_NativeInputEvent_ALT_R_MASK)
+
+typedef struct _hotkey_entry {
+	uint32_t key;
+	uint16_t modifiers;
+	uint8_t flags;
+	jint id;
+} hotkey_entry;
+
+static hotkey_entry hotkey_table[HOTKEY_TABLE_SIZE];
+static volatile unsigned int hotkey_count = 0;
+
+/* The table is only replaced by Java and only read by the hook thread for a
+ * few probes, so a spin lock is used to avoid blocking the hook thread.
+ */
+static volatile bool hotkey_lock = false;
+
+// The key codes of currently held keys that triggered a consumed hotkey.
+static uint32_t hotkey_consumed[0x10000 / 32];
+
+// Set after a consumed press so the typed event that follows is consumed.
+static bool hotkey_consume_typed = false;
+
+static inline void jni_LockHotkeys() {
+	while (__atomic_test_and_set(&hotkey_lock, __ATOMIC_ACQUIRE)) {
+		// Spin, the lock is never held for more than a table lookup.
+	}
+}
+
+static inline void jni_UnlockHotkeys() {
+	__atomic_clear(&hotkey_lock, __ATOMIC_RELEASE);
+}
+
+// Fold the left and right modifier masks into one bit per modifier group.
+static inline uint32_t jni_GetModifierGroups(uint16_t modifiers) {
+	return (modifiers | (modifiers >> 4)) & HOTKEY_LEFT_MASK;
+}
+
+static inline uint32_t jni_GetHotkeyKey(uint16_t keycode, uint16_t modifiers, jint location) {
+	return HOTKEY_USED | ((uint32_t) (location & 0xFF) << 20) | (jni_GetModifierGroups(modifiers) << 16) | keycode;
+}
+
+static inline uint32_t jni_GetHotkeySlot(uint32_t key) {
+	// Fibonacci hashing spreads the sequential key codes across the table.
+	return (key * 2654435769U) >> 23 & HOTKEY_TABLE_MASK;
+}
+
+// A modifier group registered with a single side requires that side.
+static inline bool jni_MatchModifierSides(uint16_t registered, uint16_t modifiers) {
+	uint16_t groups = registered & (registered >> 4) & HOTKEY_LEFT_MASK;
+	uint16_t sided = registered & ~(groups | (groups << 4)) & (HOTKEY_LEFT_MASK | HOTKEY_RIGHT_MASK);
+
+	return (modifiers & sided) == sided;
+}
+
+static hotkey_entry * jni_FindHotkey(uint32_t key, uint16_t modifiers) {
+	hotkey_entry *entry = NULL;
+
+	uint32_t slot = jni_GetHotkeySlot(key);
+	while (entry == NULL && hotkey_table[slot].key != 0) {
+		if (hotkey_table[slot].key == key && jni_MatchModifierSides(hotkey_table[slot].modifiers, modifiers)) {
+			entry = &hotkey_table[slot];
+		}
+
+		slot = (slot + 1) & HOTKEY_TABLE_MASK;
+	}
+
+	return entry;
+}
+
+bool jni_SetHotkeys(const jint *records, jsize count) {
+	bool status = false;
+
+	if (count >= 0 && count <= HOTKEY_MAX) {
+		jni_LockHotkeys();
+		memset(hotkey_table, 0, sizeof(hotkey_table));
+
+		jsize i;
+		for (i = 0; i < count; i++) {
+			const jint *record = records + i * HOTKEY_RECORD_SIZE;
+
+			uint16_t modifiers = (uint16_t) (record[1] & (HOTKEY_LEFT_MASK | HOTKEY_RIGHT_MASK));
+			uint32_t key = jni_GetHotkeyKey((uint16_t) record[0], modifiers, record[2]);
+
+			// The table is never more than half full so there is always a free slot.
+			uint32_t slot = jni_GetHotkeySlot(key);
+			while (hotkey_table[slot].key != 0) {
+				slot = (slot + 1) & HOTKEY_TABLE_MASK;
+			}
+
+			hotkey_table[slot].key = key;
+			hotkey_table[slot].modifiers = modifiers;
+			hotkey_table[slot].id = record[3];
+			hotkey_table[slot].flags = (uint8_t) record[4];
+		}
+
+		__atomic_store_n(&hotkey_count, (unsigned int) count, __ATOMIC_RELAXED);
+		jni_UnlockHotkeys();
+
+		status = true;
+	}
+
+	return status;
+}
+
+bool jni_HasHotkeys() {
+	return __atomic_load_n(&hotkey_count, __ATOMIC_RELAXED) > 0;
+}
+
+bool jni_MatchHotkey(virtual_event * const event, jint *id) {
+	bool consume = false;
+	*id = -1;
+
+	uint16_t keycode = event->data.keyboard.keycode;
+	switch (event->type) {
+		case EVENT_KEY_PRESSED:
+			hotkey_consume_typed = false;
+
+			jint location;
+			jni_ConvertToJavaLocation(keycode, &location);
+
+			jni_LockHotkeys();
+			// Prefer a hotkey for this exact location over one for any location.
+			hotkey_entry *entry = jni_FindHotkey(jni_GetHotkeyKey(keycode, event->mask, location), event->mask);
+			if (entry == NULL) {
+				entry = jni_FindHotkey(jni_GetHotkeyKey(keycode, event->mask, 0), event->mask);
+			}
+
+			if (entry != NULL) {
+				*id = entry->id;
+				consume = (entry->flags & HOTKEY_CONSUME) != 0;
+			}
+			jni_UnlockHotkeys();
+
+			if (consume) {
+				hotkey_consumed[keycode / 32] |= 1U << (keycode % 32);
+				hotkey_consume_typed = true;
+			}
+			break;
+
+		case EVENT_KEY_TYPED:
+			consume = hotkey_consume_typed;
+			hotkey_consume_typed = false;
+			break;
+
+		case EVENT_KEY_RELEASED:
+			hotkey_consume_typed = false;
+
+			// Swallow the release if the press was swallowed.
+			if (hotkey_consumed[keycode / 32] & (1U << (keycode % 32))) {
+				hotkey_consumed[keycode / 32] &= ~(1U << (keycode % 32));
+				consume = true;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	return consume;
+}
@@ -0,0 +1,57 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_Hotkeys_h
+#define _Included_jni_Hotkeys_h
+
+#include <jni.h>
+#include <stdbool.h>
+#include <uiohook.h>
+
+/* Hotkeys are matched on the hook thread against an open addressed hash table
+ * keyed by virtual key code, modifier groups and key location.  A hotkey
+ * registered with both sides of a modifier group accepts either side, while a
+ * single side must be held exactly.  Other modifier groups must be released.
+ */
+
+// The maximum number of hotkeys, half the size of the hash table.
+#define HOTKEY_MAX				256
+
+// The number of ints describing each hotkey passed to jni_SetHotkeys().
+#define HOTKEY_RECORD_SIZE		5
+
+// Hotkey record flag to consume the matching key events.
+#define HOTKEY_CONSUME			0x01
+
+/* Replace the hotkey table with count records of HOTKEY_RECORD_SIZE ints:
+ * key code, modifier mask, key location or zero for any location, hotkey id
+ * and HOTKEY_* flags.  Returns false if there are too many hotkeys.
+ */
+extern bool jni_SetHotkeys(const jint *records, jsize count);
+
+// Returns true if at least one hotkey is registered.
+extern bool jni_HasHotkeys();
+
+/* Called on the hook thread for key events.  Sets id to the triggered hotkey
+ * or -1 if the event does not trigger one.  Returns true if the event must be
+ * consumed, which includes the typed and released events that follow a
+ * consumed hotkey press.
+ */
+extern bool jni_MatchHotkey(virtual_event * const event, jint *id);
+
+#endif
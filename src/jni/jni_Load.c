@@ -20,10 +20,18 @@
 #include <uiohook.h>
 
 #include "jni_Errors.h"
+#include "jni_EventCapture.h"
+#include "jni_EventReplay.h"
 #include "jni_EventDispathcer.h"
+#include "jni_EventPool.h"
+#include "jni_EventQueue.h"
 #include "jni_Globals.h"
 #include "jni_Logger.h"
-#include "jni_Properties.h"
+#include "jni_SettingsWatcher.h"
+#include "jni_Statistics.h"
+
+// The nanoseconds to wait for an event in flight before the globals are freed.
+#define UNLOAD_TIMEOUT	1000000000
 
 // JNI Related global references.
 JavaVM *jvm;
@@ -49,12 +57,15 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
 			ThrowFatalError("Failed to locate one or more required classes.");
 		}
 
+		// Create the native event queue used for batched delivery.
+		jni_CreateEventQueue();
+
+		// Create the queue used to deliver native log messages to Java.
+		jni_CreateLogQueue();
+
 		// Set Java logger for native code messages.
 		hook_set_logger_proc(&jni_Logger);
 
-		// Set java properties from native sources.
-		jni_SetProperties(env);
-
 		// Set the hook callback function to dispatch events.
 		hook_set_dispatch_proc(&jni_EventDispatcher);
 	}
@@ -75,26 +86,49 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
 
 // JNI exit point, This is executed when the Java virtual machine detaches from the native library.
 JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
-	// Grab the currently JNI interface pointer so we can cleanup the
-	// system properties set on load.
+	// The log thread may already be gone, log synchronously from here on.
+	jni_DisableLogQueue();
+
+	// Grab the current JNI interface pointer so we can free the globals.
 	JNIEnv *env = NULL;
-	if ((*jvm)->GetEnv(jvm, (void **)(&env), jni_version) == JNI_OK) {
-		// Clear java properties from native sources.
-		// FIXME Change to take jvm, not env!
-		jni_ClearProperties(env);
-	}
-	else {
-		// It is not critical that these values are cleared so no exception
-		// will be thrown.
-		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Failed to call jni_ClearProperties()!\n",
+	if ((*jvm)->GetEnv(jvm, (void **)(&env), jni_version) != JNI_OK) {
+		env = NULL;
+
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: GetEnv() failed!\n",
 				__FUNCTION__, __LINE__);
 	}
 
 	jni_Logger(LOG_LEVEL_DEBUG, "%s [%u]: JNI Unloaded.\n",
 			__FUNCTION__, __LINE__);
 
+	// Finish writing any active event capture and cancel any replay.
+	jni_StopEventCapture(NULL);
+	jni_StopEventReplay();
+
+	// Stop waiting for settings change notifications.
+	jni_StopSettingsWatcher(jni_GetNanoTime() + UNLOAD_TIMEOUT);
+
+	// Make sure the hook thread is no longer using the globals freed below.
+	if (hook_is_enabled()) {
+		hook_disable();
+	}
+
+	if (!jni_CloseEventDispatcher(jni_GetNanoTime() + UNLOAD_TIMEOUT)) {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: An event was still being dispatched during unload!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	// Stop and free the native event queue once the drain thread has left it.
+	jni_DestroyEventQueue(jni_GetNanoTime() + UNLOAD_TIMEOUT);
+
+	// Free the native log queue.
+	jni_DestroyLogQueue();
+
 	// FIXME Change to take jvm, not env!
 	if (env != NULL) {
+		// Release the pooled event objects before their classes.
+		jni_DestroyEventPool(env);
+
 		jni_DestroyGlobals(env);
 	}
 }
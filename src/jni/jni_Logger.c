@@ -18,33 +18,298 @@
 
 #include <jni.h>
 #include <uiohook.h>
+#include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 
 #include "jni_Errors.h"
 #include "jni_Globals.h"
+#include "jni_Logger.h"
 
-static char log_buffer[1024];
+// The number of messages in the queue, this must be a power of two.
+#define LOG_QUEUE_CAPACITY	256
+#define LOG_QUEUE_MASK		(LOG_QUEUE_CAPACITY - 1)
 
-bool jni_Logger(unsigned int level, const char *format, ...) {
+/* The log queue is a bounded multiple producer, single consumer queue.  Any
+ * thread may log, including the hook thread, so each slot carries a sequence
+ * number that tells producers and the consumer who owns it.  A producer claims
+ * a slot by advancing the enqueue position, formats the message directly into
+ * the slot and then publishes it by advancing the slot sequence.
+ */
+typedef struct _log_record {
+	volatile uint32_t sequence;
+	unsigned int level;
+	char message[LOG_MESSAGE_SIZE];
+} log_record;
+
+static log_record log_queue[LOG_QUEUE_CAPACITY];
+
+/* Remove a partial UTF-8 sequence left at the end of a message that was cut to
+ * fit the buffer so that NewStringUTF() is never handed a broken character.
+ * The length is the vsnprintf() return value for the untruncated message.
+ */
+static void jni_TrimMessage(char *message, int length, size_t size) {
+	if (length >= 0 && (size_t) length >= size) {
+		size_t end = size - 1;
+
+		// Skip back over the continuation bytes at the end of the buffer.
+		size_t start = end;
+		while (start > 0 && (message[start - 1] & 0xC0) == 0x80) {
+			start--;
+		}
+
+		if (start > 0 && (message[start - 1] & 0xC0) == 0xC0) {
+			unsigned char lead = (unsigned char) message[start - 1];
+			size_t expected = lead >= 0xF0 ? 4 : (lead >= 0xE0 ? 3 : 2);
+
+			if (end - (start - 1) < expected) {
+				message[start - 1] = '\0';
+			}
+		}
+	}
+}
+
+static volatile uint32_t log_enqueue_pos = 0;
+static volatile uint32_t log_dequeue_pos = 0;
+
+static volatile bool log_enabled = false;
+static volatile bool log_waiting = false;
+
+// The number of messages discarded because the queue was full.
+static volatile uint64_t log_dropped = 0;
+
+// The lowest level that will be logged.
+static volatile unsigned int log_level = LOG_LEVEL_DEBUG;
+
+#ifdef _WIN32
+static CRITICAL_SECTION log_mutex;
+static CONDITION_VARIABLE log_cond;
+#else
+static pthread_mutex_t log_mutex;
+static pthread_cond_t log_cond;
+#endif
+
+void jni_UpdateLogLevel(JNIEnv *env) {
+	unsigned int level = LOG_LEVEL_ERROR + 1;
+
+	if (java_util_logging_Logger_object != NULL) {
+		// Find the lowest level the logger will publish.
+		if ((*env)->CallBooleanMethod(env, java_util_logging_Logger_object, java_util_logging_Logger->isLoggable, java_util_logging_Level->FINE)) {
+			level = LOG_LEVEL_DEBUG;
+		}
+		else if ((*env)->CallBooleanMethod(env, java_util_logging_Logger_object, java_util_logging_Logger->isLoggable, java_util_logging_Level->INFO)) {
+			level = LOG_LEVEL_INFO;
+		}
+		else if ((*env)->CallBooleanMethod(env, java_util_logging_Logger_object, java_util_logging_Logger->isLoggable, java_util_logging_Level->WARNING)) {
+			level = LOG_LEVEL_WARN;
+		}
+		else if ((*env)->CallBooleanMethod(env, java_util_logging_Logger_object, java_util_logging_Logger->isLoggable, java_util_logging_Level->SEVERE)) {
+			level = LOG_LEVEL_ERROR;
+		}
+	}
+	else {
+		// Without a logger everything is passed to the fallback path.
+		level = LOG_LEVEL_DEBUG;
+	}
+
+	__atomic_store_n(&log_level, level, __ATOMIC_RELAXED);
+}
+
+int jni_CreateLogQueue() {
+	uint32_t i;
+	for (i = 0; i < LOG_QUEUE_CAPACITY; i++) {
+		log_queue[i].sequence = i;
+	}
+
+	#ifdef _WIN32
+	InitializeCriticalSection(&log_mutex);
+	InitializeConditionVariable(&log_cond);
+	#else
+	pthread_mutex_init(&log_mutex, NULL);
+	pthread_cond_init(&log_cond, NULL);
+	#endif
+
+	return JNI_OK;
+}
+
+int jni_DestroyLogQueue() {
+	jni_DisableLogQueue();
+
+	#ifdef _WIN32
+	DeleteCriticalSection(&log_mutex);
+	#else
+	pthread_cond_destroy(&log_cond);
+	pthread_mutex_destroy(&log_mutex);
+	#endif
+
+	return JNI_OK;
+}
+
+static void jni_SignalLogQueue() {
+	#ifdef _WIN32
+	EnterCriticalSection(&log_mutex);
+	WakeConditionVariable(&log_cond);
+	LeaveCriticalSection(&log_mutex);
+	#else
+	pthread_mutex_lock(&log_mutex);
+	pthread_cond_signal(&log_cond);
+	pthread_mutex_unlock(&log_mutex);
+	#endif
+}
+
+void jni_EnableLogQueue() {
+	__atomic_store_n(&log_enabled, true, __ATOMIC_SEQ_CST);
+}
+
+void jni_DisableLogQueue() {
+	__atomic_store_n(&log_enabled, false, __ATOMIC_SEQ_CST);
+
+	// Wake the consumer so it can observe the change.
+	jni_SignalLogQueue();
+}
+
+// Format a message into the log queue.  Returns false if the queue is full.
+static bool jni_QueueLogMessage(unsigned int level, const char *format, va_list args) {
+	bool status = false;
+
+	log_record *record = NULL;
+	uint32_t pos = __atomic_load_n(&log_enqueue_pos, __ATOMIC_RELAXED);
+	while (record == NULL) {
+		log_record *slot = &log_queue[pos & LOG_QUEUE_MASK];
+		int32_t diff = (int32_t) (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - pos);
+
+		if (diff == 0) {
+			// The slot is free, try to claim it.
+			if (__atomic_compare_exchange_n(&log_enqueue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				record = slot;
+			}
+		}
+		else if (diff < 0) {
+			// The consumer has not released this slot yet, the queue is full.
+			break;
+		}
+		else {
+			// Another producer claimed the slot first.
+			pos = __atomic_load_n(&log_enqueue_pos, __ATOMIC_RELAXED);
+		}
+	}
+
+	if (record != NULL) {
+		record->level = level;
+		int log_size = vsnprintf(record->message, sizeof(record->message), format, args);
+		if (log_size < 0) {
+			record->message[0] = '\0';
+		}
+		else {
+			jni_TrimMessage(record->message, log_size, sizeof(record->message));
+		}
+
+		// Publish the message to the consumer.
+		__atomic_store_n(&record->sequence, pos + 1, __ATOMIC_SEQ_CST);
+
+		// Only pay for the signal if the consumer is asleep.
+		if (__atomic_load_n(&log_waiting, __ATOMIC_SEQ_CST)) {
+			jni_SignalLogQueue();
+		}
+
+		status = true;
+	}
+	else {
+		__atomic_add_fetch(&log_dropped, 1, __ATOMIC_RELAXED);
+	}
+
+	return status;
+}
+
+jint jni_DrainLogQueue(unsigned int *levels, char messages[][LOG_MESSAGE_SIZE], jsize capacity, unsigned int timeout) {
+	jint count = 0;
+
+	uint32_t pos = __atomic_load_n(&log_dequeue_pos, __ATOMIC_RELAXED);
+	log_record *record = &log_queue[pos & LOG_QUEUE_MASK];
+
+	// Wait for a producer if the next message has not been published.
+	if (capacity > 0 && __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != pos + 1) {
+		#ifdef _WIN32
+		EnterCriticalSection(&log_mutex);
+		#else
+		pthread_mutex_lock(&log_mutex);
+		#endif
+
+		#ifndef _WIN32
+		struct timespec deadline;
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += timeout / 1000;
+		deadline.tv_nsec += (long) (timeout % 1000) * 1000000;
+		if (deadline.tv_nsec >= 1000000000) {
+			deadline.tv_sec++;
+			deadline.tv_nsec -= 1000000000;
+		}
+		#endif
+
+		bool expired = false;
+		__atomic_store_n(&log_waiting, true, __ATOMIC_SEQ_CST);
+		while (!expired && __atomic_load_n(&record->sequence, __ATOMIC_SEQ_CST) != pos + 1
+				&& __atomic_load_n(&log_enabled, __ATOMIC_SEQ_CST)) {
+			#ifdef _WIN32
+			expired = !SleepConditionVariableCS(&log_cond, &log_mutex, timeout);
+			#else
+			expired = pthread_cond_timedwait(&log_cond, &log_mutex, &deadline) != 0;
+			#endif
+		}
+		__atomic_store_n(&log_waiting, false, __ATOMIC_SEQ_CST);
+
+		#ifdef _WIN32
+		LeaveCriticalSection(&log_mutex);
+		#else
+		pthread_mutex_unlock(&log_mutex);
+		#endif
+	}
+
+	while (count < capacity && __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) == pos + 1) {
+		levels[count] = record->level;
+		memcpy(messages[count], record->message, LOG_MESSAGE_SIZE);
+		count++;
+
+		// Release the slot back to the producers.
+		__atomic_store_n(&record->sequence, pos + LOG_QUEUE_CAPACITY, __ATOMIC_RELEASE);
+
+		pos++;
+		record = &log_queue[pos & LOG_QUEUE_MASK];
+	}
+
+	__atomic_store_n(&log_dequeue_pos, pos, __ATOMIC_RELAXED);
+
+	if (count == 0 && capacity > 0 && !__atomic_load_n(&log_enabled, __ATOMIC_SEQ_CST)) {
+		// The queue was disabled while we were waiting.
+		count = -1;
+	}
+
+	return count;
+}
+
+// Deliver a message to the Java logger on the calling thread.
+static bool jni_LogMessage(unsigned int level, const char *format, va_list args) {
 	bool status = false;
 
 	JNIEnv *env = NULL;
-	if ((*jvm)->AttachCurrentThread(jvm, (void **)(&env), NULL) == JNI_OK) {
-		va_list args;
-		va_start(args, format);
+	if (jni_GetEnv(&env, NULL) == JNI_OK) {
+		char log_buffer[LOG_MESSAGE_SIZE];
 		int log_size = vsnprintf(log_buffer, sizeof(log_buffer), format, args);
-		va_end(args);
-	
-		if (log_size >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "org.jnativehook");
+		jni_TrimMessage(log_buffer, log_size, sizeof(log_buffer));
+
+		if (log_size >= 0 && java_util_logging_Logger_object != NULL) {
 			jstring message = (*env)->NewStringUTF(env, log_buffer);
-			
-			jobject Logger_object = (*env)->CallStaticObjectMethod(
-					env, 
-					java_util_logging_Logger->cls, 
-					java_util_logging_Logger->getLogger,
-					name);
+			jobject Logger_object = java_util_logging_Logger_object;
 			
 			switch (level) {
 				case LOG_LEVEL_DEBUG:
@@ -80,9 +345,7 @@ bool jni_Logger(unsigned int level, const char *format, ...) {
 					break;
 			}
 			
-			(*env)->DeleteLocalRef(env, name);
 			(*env)->DeleteLocalRef(env, message);
-			(*env)->DeleteLocalRef(env, Logger_object);
 			
 			status = true;
 		}
@@ -90,3 +353,22 @@ bool jni_Logger(unsigned int level, const char *format, ...) {
 	
 	return status;
 }
+
+bool jni_Logger(unsigned int level, const char *format, ...) {
+	bool status = false;
+
+	// Discard the message before doing any work if nobody will see it.
+	if (level >= __atomic_load_n(&log_level, __ATOMIC_RELAXED)) {
+		va_list args;
+		va_start(args, format);
+		if (__atomic_load_n(&log_enabled, __ATOMIC_RELAXED)) {
+			status = jni_QueueLogMessage(level, format, args);
+		}
+		else {
+			status = jni_LogMessage(level, format, args);
+		}
+		va_end(args);
+	}
+
+	return status;
+}
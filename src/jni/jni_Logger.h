@@ -19,9 +19,44 @@
 #ifndef _Included_jni_Logger_h
 #define _Included_jni_Logger_h
 
+#include <jni.h>
 #include <stdbool.h>
 #include <uiohook.h>
 
+// The maximum length of a single log message including the terminator.
+#define LOG_MESSAGE_SIZE	512
+
+/* Log a message through java.util.logging.  Messages below the current native
+ * log level are discarded before they are formatted.  While the log queue is
+ * enabled, messages are formatted into a lock-free queue and delivered to the
+ * Java logger by the GlobalScreen log thread.  Otherwise they are delivered
+ * synchronously on the calling thread.
+ */
 extern bool jni_Logger(unsigned int level, const char *format, ...);
 
+/* Mirror the effective level of the cached org.jnativehook logger into the
+ * native log level.  Messages below this level are discarded with a single
+ * comparison.
+ */
+extern void jni_UpdateLogLevel(JNIEnv *env);
+
+// Initialize the synchronization objects used by the log queue.
+extern int jni_CreateLogQueue();
+
+// Free the synchronization objects used by the log queue.
+extern int jni_DestroyLogQueue();
+
+// Start delivering messages through the log queue.
+extern void jni_EnableLogQueue();
+
+// Stop delivering messages through the log queue and wake the consumer.
+extern void jni_DisableLogQueue();
+
+/* Copy up to capacity queued messages and their levels into the supplied
+ * arrays.  This will block for up to timeout milliseconds until at least one
+ * message is available.  Returns the number of messages copied, which may be
+ * zero if the timeout elapsed, or -1 if the queue was disabled and is empty.
+ */
+extern jint jni_DrainLogQueue(unsigned int *levels, char messages[][LOG_MESSAGE_SIZE], jsize capacity, unsigned int timeout);
+
 #endif
@@ -21,248 +21,54 @@
 
 #include "jni_Globals.h"
 #include "jni_Logger.h"
-
-void jni_SetProperties(JNIEnv *env) {
-	// Create a buffer for converting numbers to strings.
-	char buffer[16];
-
-	// Set the native keyboard auto repeat rate.
-	long rate = hook_get_auto_repeat_rate();
-	if (rate >= 0) {
-		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: hook_get_auto_repeat_rate(): successful. (%li)\n",
-    				__FUNCTION__, __LINE__, rate);
-
-		if (snprintf(buffer, sizeof(buffer), "%li", rate) >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "jnativehook.autoRepeatRate");
-			jstring value = (*env)->NewStringUTF(env, buffer);
-
-			(*env)->CallStaticObjectMethod(
-					env, 
-					java_lang_System->cls, 
-					java_lang_System->setProperty, 
-					name, 
-					value);
-
-			(*env)->DeleteLocalRef(env, name);
-			(*env)->DeleteLocalRef(env, value);
-		}
-		else {
-			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Failed to convert auto repeat rate to string!\n",
-        			__FUNCTION__, __LINE__);
-		}
-	}
-	else {
-		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned from hook_get_auto_repeat_rate()!\n",
-				__FUNCTION__, __LINE__);
-	}
-
-
-	long delay = hook_get_auto_repeat_delay();
-	if (delay >= 0) {
-		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: hook_get_auto_repeat_delay(): successful. (%li)\n",
-    				__FUNCTION__, __LINE__, delay);
-
-		if (snprintf(buffer, sizeof(buffer), "%li", delay) >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "jnativehook.autoRepeatDelay");
-			jstring value = (*env)->NewStringUTF(env, buffer);
-
-			(*env)->CallStaticObjectMethod(
-					env, 
-					java_lang_System->cls, 
-					java_lang_System->setProperty, 
-					name, 
-					value);
-
-			(*env)->DeleteLocalRef(env, name);
-			(*env)->DeleteLocalRef(env, value);
-		}
-		else {
-			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Failed to convert auto repeat delay to string!\n",
-					__FUNCTION__, __LINE__);
-		}
-	}
-	else {
-		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned from hook_get_auto_repeat_delay()!\n",
-        		__FUNCTION__, __LINE__);
-	}
-
-
-	// 0-Threshold X, 1-Threshold Y and 2-Speed.
-	long multiplier = hook_get_pointer_acceleration_multiplier();
-	if (multiplier >= 0) {
-		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: hook_get_pointer_acceleration_multiplier(): successful. (%li)\n",
-				__FUNCTION__, __LINE__, multiplier);
-
-		if (snprintf(buffer, sizeof(buffer), "%li", multiplier) >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "jnativehook.pointerAccelerationMultiplier");
-			jstring value = (*env)->NewStringUTF(env, buffer);
-
-			(*env)->CallStaticObjectMethod(
-					env, 
-					java_lang_System->cls, 
-					java_lang_System->setProperty, 
-					name, 
-					value);
-
-			(*env)->DeleteLocalRef(env, name);
-			(*env)->DeleteLocalRef(env, value);
-		}
-		else {
-			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Failed to convert pointer acceleration multiplier to string!\n",
-					__FUNCTION__, __LINE__);
-		}
-	}
-	else {
-		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned from hook_get_pointer_acceleration_multiplier()!\n",
-				__FUNCTION__, __LINE__);
-	}
-
-
-	// 0-Threshold X, 1-Threshold Y and 2-Speed.
-	long threshold = hook_get_pointer_acceleration_threshold();
-	if (threshold >= 0) {
-		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: hook_get_pointer_acceleration_threshold(): successful. (%li)\n",
-				__FUNCTION__, __LINE__, threshold);
-
-		if (snprintf(buffer, sizeof(buffer), "%li", threshold) >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "jnativehook.pointerAccelerationThreshold");
-			jstring value = (*env)->NewStringUTF(env, buffer);
-
-			(*env)->CallStaticObjectMethod(
-					env, 
-					java_lang_System->cls, 
-					java_lang_System->setProperty, 
-					name, 
-					value);
-
-			(*env)->DeleteLocalRef(env, name);
-			(*env)->DeleteLocalRef(env, value);
-		}
-		else {
-			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Failed to convert pointer acceleration threshold to string!\n",
-					__FUNCTION__, __LINE__);
-		}
-	}
-	else {
-		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned from hook_get_pointer_acceleration_threshold()!\n",
-				__FUNCTION__, __LINE__);
+#include "jni_Properties.h"
+#include "org_jnativehook_GlobalScreen.h"
+
+jlong jni_GetProperty(jint property) {
+	long value = -1;
+
+	switch (property) {
+		case org_jnativehook_GlobalScreen_PROPERTY_AUTO_REPEAT_RATE:
+			value = hook_get_auto_repeat_rate();
+			break;
+
+		case org_jnativehook_GlobalScreen_PROPERTY_AUTO_REPEAT_DELAY:
+			value = hook_get_auto_repeat_delay();
+			break;
+
+		// 0-Threshold X, 1-Threshold Y and 2-Speed.
+		case org_jnativehook_GlobalScreen_PROPERTY_POINTER_ACCELERATION_MULTIPLIER:
+			value = hook_get_pointer_acceleration_multiplier();
+			break;
+
+		// 0-Threshold X, 1-Threshold Y and 2-Speed.
+		case org_jnativehook_GlobalScreen_PROPERTY_POINTER_ACCELERATION_THRESHOLD:
+			value = hook_get_pointer_acceleration_threshold();
+			break;
+
+		case org_jnativehook_GlobalScreen_PROPERTY_POINTER_SENSITIVITY:
+			value = hook_get_pointer_sensitivity();
+			break;
+
+		case org_jnativehook_GlobalScreen_PROPERTY_MULTI_CLICK_INTERVAL:
+			value = hook_get_multi_click_time();
+			break;
+
+		default:
+			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Unknown native property %i!\n",
+					__FUNCTION__, __LINE__, property);
 	}
 
-
-	long sensitivity = hook_get_pointer_sensitivity();
-	if (sensitivity >= 0) {
-		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: hook_get_pointer_sensitivity(): successful. (%li)\n",
-				__FUNCTION__, __LINE__, sensitivity);
-
-		if (snprintf(buffer, sizeof(buffer), "%li", sensitivity) >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "jnativehook.pointerSensitivity");
-			jstring value = (*env)->NewStringUTF(env, buffer);
-
-			(*env)->CallStaticObjectMethod(
-					env, 
-					java_lang_System->cls, 
-					java_lang_System->setProperty, 
-					name, 
-					value);
-
-			(*env)->DeleteLocalRef(env, name);
-			(*env)->DeleteLocalRef(env, value);
-		}
-		else {
-			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Failed to convert pointer sensitivity to string!\n",
-					__FUNCTION__, __LINE__);
-		}
+	if (value >= 0) {
+		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: Native property %i: successful. (%li)\n",
+				__FUNCTION__, __LINE__, property, value);
 	}
 	else {
-		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned from hook_get_pointer_sensitivity()!\n",
-				__FUNCTION__, __LINE__);
-	}
-
-
-	long clicktime = hook_get_multi_click_time();
-	if (clicktime >= 0) {
-		jni_Logger(LOG_LEVEL_DEBUG,	"%s [%u]: hook_get_multi_click_time(): successful. (%li)\n",
-        		__FUNCTION__, __LINE__, clicktime);
+		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned for native property %i!\n",
+				__FUNCTION__, __LINE__, property);
 
-		if (snprintf(buffer, sizeof(buffer), "%li", clicktime) >= 0) {
-			jstring name = (*env)->NewStringUTF(env, "jnativehook.multiClickInterval");
-			jstring value = (*env)->NewStringUTF(env, buffer);
-
-			(*env)->CallStaticObjectMethod(
-					env, 
-					java_lang_System->cls, 
-					java_lang_System->setProperty, 
-					name, 
-					value);
-
-			(*env)->DeleteLocalRef(env, name);
-			(*env)->DeleteLocalRef(env, value);
-		}
-		else {
-			jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Failed to convert multi click time to string!\n",
-					__FUNCTION__, __LINE__);
-		}
+		value = -1;
 	}
-	else {
-		jni_Logger(LOG_LEVEL_WARN,	"%s [%u]: Invalid result returned from hook_get_multi_click_time()!\n",
-				__FUNCTION__, __LINE__);
-	}
-}
-
-
-void jni_ClearProperties(JNIEnv *env) {
-	jstring name = NULL;
-	
-	name = (*env)->NewStringUTF(env, "jnativehook.autoRepeatRate");
-	(*env)->CallStaticObjectMethod(
-			env, 
-			java_lang_System->cls, 
-			java_lang_System->clearProperty, 
-			name);
-	(*env)->DeleteLocalRef(env, name);
-
-
-	name = (*env)->NewStringUTF(env, "jnativehook.autoRepeatDelay");
-	(*env)->CallStaticObjectMethod(
-			env, 
-			java_lang_System->cls, 
-			java_lang_System->clearProperty, 
-			name);
-	(*env)->DeleteLocalRef(env, name);
-
-
-	name = (*env)->NewStringUTF(env, "jnativehook.pointerAccelerationMultiplier");
-	(*env)->CallStaticObjectMethod(
-			env, 
-			java_lang_System->cls, 
-			java_lang_System->clearProperty, 
-			name);
-	(*env)->DeleteLocalRef(env, name);
-
-
-	name = (*env)->NewStringUTF(env, "jnativehook.pointerAccelerationThreshold");
-	(*env)->CallStaticObjectMethod(
-			env, 
-			java_lang_System->cls, 
-			java_lang_System->clearProperty, 
-			name);
-	(*env)->DeleteLocalRef(env, name);
-
-
-	name = (*env)->NewStringUTF(env, "jnativehook.pointerSensitivity");
-	(*env)->CallStaticObjectMethod(
-			env, 
-			java_lang_System->cls, 
-			java_lang_System->clearProperty, 
-			name);
-	(*env)->DeleteLocalRef(env, name);
-
 
-	name = (*env)->NewStringUTF(env, "jnativehook.multiClickInterval");
-	(*env)->CallStaticObjectMethod(
-			env, 
-			java_lang_System->cls, 
-			java_lang_System->clearProperty, 
-			name);
-	(*env)->DeleteLocalRef(env, name);
+	return (jlong) value;
 }
@@ -21,8 +21,10 @@
 
 #include <jni.h>
 
-extern void jni_SetProperties(JNIEnv *env);
-
-extern void jni_ClearProperties(JNIEnv *env);
+/* Query one of the GlobalScreen.PROPERTY_* native system settings.  The
+ * platform is queried on every call, Java caches the result.  Returns -1 if
+ * the platform does not report the setting.
+ */
+extern jlong jni_GetProperty(jint property);
 
 #endif
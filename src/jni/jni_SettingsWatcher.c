@@ -0,0 +1,400 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__APPLE__)
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+#include <X11/Xlib.h>
+#include <X11/XKBlib.h>
+#endif
+
+#include "jni_Globals.h"
+#include "jni_Logger.h"
+#include "jni_SettingsWatcher.h"
+#include "jni_Statistics.h"
+
+static bool watcher_started = false;
+
+// The number of watcher threads that have not exited yet.  A thread that was
+// asked to stop by its own listener is still counted until it returns.
+static volatile unsigned int watcher_active = 0;
+
+// Tell Java that the native settings may have changed.
+static void jni_NotifySettingsChanged() {
+	JNIEnv *env = NULL;
+
+	if (jni_GetEnv(&env, "JNativeHook Settings Watcher") == JNI_OK) {
+		(*env)->CallStaticVoidMethod(
+				env,
+				org_jnativehook_GlobalScreen->cls,
+				org_jnativehook_GlobalScreen->settingsChanged);
+
+		// A pending exception would break the next JNI call on this thread.
+		if ((*env)->ExceptionCheck(env) == JNI_TRUE) {
+			(*env)->ExceptionDescribe(env);
+			(*env)->ExceptionClear(env);
+
+			jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: Uncaught exception in GlobalScreen.settingsChanged()!\n",
+					__FUNCTION__, __LINE__);
+		}
+	}
+	else {
+		jni_Logger(LOG_LEVEL_ERROR,	"%s [%u]: jni_GetEnv() failed!\n",
+				__FUNCTION__, __LINE__);
+	}
+}
+
+// Wait for every watcher thread to exit.  Returns false at the deadline.
+static bool jni_WaitSettingsWatcher(uint64_t deadline) {
+	bool idle;
+	while (!(idle = __atomic_load_n(&watcher_active, __ATOMIC_SEQ_CST) == 0) && jni_GetNanoTime() < deadline) {
+		#ifdef _WIN32
+		Sleep(1);
+		#else
+		struct timespec duration = { 0, 1000000 };
+		nanosleep(&duration, NULL);
+		#endif
+	}
+
+	if (!idle) {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: The settings watcher did not exit before the deadline!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	return idle;
+}
+
+#if defined(_WIN32)
+#define WATCHER_CLASS_NAME		"JNativeHookSettingsWatcher"
+
+static DWORD watcher_thread_id = 0;
+static HANDLE watcher_ready = NULL;
+static HWND watcher_window = NULL;
+
+static LRESULT CALLBACK jni_SettingsWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+	LRESULT result = 0;
+
+	switch (msg) {
+		case WM_SETTINGCHANGE:
+			switch (wParam) {
+				case SPI_SETKEYBOARDSPEED:
+				case SPI_SETKEYBOARDDELAY:
+				case SPI_SETMOUSE:
+				case SPI_SETMOUSESPEED:
+				case SPI_SETDOUBLECLICKTIME:
+					jni_NotifySettingsChanged();
+					break;
+			}
+			break;
+
+		case WM_CLOSE:
+			DestroyWindow(hwnd);
+			break;
+
+		case WM_DESTROY:
+			PostQuitMessage(0);
+			break;
+
+		default:
+			result = DefWindowProc(hwnd, msg, wParam, lParam);
+	}
+
+	return result;
+}
+
+static DWORD WINAPI jni_SettingsWatcherProc(LPVOID arg) {
+	HINSTANCE instance = GetModuleHandle(NULL);
+
+	WNDCLASSEX wc;
+	ZeroMemory(&wc, sizeof(wc));
+	wc.cbSize = sizeof(wc);
+	wc.lpfnWndProc = jni_SettingsWindowProc;
+	wc.hInstance = instance;
+	wc.lpszClassName = WATCHER_CLASS_NAME;
+	RegisterClassEx(&wc);
+
+	// Message only windows do not receive broadcasts, so use a hidden top level window.
+	HWND window = CreateWindowEx(0, WATCHER_CLASS_NAME, "", WS_OVERLAPPED, 0, 0, 0, 0, NULL, NULL, instance, NULL);
+	watcher_window = window;
+	SetEvent(watcher_ready);
+
+	if (window != NULL) {
+		MSG msg;
+		while (GetMessage(&msg, NULL, 0, 0) > 0) {
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+	}
+
+	UnregisterClass(WATCHER_CLASS_NAME, instance);
+
+	__atomic_sub_fetch(&watcher_active, 1, __ATOMIC_SEQ_CST);
+
+	return 0;
+}
+
+bool jni_StartSettingsWatcher() {
+	if (!watcher_started) {
+		watcher_ready = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+		if (watcher_ready != NULL) {
+			__atomic_add_fetch(&watcher_active, 1, __ATOMIC_SEQ_CST);
+
+			HANDLE thread = CreateThread(NULL, 0, jni_SettingsWatcherProc, NULL, 0, &watcher_thread_id);
+			if (thread != NULL) {
+				WaitForSingleObject(watcher_ready, INFINITE);
+
+				if (watcher_window != NULL) {
+					watcher_started = true;
+				}
+				else {
+					// The thread exits on its own without a window.
+					WaitForSingleObject(thread, INFINITE);
+					watcher_thread_id = 0;
+				}
+
+				// The thread is only tracked through watcher_active.
+				CloseHandle(thread);
+			}
+			else {
+				__atomic_sub_fetch(&watcher_active, 1, __ATOMIC_SEQ_CST);
+			}
+
+			CloseHandle(watcher_ready);
+			watcher_ready = NULL;
+		}
+
+		if (!watcher_started) {
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to create the settings watcher window!\n",
+					__FUNCTION__, __LINE__);
+		}
+	}
+
+	return watcher_started;
+}
+
+bool jni_StopSettingsWatcher(uint64_t deadline) {
+	bool status = true;
+
+	// A listener may stop the watcher from the watcher thread itself, which
+	// must not wait for itself and exits once the listener returns.
+	bool self = GetCurrentThreadId() == watcher_thread_id;
+
+	if (watcher_started) {
+		PostMessage(watcher_window, WM_CLOSE, 0, 0);
+		watcher_window = NULL;
+		watcher_started = false;
+	}
+
+	if (!self) {
+		status = jni_WaitSettingsWatcher(deadline);
+	}
+
+	return status;
+}
+
+#elif defined(__APPLE__)
+bool jni_StartSettingsWatcher() {
+	jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Settings change notifications are not supported on this platform!\n",
+			__FUNCTION__, __LINE__);
+
+	return false;
+}
+
+bool jni_StopSettingsWatcher(uint64_t deadline) {
+	// Nothing was started.
+	return jni_WaitSettingsWatcher(deadline);
+}
+
+#else
+/* The resources used by a single watcher thread.  The thread frees its own
+ * context when it exits so that it never outlives the objects it is using,
+ * even if it is stopped by one of its own listeners.
+ */
+typedef struct _watcher_context {
+	Display *disp;
+
+	// Writing to the pipe wakes the watcher thread and asks it to exit.
+	int pipe[2];
+
+	Atom settings_selection;
+	Atom settings_property;
+	Window settings_owner;
+} watcher_context;
+
+static pthread_t watcher_thread;
+static watcher_context *watcher = NULL;
+
+// Follow the XSETTINGS manager window, which changes if the manager restarts.
+static void jni_SelectSettingsOwner(watcher_context *context) {
+	XGrabServer(context->disp);
+
+	context->settings_owner = XGetSelectionOwner(context->disp, context->settings_selection);
+	if (context->settings_owner != None) {
+		XSelectInput(context->disp, context->settings_owner, PropertyChangeMask | StructureNotifyMask);
+	}
+
+	XUngrabServer(context->disp);
+	XFlush(context->disp);
+}
+
+static void * jni_SettingsWatcherProc(void *arg) {
+	watcher_context *context = (watcher_context *) arg;
+
+	int xkb_event = 0;
+	int fd = ConnectionNumber(context->disp);
+	bool running = true;
+
+	if (XkbQueryExtension(context->disp, NULL, &xkb_event, NULL, NULL, NULL)) {
+		// The repeat controls carry the auto repeat rate and delay.
+		XkbSelectEventDetails(context->disp, XkbUseCoreKbd, XkbControlsNotify, XkbRepeatKeysMask, XkbRepeatKeysMask);
+	}
+	else {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: The XKB extension is not available!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	char name[32];
+	snprintf(name, sizeof(name), "_XSETTINGS_S%i", DefaultScreen(context->disp));
+	context->settings_selection = XInternAtom(context->disp, name, False);
+	context->settings_property = XInternAtom(context->disp, "_XSETTINGS_SETTINGS", False);
+	jni_SelectSettingsOwner(context);
+
+	while (running) {
+		if (XPending(context->disp) == 0) {
+			fd_set fds;
+			FD_ZERO(&fds);
+			FD_SET(fd, &fds);
+			FD_SET(context->pipe[0], &fds);
+
+			int max = fd > context->pipe[0] ? fd : context->pipe[0];
+			if (select(max + 1, &fds, NULL, NULL, NULL) > 0 && FD_ISSET(context->pipe[0], &fds)) {
+				running = false;
+			}
+		}
+
+		while (running && XPending(context->disp) > 0) {
+			XEvent event;
+			XNextEvent(context->disp, &event);
+
+			if (xkb_event != 0 && event.type == xkb_event) {
+				if (((XkbEvent *) &event)->any.xkb_type == XkbControlsNotify) {
+					jni_NotifySettingsChanged();
+				}
+			}
+			else if (event.type == PropertyNotify && event.xproperty.atom == context->settings_property) {
+				jni_NotifySettingsChanged();
+			}
+			else if (event.type == DestroyNotify && event.xdestroywindow.window == context->settings_owner) {
+				jni_SelectSettingsOwner(context);
+				jni_NotifySettingsChanged();
+			}
+		}
+	}
+
+	// The stop request has been read, so nobody else uses the context now.
+	close(context->pipe[0]);
+	close(context->pipe[1]);
+	XCloseDisplay(context->disp);
+	free(context);
+
+	__atomic_sub_fetch(&watcher_active, 1, __ATOMIC_SEQ_CST);
+
+	return NULL;
+}
+
+bool jni_StartSettingsWatcher() {
+	if (!watcher_started) {
+		watcher_context *context = malloc(sizeof(watcher_context));
+
+		if (context != NULL) {
+			// The watcher uses its own connection so it never competes with the hook.
+			context->disp = XOpenDisplay(NULL);
+
+			if (context->disp != NULL && pipe(context->pipe) == 0) {
+				__atomic_add_fetch(&watcher_active, 1, __ATOMIC_SEQ_CST);
+
+				if (pthread_create(&watcher_thread, NULL, jni_SettingsWatcherProc, context) == 0) {
+					// The thread is only tracked through watcher_active.
+					pthread_detach(watcher_thread);
+
+					watcher = context;
+					watcher_started = true;
+				}
+				else {
+					__atomic_sub_fetch(&watcher_active, 1, __ATOMIC_SEQ_CST);
+
+					close(context->pipe[0]);
+					close(context->pipe[1]);
+				}
+			}
+
+			if (!watcher_started) {
+				if (context->disp != NULL) {
+					XCloseDisplay(context->disp);
+				}
+
+				free(context);
+			}
+		}
+
+		if (!watcher_started) {
+			jni_Logger(LOG_LEVEL_ERROR, "%s [%u]: Failed to start the settings watcher!\n",
+					__FUNCTION__, __LINE__);
+		}
+	}
+
+	return watcher_started;
+}
+
+bool jni_StopSettingsWatcher(uint64_t deadline) {
+	bool status = true;
+
+	// A listener may stop the watcher from the watcher thread itself, which
+	// must not wait for itself and exits once the listener returns.
+	bool self = __atomic_load_n(&watcher_active, __ATOMIC_SEQ_CST) > 0
+			&& pthread_equal(pthread_self(), watcher_thread);
+
+	if (watcher_started) {
+		char stop = 0;
+		if (write(watcher->pipe[1], &stop, sizeof(stop)) < 0) {
+			jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Failed to signal the settings watcher!\n",
+					__FUNCTION__, __LINE__);
+		}
+
+		// The thread frees the context once it has read the request.
+		watcher = NULL;
+		watcher_started = false;
+	}
+
+	if (!self) {
+		status = jni_WaitSettingsWatcher(deadline);
+	}
+
+	return status;
+}
+#endif
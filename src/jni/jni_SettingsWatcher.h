@@ -0,0 +1,47 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_SettingsWatcher_h
+#define _Included_jni_SettingsWatcher_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* The settings watcher is a native thread that waits for the platform to
+ * report a change to the keyboard or pointer settings and then calls
+ * GlobalScreen.settingsChanged().  Java queries the settings again and only
+ * notifies its listeners if a value actually changed, so spurious
+ * notifications are harmless.
+ *
+ * Windows:	WM_SETTINGCHANGE sent to a hidden top level window.
+ * X11:		XkbControlsNotify for the repeat controls and PropertyNotify for
+ * 			the XSETTINGS manager window.
+ * Darwin:	Not supported yet.
+ */
+
+// Start the watcher thread.  Returns false if it could not be started.
+extern bool jni_StartSettingsWatcher();
+
+/* Stop the watcher thread and wait until the jni_GetNanoTime() deadline for it
+ * to exit.  When called by a listener on the watcher thread itself, the thread
+ * is only asked to exit once the listener returns.  Returns false if a watcher
+ * thread was still running at the deadline.
+ */
+extern bool jni_StopSettingsWatcher(uint64_t deadline);
+
+#endif
@@ -0,0 +1,168 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__APPLE__) && defined(__MACH__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#include "jni_EventQueue.h"
+#include "jni_Statistics.h"
+#include "org_jnativehook_GlobalScreen.h"
+
+#define STATISTICS_TYPES		org_jnativehook_GlobalScreen_STATISTICS_TYPES
+#define STATISTICS_BUCKETS		org_jnativehook_GlobalScreen_STATISTICS_BUCKETS
+
+static volatile bool statistics_enabled = false;
+
+static volatile uint64_t event_count[STATISTICS_TYPES];
+static volatile uint64_t latency[STATISTICS_TYPES][STATISTICS_STAGES][STATISTICS_BUCKETS];
+
+// Map the native event type to its statistics index or -1 if unknown.
+static int jni_GetStatisticsIndex(event_type type) {
+	int index = -1;
+
+	switch (type) {
+		case EVENT_KEY_TYPED:
+			index = 0;
+			break;
+
+		case EVENT_KEY_PRESSED:
+			index = 1;
+			break;
+
+		case EVENT_KEY_RELEASED:
+			index = 2;
+			break;
+
+		case EVENT_MOUSE_CLICKED:
+			index = 3;
+			break;
+
+		case EVENT_MOUSE_PRESSED:
+			index = 4;
+			break;
+
+		case EVENT_MOUSE_RELEASED:
+			index = 5;
+			break;
+
+		case EVENT_MOUSE_MOVED:
+			index = 6;
+			break;
+
+		case EVENT_MOUSE_DRAGGED:
+			index = 7;
+			break;
+
+		case EVENT_MOUSE_WHEEL:
+			index = 8;
+			break;
+	}
+
+	return index;
+}
+
+void jni_SetStatisticsEnabled(bool enabled) {
+	__atomic_store_n(&statistics_enabled, enabled, __ATOMIC_RELAXED);
+}
+
+bool jni_IsStatisticsEnabled() {
+	return __atomic_load_n(&statistics_enabled, __ATOMIC_RELAXED);
+}
+
+uint64_t jni_GetNanoTime() {
+	uint64_t nanos;
+
+	#ifdef _WIN32
+	static LARGE_INTEGER frequency = { .QuadPart = 0 };
+	if (frequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	// Split the conversion to avoid overflowing the intermediate product.
+	nanos = (uint64_t) (counter.QuadPart / frequency.QuadPart) * 1000000000
+			+ (uint64_t) (counter.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+	#elif defined(__APPLE__) && defined(__MACH__)
+	static mach_timebase_info_data_t timebase = { 0, 0 };
+	if (timebase.denom == 0) {
+		mach_timebase_info(&timebase);
+	}
+
+	nanos = mach_absolute_time() * timebase.numer / timebase.denom;
+	#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	nanos = (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+	#endif
+
+	return nanos;
+}
+
+void jni_RecordEvent(event_type type) {
+	int index = jni_GetStatisticsIndex(type);
+
+	if (index >= 0) {
+		__atomic_add_fetch(&event_count[index], 1, __ATOMIC_RELAXED);
+	}
+}
+
+void jni_RecordLatency(event_type type, unsigned int stage, uint64_t nanos) {
+	int index = jni_GetStatisticsIndex(type);
+
+	if (index >= 0 && stage < STATISTICS_STAGES) {
+		// The bucket is the number of significant bits in the interval.
+		unsigned int bucket = 0;
+		if (nanos > 0) {
+			bucket = 64 - __builtin_clzll(nanos);
+			if (bucket >= STATISTICS_BUCKETS) {
+				bucket = STATISTICS_BUCKETS - 1;
+			}
+		}
+
+		__atomic_add_fetch(&latency[index][stage][bucket], 1, __ATOMIC_RELAXED);
+	}
+}
+
+void jni_CopyStatistics(jlong *out) {
+	int i, j, k;
+
+	*out++ = (jlong) jni_GetEventQueueDropped();
+
+	for (i = 0; i < STATISTICS_TYPES; i++) {
+		*out++ = (jlong) __atomic_load_n(&event_count[i], __ATOMIC_RELAXED);
+
+		for (j = 0; j < STATISTICS_STAGES; j++) {
+			for (k = 0; k < STATISTICS_BUCKETS; k++) {
+				*out++ = (jlong) __atomic_load_n(&latency[i][j][k], __ATOMIC_RELAXED);
+			}
+		}
+	}
+}
@@ -0,0 +1,67 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _Included_jni_Statistics_h
+#define _Included_jni_Statistics_h
+
+#include <jni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <uiohook.h>
+
+/* Dispatch statistics are kept per native event type as a counter and one
+ * log2 bucketed latency histogram for each measured stage.  Bucket 0 counts
+ * zero length intervals and bucket n counts intervals of at least 2^(n-1) and
+ * less than 2^n nanoseconds.  All updates are relaxed atomic additions so the
+ * hook thread never waits on a reader.
+ */
+
+// Time spent converting a native event into a Java object or queue record.
+#define STATISTICS_STAGE_CONVERSION		0
+
+// Time spent in the GlobalScreen.dispatchEvent() upcall.
+#define STATISTICS_STAGE_UPCALL			1
+
+#define STATISTICS_STAGES				2
+
+/* The number of longs copied by jni_CopyStatistics().  The first value is the
+ * number of events dropped by the native event queue, followed by one record
+ * per event type holding the event count and the histogram of each stage.
+ */
+#define STATISTICS_RECORD_SIZE			(1 + STATISTICS_STAGES * org_jnativehook_GlobalScreen_STATISTICS_BUCKETS)
+#define STATISTICS_SIZE					(1 + org_jnativehook_GlobalScreen_STATISTICS_TYPES * STATISTICS_RECORD_SIZE)
+
+// Enable or disable the collection of statistics.
+extern void jni_SetStatisticsEnabled(bool enabled);
+
+// Returns true if statistics should be collected.
+extern bool jni_IsStatisticsEnabled();
+
+// Returns a monotonic timestamp in nanoseconds.
+extern uint64_t jni_GetNanoTime();
+
+// Count an event delivered to Java.
+extern void jni_RecordEvent(event_type type);
+
+// Add a measured interval to the histogram of a stage.
+extern void jni_RecordLatency(event_type type, unsigned int stage, uint64_t nanos);
+
+// Copy a snapshot of the statistics into out, which holds STATISTICS_SIZE longs.
+extern void jni_CopyStatistics(jlong *out);
+
+#endif
@@ -16,39 +16,136 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <uiohook.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 #include "jni_Converter.h"
+#include "jni_EventCapture.h"
+#include "jni_EventCoalescer.h"
+#include "jni_Errors.h"
+#include "jni_EventDispathcer.h"
+#include "jni_EventPool.h"
+#include "jni_EventReplay.h"
+#include "jni_EventQueue.h"
+#include "jni_Gestures.h"
 #include "jni_Globals.h"
+#include "jni_Hotkeys.h"
+#include "jni_Logger.h"
+#include "jni_Properties.h"
+#include "jni_SettingsWatcher.h"
+#include "jni_Statistics.h"
 #include "org_jnativehook_NativeInputEvent.h"
 #include "org_jnativehook_keyboard_NativeKeyEvent.h"
 #include "org_jnativehook_mouse_NativeMouseEvent.h"
 #include "org_jnativehook_mouse_NativeMouseWheelEvent.h"
 #include "org_jnativehook_GlobalScreen.h"
 
+// The log levels are passed to Java unchanged.
+#if org_jnativehook_GlobalScreen_LOG_LEVEL_DEBUG != LOG_LEVEL_DEBUG \
+		|| org_jnativehook_GlobalScreen_LOG_LEVEL_INFO != LOG_LEVEL_INFO \
+		|| org_jnativehook_GlobalScreen_LOG_LEVEL_WARN != LOG_LEVEL_WARN \
+		|| org_jnativehook_GlobalScreen_LOG_LEVEL_ERROR != LOG_LEVEL_ERROR
+#error "GlobalScreen.LOG_LEVEL_* does not match uiohook.h"
+#endif
+
+// The hotkey records are passed from Java unchanged.
+#if org_jnativehook_GlobalScreen_HOTKEY_MAX != HOTKEY_MAX \
+		|| org_jnativehook_GlobalScreen_HOTKEY_RECORD_SIZE != HOTKEY_RECORD_SIZE \
+		|| org_jnativehook_GlobalScreen_HOTKEY_CONSUME != HOTKEY_CONSUME
+#error "GlobalScreen.HOTKEY_* does not match jni_Hotkeys.h"
+#endif
+
+// The number of log messages copied to Java at once.
+#define LOG_BATCH_SIZE		16
+
+// The number of injected events converted at once.
+#define POST_BATCH_SIZE		64
+
+// The maximum time to wait for the settings watcher thread in nanoseconds.
+#define WATCHER_STOP_TIMEOUT	1000000000
+
 JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_registerNativeHook(JNIEnv *env, jclass cls) {
-	// Request an instance of the GlobalScreen.
-	jobject GlobalScreen_object = (*env)->CallStaticObjectMethod(
-			env,
-			org_jnativehook_GlobalScreen->cls,
-			org_jnativehook_GlobalScreen->getInstance);
+	// Resolve the GlobalScreen singleton before the hook thread needs it.
+	if (jni_CreateGlobalScreenObject(env) == JNI_OK) {
+		// Motion events dropped by a previous shutdown never completed, so
+		// the coalescer must not wait for them.
+		if (!hook_is_enabled()) {
+			jni_ResetEventCoalescer();
+		}
+
+		// Events may cross into Java again after a shutdown.
+		jni_OpenEventDispatcher();
 
-	if (GlobalScreen_object != NULL) {
 		hook_enable();
 	}
 }
 
 JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_unregisterNativeHook(JNIEnv *env, jclass cls) {
-	// Request an instance of the GlobalScreen.
-	jobject GlobalScreen_object = (*env)->CallStaticObjectMethod(
-			env,
-			org_jnativehook_GlobalScreen->cls,
-			org_jnativehook_GlobalScreen->getInstance);
+	// The singleton reference is kept until the library is unloaded in case
+	// the hook thread is still delivering its last event.  The hook thread
+	// detaches itself from the virtual machine when it exits.
+	hook_disable();
+
+	// Deliver the last wheel accumulation window once the hook has stopped.
+	if (!hook_is_enabled()) {
+		jni_FlushEventDispatcher();
+	}
+}
+
+JNIEXPORT jboolean JNICALL Java_org_jnativehook_GlobalScreen_shutdownNativeHook(JNIEnv *env, jclass cls, jlong timeout) {
+	uint64_t deadline = jni_GetNanoTime() + (uint64_t) (timeout > 0 ? timeout : 0);
+
+	// Stop the native threads that produce or capture events first.
+	jni_StopEventReplay();
+	jni_StopEventCapture(NULL);
+	bool watcher = jni_StopSettingsWatcher(deadline);
 
-	if (GlobalScreen_object != NULL) {
+	if (hook_is_enabled()) {
 		hook_disable();
 	}
+
+	// The hook thread detaches itself from the virtual machine when it exits.
+	bool stopped;
+	while (!(stopped = !hook_is_enabled()) && jni_GetNanoTime() < deadline) {
+		#ifdef _WIN32
+		Sleep(1);
+		#else
+		struct timespec duration = { 0, 1000000 };
+		nanosleep(&duration, NULL);
+		#endif
+	}
+
+	// Deliver the last wheel accumulation window, which no later event closes.
+	if (stopped) {
+		jni_FlushEventDispatcher();
+	}
+
+	// Wait for the events already inside the dispatcher.
+	bool idle = jni_CloseEventDispatcher(deadline);
+
+	// Objects still held by Java are released normally, but no new objects
+	// are handed out.
+	jni_DisableEventPool();
+
+	if (!stopped) {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: The native hook did not stop before the deadline!\n",
+				__FUNCTION__, __LINE__);
+	}
+	else if (!idle) {
+		jni_Logger(LOG_LEVEL_WARN, "%s [%u]: An event was still being dispatched at the deadline!\n",
+				__FUNCTION__, __LINE__);
+	}
+
+	return (watcher && stopped && idle) ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL Java_org_jnativehook_GlobalScreen_isNativeHookRegistered(JNIEnv *env, jclass cls) {
@@ -57,43 +154,375 @@ JNIEXPORT jboolean JNICALL Java_org_jnativehook_GlobalScreen_isNativeHookRegiste
 }
 
 JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_postNativeEvent(JNIEnv *env, jclass cls, jobject event) {
-	// Convert the event type.
-	jint javaType = (*env)->CallIntMethod(env, event, org_jnativehook_NativeInputEvent->getID);
+	if (event == NULL) {
+		ThrowException(java_lang_NullPointerException, "The native event must not be null.");
+		return;
+	}
+
+	// The event fields are read directly to avoid a method upcall per value.
+	jint javaType = (*env)->GetIntField(env, event, org_jnativehook_NativeInputEvent->id);
+
+	// The event is only used for the duration of hook_post_event().
+	virtual_event nativeEvent;
+	memset(&nativeEvent, 0, sizeof(virtual_event));
+
+	virtual_event *virtualEvent = &nativeEvent;
+	jclass expected = NULL;
+	if (jni_ConvertToNativeType(javaType, &(virtualEvent->type)) == JNI_OK) {
+		// The subclass fields below are chosen by id, so the object must
+		// actually be of the matching class.
+		switch (jni_GetEventClass(virtualEvent->type)) {
+			case EVENT_CLASS_KEY:
+				expected = org_jnativehook_keyboard_NativeKeyEvent->cls;
+				break;
+
+			case EVENT_CLASS_MOUSE:
+			case EVENT_CLASS_MOUSE_MOTION:
+				expected = org_jnativehook_mouse_NativeMouseEvent->cls;
+				break;
+
+			case EVENT_CLASS_MOUSE_WHEEL:
+				expected = org_jnativehook_mouse_NativeMouseWheelEvent->cls;
+				break;
+		}
+	}
+
+	if (expected == NULL) {
+		ThrowException(java_lang_IllegalArgumentException, "Unknown native event type.");
+	}
+	else if ((*env)->IsInstanceOf(env, event, expected) != JNI_TRUE) {
+		ThrowException(java_lang_IllegalArgumentException, "The native event class does not match its type.");
+	}
+	else {
+		// Convert Java event to virtual event.
+		virtualEvent->time = (uint64_t) (*env)->GetLongField(env, event, org_jnativehook_NativeInputEvent->when);
+		virtualEvent->mask = (uint16_t) (*env)->GetIntField(env, event, org_jnativehook_NativeInputEvent->modifiers);
+
+		switch (javaType) {
+			case org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_TYPED:
+				virtualEvent->data.keyboard.rawcode = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_keyboard_NativeKeyEvent->rawCode);
+				virtualEvent->data.keyboard.keychar = (uint16_t)
+						(*env)->GetCharField(env, event, org_jnativehook_keyboard_NativeKeyEvent->keyChar);
+				break;
+
+			case org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_PRESSED:
+			case org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_RELEASED:
+				virtualEvent->data.keyboard.rawcode = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_keyboard_NativeKeyEvent->rawCode);
+				virtualEvent->data.keyboard.keycode = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_keyboard_NativeKeyEvent->keyCode);
+				break;
+
+			case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_CLICKED:
+			case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_PRESSED:
+			case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_RELEASED:
+			case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_MOVED:
+			case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_DRAGGED:
+				virtualEvent->data.mouse.x = (int16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->x);
+				virtualEvent->data.mouse.y = (int16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->y);
+				virtualEvent->data.mouse.clicks = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->clickCount);
+				virtualEvent->data.mouse.button = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->button);
+				break;
+
+			case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_WHEEL:
+				virtualEvent->data.wheel.x = (int16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->x);
+				virtualEvent->data.wheel.y = (int16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->y);
+				virtualEvent->data.wheel.clicks = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseEvent->clickCount);
+				virtualEvent->data.wheel.type = (uint8_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseWheelEvent->scrollType);
+				virtualEvent->data.wheel.amount = (uint16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseWheelEvent->scrollAmount);
+				virtualEvent->data.wheel.rotation = (int16_t)
+						(*env)->GetIntField(env, event, org_jnativehook_mouse_NativeMouseWheelEvent->wheelRotation);
+				break;
+		}
+
+		hook_post_event(virtualEvent);
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_postNativeEvents(JNIEnv *env, jclass cls, jlongArray records, jint offset, jint count) {
+	jsize length = (*env)->GetArrayLength(env, records);
+
+	if (offset < 0 || count < 0 || offset > length / org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE - count) {
+		ThrowException(java_lang_IllegalArgumentException, "The event records are out of bounds.");
+	}
+	else {
+		jlong buffer[POST_BATCH_SIZE][org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE];
+		virtual_event events[POST_BATCH_SIZE];
+
+		jint done = 0;
+		while (done < count) {
+			jint size = count - done;
+			if (size > POST_BATCH_SIZE) {
+				size = POST_BATCH_SIZE;
+			}
+
+			// Copy and convert the whole chunk before posting so the array is
+			// never held while the platform is injecting events.
+			(*env)->GetLongArrayRegion(env, records,
+					(offset + done) * org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE,
+					size * org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE,
+					buffer[0]);
+
+			jint converted = 0, i;
+			for (i = 0; i < size; i++) {
+				if (jni_UnpackEventRecord(buffer[i], &events[converted])) {
+					converted++;
+				}
+				else {
+					jni_Logger(LOG_LEVEL_WARN, "%s [%u]: Ignoring unknown event record!\n",
+							__FUNCTION__, __LINE__);
+				}
+			}
+
+			for (i = 0; i < converted; i++) {
+				hook_post_event(&events[i]);
+			}
+
+			done += size;
+		}
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_enableEventQueue(JNIEnv *env, jclass cls) {
+	jni_EnableEventQueue();
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_disableEventQueue(JNIEnv *env, jclass cls) {
+	jni_DisableEventQueue();
+}
+
+JNIEXPORT jint JNICALL Java_org_jnativehook_GlobalScreen_drainEvents(JNIEnv *env, jclass cls, jobject buffer) {
+	jint count = 0;
+
+	// The buffer is a direct buffer so the records can be copied without
+	// pinning or allocating a Java array.
+	jlong *out = (jlong *) (*env)->GetDirectBufferAddress(env, buffer);
+	if (out != NULL) {
+		jsize capacity = (jsize) ((*env)->GetDirectBufferCapacity(env, buffer) / (sizeof(jlong) * org_jnativehook_GlobalScreen_EVENT_RECORD_SIZE));
+
+		count = jni_DrainEventQueue(out, capacity);
+	}
+	else {
+		ThrowException(java_lang_IllegalArgumentException, "The event buffer must be a direct buffer.");
+	}
+
+	return count;
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeEventMask(JNIEnv *env, jclass cls, jint mask) {
+	jni_SetEventMask(mask);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeFilterMask(JNIEnv *env, jclass cls, jint mask) {
+	jni_SetFilterMask(mask);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativePrimitiveMask(JNIEnv *env, jclass cls, jint mask) {
+	jni_SetPrimitiveMask(mask);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeHotkeys(JNIEnv *env, jclass cls, jintArray records, jint count) {
+	if (count >= 0 && count <= HOTKEY_MAX && (*env)->GetArrayLength(env, records) >= count * HOTKEY_RECORD_SIZE) {
+		jint hotkeys[HOTKEY_MAX * HOTKEY_RECORD_SIZE];
+		(*env)->GetIntArrayRegion(env, records, 0, count * HOTKEY_RECORD_SIZE, hotkeys);
+
+		jni_SetHotkeys(hotkeys, count);
+	}
+	else {
+		ThrowException(java_lang_IllegalArgumentException, "Invalid hotkey records.");
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeGestures(JNIEnv *env, jclass cls, jboolean enabled, jint interval) {
+	if (interval >= 0) {
+		jni_SetGestures(enabled == JNI_TRUE, (unsigned int) interval);
+	}
+	else {
+		ThrowException(java_lang_IllegalArgumentException, "Invalid multi click interval.");
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeEventPooling(JNIEnv *env, jclass cls, jboolean enabled) {
+	if (enabled == JNI_TRUE) {
+		if (!jni_EnableEventPool(env)) {
+			ThrowException(java_lang_OutOfMemoryError, "Failed to create the event object pool.");
+		}
+	}
+	else {
+		jni_DisableEventPool();
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_releaseNativeEvent(JNIEnv *env, jclass cls, jint index) {
+	jni_ReleaseEventObject(index);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeMotionCoalescing(JNIEnv *env, jclass cls, jboolean enabled) {
+	jni_SetMotionCoalescing(enabled == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeWheelAccumulation(JNIEnv *env, jclass cls, jint time, jint count) {
+	if (time >= 0 && count >= 0) {
+		jni_SetWheelAccumulation((unsigned int) time, (unsigned int) count);
+	}
+	else {
+		ThrowException(java_lang_IllegalArgumentException, "Invalid wheel accumulation window.");
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeEventTimestamps(JNIEnv *env, jclass cls, jboolean enabled) {
+	jni_SetEventTimestamps(enabled == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_beginMouseMotion(JNIEnv *env, jclass cls) {
+	jni_BeginMotionDispatch();
+}
+
+JNIEXPORT jobject JNICALL Java_org_jnativehook_GlobalScreen_completeMouseMotion(JNIEnv *env, jclass cls) {
+	jobject NativeMouseEvent_object = NULL;
+
+	virtual_event event;
+	uint64_t stamp;
+	unsigned int count;
+	if (jni_CompleteMotionDispatch(&event, &stamp, &count)) {
+		NativeMouseEvent_object = jni_CreateEventObject(env, &event, count, stamp);
+	}
+
+	return NativeMouseEvent_object;
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_cancelMouseMotion(JNIEnv *env, jclass cls) {
+	jni_CancelMotionDispatch();
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_startNativeCapture(JNIEnv *env, jclass cls, jstring path, jboolean delta) {
+	const char *capture_path = (*env)->GetStringUTFChars(env, path, NULL);
+	if (capture_path != NULL) {
+		uint8_t flags = delta == JNI_TRUE ? EVENT_CAPTURE_DELTA : 0x00;
+
+		if (!jni_StartEventCapture(capture_path, flags)) {
+			ThrowException(java_io_IOException, "Failed to start the event capture.");
+		}
+
+		(*env)->ReleaseStringUTFChars(env, path, capture_path);
+	}
+}
+
+JNIEXPORT jlong JNICALL Java_org_jnativehook_GlobalScreen_stopNativeCapture(JNIEnv *env, jclass cls) {
+	jlong size = -1;
+
+	uint64_t length;
+	if (jni_StopEventCapture(&length)) {
+		size = (jlong) length;
+	}
+
+	return size;
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_startNativeReplay(JNIEnv *env, jclass cls, jstring path, jdouble speed) {
+	const char *replay_path = (*env)->GetStringUTFChars(env, path, NULL);
+	if (replay_path != NULL) {
+		if (!jni_StartEventReplay(replay_path, (double) speed)) {
+			ThrowException(java_io_IOException, "Failed to start the event replay.");
+		}
+
+		(*env)->ReleaseStringUTFChars(env, path, replay_path);
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_stopNativeReplay(JNIEnv *env, jclass cls) {
+	jni_StopEventReplay();
+}
 
-	// Allocate memory for the virtual event and set the type.
-	virtual_event *virtualEvent = (virtual_event *) malloc(sizeof(virtual_event));
-	jni_ConvertToNativeType(javaType, &(virtualEvent->type));
+JNIEXPORT jboolean JNICALL Java_org_jnativehook_GlobalScreen_isNativeReplayActive(JNIEnv *env, jclass cls) {
+	return (jboolean) jni_IsEventReplayActive();
+}
 
-	// Convert Java event to virtual event.
-	virtualEvent->mask = (unsigned int) (*env)->CallIntMethod(env, event, org_jnativehook_NativeInputEvent->getModifiers);
+JNIEXPORT jlong JNICALL Java_org_jnativehook_GlobalScreen_getNativeProperty(JNIEnv *env, jclass cls, jint property) {
+	return jni_GetProperty(property);
+}
 
-	switch (javaType) {
-		case org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_TYPED:
-			virtualEvent->data.keyboard.keychar =
-					(*env)->CallIntMethod(env, event, org_jnativehook_keyboard_NativeKeyEvent->getKeyChar);
-			break;
+JNIEXPORT jboolean JNICALL Java_org_jnativehook_GlobalScreen_setNativeSettingsWatcher(JNIEnv *env, jclass cls, jboolean enabled) {
+	jboolean status = JNI_TRUE;
 
-		case org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_PRESSED:
-		case org_jnativehook_keyboard_NativeKeyEvent_NATIVE_KEY_RELEASED:
-			virtualEvent->data.keyboard.keycode = 
-					(*env)->CallIntMethod(env, event, org_jnativehook_keyboard_NativeKeyEvent->getKeyCode);
-			break;
+	if (enabled == JNI_TRUE) {
+		status = jni_StartSettingsWatcher() ? JNI_TRUE : JNI_FALSE;
+	}
+	else {
+		if (!jni_StopSettingsWatcher(jni_GetNanoTime() + WATCHER_STOP_TIMEOUT)) {
+			status = JNI_FALSE;
+		}
+	}
 
-		case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_CLICKED:
-		case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_PRESSED:
-		case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_RELEASED:
-			virtualEvent->data.mouse.button =
-            		(*env)->CallIntMethod(env, event, org_jnativehook_mouse_NativeMouseEvent->getButton);
-			break;
+	return status;
+}
 
-        // FIXME Implement!
-		case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_MOVED:
-		case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_DRAGGED:
-		case org_jnativehook_mouse_NativeMouseEvent_NATIVE_MOUSE_WHEEL:
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_setNativeStatisticsEnabled(JNIEnv *env, jclass cls, jboolean enabled) {
+	jni_SetStatisticsEnabled(enabled == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_getNativeStatistics(JNIEnv *env, jclass cls, jlongArray statistics) {
+	if ((*env)->GetArrayLength(env, statistics) >= STATISTICS_SIZE) {
+		jlong snapshot[STATISTICS_SIZE];
+		jni_CopyStatistics(snapshot);
+
+		(*env)->SetLongArrayRegion(env, statistics, 0, STATISTICS_SIZE, snapshot);
+	}
+	else {
+		ThrowException(java_lang_IllegalArgumentException, "The statistics array is too small.");
+	}
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_updateNativeLogLevel(JNIEnv *env, jclass cls) {
+	jni_UpdateLogLevel(env);
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_enableLogQueue(JNIEnv *env, jclass cls) {
+	jni_EnableLogQueue();
+}
+
+JNIEXPORT void JNICALL Java_org_jnativehook_GlobalScreen_disableLogQueue(JNIEnv *env, jclass cls) {
+	jni_DisableLogQueue();
+}
+
+JNIEXPORT jint JNICALL Java_org_jnativehook_GlobalScreen_drainLogRecords(JNIEnv *env, jclass cls, jintArray levels, jobjectArray messages, jint timeout) {
+	unsigned int log_levels[LOG_BATCH_SIZE];
+	char log_messages[LOG_BATCH_SIZE][LOG_MESSAGE_SIZE];
+
+	jsize capacity = (*env)->GetArrayLength(env, levels);
+	if ((*env)->GetArrayLength(env, messages) < capacity) {
+		capacity = (*env)->GetArrayLength(env, messages);
+	}
+
+	if (capacity > LOG_BATCH_SIZE) {
+		capacity = LOG_BATCH_SIZE;
+	}
+
+	jint count = jni_DrainLogQueue(log_levels, log_messages, capacity, timeout > 0 ? (unsigned int) timeout : 0);
+
+	jint java_levels[LOG_BATCH_SIZE];
+	jint i;
+	for (i = 0; i < count; i++) {
+		java_levels[i] = (jint) log_levels[i];
+
+		jstring message = (*env)->NewStringUTF(env, log_messages[i]);
+		(*env)->SetObjectArrayElement(env, messages, i, message);
+		(*env)->DeleteLocalRef(env, message);
+	}
 
-		default:
-			break;
+	if (count > 0) {
+		(*env)->SetIntArrayRegion(env, levels, 0, count, java_levels);
 	}
 
-	hook_post_event(virtualEvent);
+	return count;
 }
@@ -0,0 +1,95 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+
+public class DispatchStatisticsTest {
+	/**
+	 * Create a snapshot with a single native sample for the specified event.
+	 */
+	private static DispatchStatistics createStatistics(int id, int stage, int bucket, long count) {
+		long[] nativeStatistics = new long[DispatchStatistics.NATIVE_SIZE];
+		long[] listenerLatency = new long[DispatchStatistics.TYPES * DispatchStatistics.BUCKETS];
+
+		int index = DispatchStatistics.getIndex(id);
+		int record = 1 + index * (1 + DispatchStatistics.NATIVE_STAGES * DispatchStatistics.BUCKETS);
+
+		nativeStatistics[0] = 7;
+		nativeStatistics[record] = count;
+		if (stage == DispatchStatistics.LISTENERS) {
+			listenerLatency[index * DispatchStatistics.BUCKETS + bucket] = count;
+		}
+		else {
+			nativeStatistics[record + 1 + stage * DispatchStatistics.BUCKETS + bucket] = count;
+		}
+
+		return new DispatchStatistics(nativeStatistics, listenerLatency,
+				new int[] { 1, 0, 0, 0 }, new int[] { 3, 0, 0, 0 });
+	}
+
+	/**
+	 * Test of getBucket method, of class DispatchStatistics.
+	 */
+	@Test
+	public void testGetBucket() {
+		System.out.println("getBucket");
+
+		assertEquals(0, DispatchStatistics.getBucket(0));
+		assertEquals(1, DispatchStatistics.getBucket(1));
+		assertEquals(2, DispatchStatistics.getBucket(2));
+		assertEquals(2, DispatchStatistics.getBucket(3));
+		assertEquals(10, DispatchStatistics.getBucket(1000));
+		assertEquals(DispatchStatistics.BUCKETS - 1, DispatchStatistics.getBucket(Long.MAX_VALUE));
+	}
+
+	/**
+	 * Test of the snapshot accessors, of class DispatchStatistics.
+	 */
+	@Test
+	public void testSnapshot() {
+		System.out.println("snapshot");
+
+		DispatchStatistics statistics = createStatistics(NativeKeyEvent.NATIVE_KEY_PRESSED, DispatchStatistics.UPCALL, 10, 5);
+
+		assertEquals(7, statistics.getDroppedEventCount());
+		assertEquals(5, statistics.getEventCount(NativeKeyEvent.NATIVE_KEY_PRESSED));
+		assertEquals(0, statistics.getEventCount(NativeKeyEvent.NATIVE_KEY_RELEASED));
+		assertEquals(5, statistics.getLatencyHistogram(DispatchStatistics.UPCALL, NativeKeyEvent.NATIVE_KEY_PRESSED)[10]);
+		assertEquals(0, statistics.getLatencyHistogram(DispatchStatistics.CONVERSION, NativeKeyEvent.NATIVE_KEY_PRESSED)[10]);
+		assertEquals(1, statistics.getPendingEventCount(NativeKeyEvent.NATIVE_KEY_TYPED));
+		assertEquals(3, statistics.getMaxPendingEventCount(NativeKeyEvent.NATIVE_KEY_RELEASED));
+		assertEquals(0, statistics.getMaxPendingEventCount(NativeMouseEvent.NATIVE_MOUSE_MOVED));
+	}
+
+	/**
+	 * Test of getLatencyPercentile method, of class DispatchStatistics.
+	 */
+	@Test
+	public void testGetLatencyPercentile() {
+		System.out.println("getLatencyPercentile");
+
+		DispatchStatistics statistics = createStatistics(NativeMouseEvent.NATIVE_MOUSE_MOVED, DispatchStatistics.LISTENERS, 12, 100);
+
+		assertEquals(1L << 12, statistics.getLatencyPercentile(DispatchStatistics.LISTENERS, NativeMouseEvent.NATIVE_MOUSE_MOVED, 99.0));
+		assertEquals(0, statistics.getLatencyPercentile(DispatchStatistics.LISTENERS, NativeMouseEvent.NATIVE_MOUSE_DRAGGED, 99.0));
+	}
+}
@@ -19,9 +19,13 @@ package org.jnativehook;
 
 // Imports
 import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
 import javax.swing.event.EventListenerList;
 import org.jnativehook.keyboard.NativeKeyEvent;
 import org.jnativehook.keyboard.NativeKeyListener;
+import org.jnativehook.keyboard.NativeKeyPrimitiveListener;
 import org.jnativehook.keyboard.listeners.NativeKeyListenerImpl;
 import org.jnativehook.mouse.NativeMouseEvent;
 import org.jnativehook.mouse.NativeMouseListener;
@@ -42,29 +46,6 @@ import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.fail;
 
 public class GlobalScreenTest {
-    @Test
-    public void testProperties() {
-		System.out.println("properties");
-
-		assertNotNull("Auto Repeat Rate",
-				System.getProperty("jnativehook.autoRepeatRate"));
-
-		assertNotNull("Auto Repeat Delay",
-				System.getProperty("jnativehook.autoRepeatDelay"));
-
-		assertNotNull("Double Click Time",
-				System.getProperty("jnativehook.multiClickInterval"));
-
-		assertNotNull("Pointer Sensitivity",
-				System.getProperty("jnativehook.pointerSensitivity"));
-
-		assertNotNull("Pointer Acceleration Multiplier",
-				System.getProperty("jnativehook.pointerAccelerationMultiplier"));
-
-		assertNotNull("Pointer Acceleration Threshold",
-				System.getProperty("jnativehook.pointerAccelerationThreshold"));
-    }
-
 	/**
 	 * Test of getInstance method, of class GlobalScreen.
 	 */
@@ -608,4 +589,98 @@ public class GlobalScreenTest {
 		eventExecutor.setAccessible(true);
 		assertNull(eventExecutor.get(GlobalScreen.getInstance()));
 	}
+
+	/**
+	 * Test of addNativeKeyPrimitiveListener method, of class GlobalScreen.
+	 */
+	@Test
+	public void testAddNativeKeyPrimitiveListener() throws NoSuchMethodException, IllegalAccessException, java.lang.reflect.InvocationTargetException {
+		System.out.println("addNativeKeyPrimitiveListener");
+
+		final int[] values = new int[4];
+		final long[] when = new long[1];
+		NativeKeyPrimitiveListener listener = new NativeKeyPrimitiveListener() {
+			public void onKey(int id, int keyCode, int rawCode, int modifiers, long time) {
+				values[0] = id;
+				values[1] = keyCode;
+				values[2] = rawCode;
+				values[3] = modifiers;
+				when[0] = time;
+			}
+		};
+
+		Method dispatchKeyPrimitive = GlobalScreen.class.getDeclaredMethod("dispatchKeyPrimitive",
+				int.class, int.class, int.class, int.class, long.class);
+		dispatchKeyPrimitive.setAccessible(true);
+
+		GlobalScreen.getInstance().addNativeKeyPrimitiveListener(listener);
+		dispatchKeyPrimitive.invoke(GlobalScreen.getInstance(),
+				NativeKeyEvent.NATIVE_KEY_PRESSED, NativeKeyEvent.VC_A, 0x41, NativeInputEvent.SHIFT_L_MASK, 1234L);
+
+		assertEquals(NativeKeyEvent.NATIVE_KEY_PRESSED, values[0]);
+		assertEquals(NativeKeyEvent.VC_A, values[1]);
+		assertEquals(0x41, values[2]);
+		assertEquals(NativeInputEvent.SHIFT_L_MASK, values[3]);
+		assertEquals(1234L, when[0]);
+
+		// Removed listeners are no longer called.
+		GlobalScreen.getInstance().removeNativeKeyPrimitiveListener(listener);
+		dispatchKeyPrimitive.invoke(GlobalScreen.getInstance(),
+				NativeKeyEvent.NATIVE_KEY_RELEASED, NativeKeyEvent.VC_A, 0x41, 0x00, 5678L);
+
+		assertEquals(NativeKeyEvent.NATIVE_KEY_PRESSED, values[0]);
+	}
+
+	/**
+	 * Test of postNativeEvent method with an event of the wrong class, of class GlobalScreen.
+	 */
+	@Test(expected = IllegalArgumentException.class)
+	public void testPostNativeEventMismatch() {
+		System.out.println("postNativeEventMismatch");
+
+		// A wheel event id without the wheel event fields.
+		GlobalScreen.postNativeEvent(new NativeInputEvent(
+				GlobalScreen.getInstance(),
+				NativeMouseEvent.NATIVE_MOUSE_WHEEL,
+				System.currentTimeMillis(),
+				0x00));
+	}
+
+	/**
+	 * Test of postNativeEvent method with a null event, of class GlobalScreen.
+	 */
+	@Test(expected = NullPointerException.class)
+	public void testPostNativeEventNull() {
+		System.out.println("postNativeEventNull");
+
+		GlobalScreen.postNativeEvent(null);
+	}
+
+	/**
+	 * Test of setMouseWheelAccumulation method, of class GlobalScreen.
+	 */
+	@Test(expected = IllegalArgumentException.class)
+	public void testSetMouseWheelAccumulation() {
+		System.out.println("setMouseWheelAccumulation");
+
+		GlobalScreen.getInstance().setMouseWheelAccumulation(50, 0);
+		GlobalScreen.getInstance().setMouseWheelAccumulation(0, 0);
+
+		GlobalScreen.getInstance().setMouseWheelAccumulation(-1, 0);
+	}
+
+	/**
+	 * Test of shutdown method, of class GlobalScreen.
+	 */
+	@Test
+	public void testShutdown() throws NativeHookException {
+		System.out.println("shutdown");
+
+		GlobalScreen.registerNativeHook();
+		assertTrue(GlobalScreen.shutdown(5, TimeUnit.SECONDS));
+		assertFalse(GlobalScreen.isNativeHookRegistered());
+
+		// Restore a dispatcher for the remaining tests.
+		GlobalScreen.getInstance().setEventDispatcher(Executors.newSingleThreadExecutor());
+	}
 }
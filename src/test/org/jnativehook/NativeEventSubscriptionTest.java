@@ -0,0 +1,149 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+public class NativeEventSubscriptionTest {
+	/**
+	 * A consumer that waits for the test before returning from the first event.
+	 */
+	private static class BlockingConsumer implements NativeEventConsumer {
+		final CountDownLatch received = new CountDownLatch(1);
+		final CountDownLatch release = new CountDownLatch(1);
+
+		public void nativeEventReceived(NativeInputEvent event) {
+			received.countDown();
+
+			try {
+				release.await();
+			}
+			catch (InterruptedException e) {
+				Thread.currentThread().interrupt();
+			}
+		}
+	}
+
+	private static NativeMouseEvent createMotionEvent(int x) {
+		return new NativeMouseEvent(
+				NativeMouseEvent.NATIVE_MOUSE_MOVED,
+				System.currentTimeMillis(),
+				0x00,	// Modifiers
+				x,		// X
+				75,		// Y
+				0,		// Click Count
+				NativeMouseEvent.NOBUTTON);
+	}
+
+	private static NativeMouseWheelEvent createWheelEvent(int rotation) {
+		return new NativeMouseWheelEvent(
+				NativeMouseEvent.NATIVE_MOUSE_WHEEL,
+				System.currentTimeMillis(),
+				0x00,	// Modifiers
+				50,		// X
+				75,		// Y
+				1,		// Click Count
+				NativeMouseWheelEvent.WHEEL_UNIT_SCROLL,
+				3,		// Scroll Amount
+				rotation);
+	}
+
+	/**
+	 * Test of the DROP_NEWEST overflow policy, of class NativeEventSubscription.
+	 */
+	@Test
+	public void testDropNewest() throws InterruptedException {
+		System.out.println("dropNewest");
+
+		BlockingConsumer consumer = new BlockingConsumer();
+		NativeEventSubscription subscription = new NativeEventSubscription(consumer, 2, NativeEventSubscription.OverflowPolicy.DROP_NEWEST);
+
+		// The first event is taken by the consumer thread and blocks it.
+		subscription.offer(createMotionEvent(0));
+		assertTrue(consumer.received.await(5, TimeUnit.SECONDS));
+
+		for (int i = 1; i <= 5; i++) {
+			subscription.offer(createMotionEvent(i));
+		}
+
+		assertEquals(2, subscription.getQueueSize());
+		assertEquals(2, subscription.getMaxQueueSize());
+		assertEquals(3, subscription.getDroppedCount());
+		assertEquals(1, subscription.getDeliveredCount());
+
+		subscription.close();
+		consumer.release.countDown();
+
+		assertFalse(subscription.isActive());
+		assertEquals(0, subscription.getQueueSize());
+	}
+
+	/**
+	 * Test of the COALESCE overflow policy, of class NativeEventSubscription.
+	 */
+	@Test
+	public void testCoalesce() throws InterruptedException {
+		System.out.println("coalesce");
+
+		BlockingConsumer consumer = new BlockingConsumer();
+		NativeEventSubscription subscription = new NativeEventSubscription(consumer, 1, NativeEventSubscription.OverflowPolicy.COALESCE);
+
+		subscription.offer(createMotionEvent(0));
+		assertTrue(consumer.received.await(5, TimeUnit.SECONDS));
+
+		for (int i = 1; i <= 4; i++) {
+			subscription.offer(createMotionEvent(i));
+		}
+
+		assertEquals(1, subscription.getQueueSize());
+		assertEquals(3, subscription.getCoalescedCount());
+		assertEquals(0, subscription.getDroppedCount());
+
+		subscription.close();
+		consumer.release.countDown();
+	}
+
+	/**
+	 * Test of merge method, of class NativeEventSubscription.
+	 */
+	@Test
+	public void testMerge() {
+		System.out.println("merge");
+
+		NativeMouseEvent motion = (NativeMouseEvent) NativeEventSubscription.merge(createMotionEvent(10), createMotionEvent(20));
+		assertEquals(20, motion.getX());
+		assertEquals(2, motion.getCoalescedCount());
+
+		NativeMouseWheelEvent wheel = (NativeMouseWheelEvent) NativeEventSubscription.merge(createWheelEvent(-1), createWheelEvent(-2));
+		assertEquals(-3, wheel.getWheelRotation());
+		assertEquals(3, wheel.getScrollAmount());
+		assertEquals(2, wheel.getCoalescedCount());
+
+		// Events in opposite directions or of different types are never merged.
+		assertNull(NativeEventSubscription.merge(createWheelEvent(-1), createWheelEvent(1)));
+		assertNull(NativeEventSubscription.merge(createMotionEvent(10), createWheelEvent(1)));
+	}
+}
@@ -0,0 +1,266 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class NativeEventViewTest {
+	/**
+	 * Write a single record in the native event queue layout.
+	 */
+	private static ByteBuffer createRecords(long when, int id, int modifiers, int a, int b, int c, int d, int e, int f) {
+		ByteBuffer buffer = ByteBuffer.allocateDirect(2 * NativeEventView.RECORD_BYTES);
+		buffer.order(ByteOrder.nativeOrder());
+
+		// Place the record at index 1 to verify the view offset.
+		int offset = NativeEventView.RECORD_BYTES;
+		buffer.putLong(offset, when);
+		buffer.putLong(offset + 8, ((long) id << 32) | (modifiers & 0xFFFFFFFFL));
+		buffer.putLong(offset + 16, ((long) a << 32) | (b & 0xFFFFFFFFL));
+		buffer.putLong(offset + 24, ((long) c << 32) | (d & 0xFFFFFFFFL));
+		buffer.putLong(offset + 32, ((long) e << 32) | (f & 0xFFFFFFFFL));
+
+		return buffer;
+	}
+
+	/**
+	 * Test of key accessors, of class NativeEventView.
+	 */
+	@Test
+	public void testKeyEvent() {
+		System.out.println("keyEvent");
+
+		NativeEventView view = new NativeEventView(createRecords(
+				1234L,
+				NativeKeyEvent.NATIVE_KEY_PRESSED,
+				NativeInputEvent.SHIFT_L_MASK,
+				0x41,		// Raw Code
+				NativeKeyEvent.VC_A,
+				NativeKeyEvent.CHAR_UNDEFINED,
+				NativeKeyEvent.KEY_LOCATION_STANDARD,
+				0, 0));
+		view.setIndex(1);
+
+		assertEquals(1234L, view.getWhen());
+		assertEquals(NativeKeyEvent.NATIVE_KEY_PRESSED, view.getID());
+		assertEquals(NativeInputEvent.SHIFT_L_MASK, view.getModifiers());
+		assertEquals(0x41, view.getRawCode());
+		assertEquals(NativeKeyEvent.VC_A, view.getKeyCode());
+		assertEquals(NativeKeyEvent.CHAR_UNDEFINED, view.getKeyChar());
+		assertEquals(NativeKeyEvent.KEY_LOCATION_STANDARD, view.getKeyLocation());
+	}
+
+	/**
+	 * Test of mouse wheel accessors, of class NativeEventView.
+	 */
+	@Test
+	public void testMouseWheelEvent() {
+		System.out.println("mouseWheelEvent");
+
+		NativeEventView view = new NativeEventView(createRecords(
+				1234L,
+				NativeMouseEvent.NATIVE_MOUSE_WHEEL,
+				0x00,		// Modifiers
+				-50,		// X
+				75,			// Y
+				1,			// Click Count
+				NativeMouseWheelEvent.WHEEL_UNIT_SCROLL,
+				3,			// Scroll Amount
+				-1));		// Wheel Rotation
+		view.setIndex(1);
+
+		assertEquals(NativeMouseEvent.NATIVE_MOUSE_WHEEL, view.getID());
+		assertEquals(-50, view.getX());
+		assertEquals(75, view.getY());
+		assertEquals(1, view.getClickCount());
+		assertEquals(NativeMouseWheelEvent.WHEEL_UNIT_SCROLL, view.getScrollType());
+		assertEquals(3, view.getScrollAmount());
+		assertEquals(-1, view.getWheelRotation());
+	}
+
+	/**
+	 * Test of createEvent method, of class NativeEventView.
+	 */
+	@Test
+	public void testCreateEvent() {
+		System.out.println("createEvent");
+
+		NativeEventView view = new NativeEventView(createRecords(
+				1234L,
+				NativeMouseEvent.NATIVE_MOUSE_PRESSED,
+				NativeInputEvent.BUTTON1_MASK,
+				50,			// X
+				75,			// Y
+				1,			// Click Count
+				NativeMouseEvent.BUTTON1,
+				0, 0));
+		view.setIndex(1);
+
+		NativeInputEvent event = view.createEvent();
+		assertTrue(event instanceof NativeMouseEvent);
+		assertEquals(NativeMouseEvent.NATIVE_MOUSE_PRESSED, event.getID());
+		assertEquals(1234L, event.getWhen());
+		assertEquals(50, ((NativeMouseEvent) event).getX());
+		assertEquals(75, ((NativeMouseEvent) event).getY());
+		assertEquals(NativeMouseEvent.BUTTON1, ((NativeMouseEvent) event).getButton());
+	}
+
+	/**
+	 * Test of getCoalescedCount method, of class NativeEventView.
+	 */
+	@Test
+	public void testCoalescedMotionEvent() {
+		System.out.println("coalescedMotionEvent");
+
+		NativeEventView view = new NativeEventView(createRecords(
+				1234L,
+				NativeMouseEvent.NATIVE_MOUSE_MOVED,
+				0x00,		// Modifiers
+				50,			// X
+				75,			// Y
+				0,			// Click Count
+				NativeMouseEvent.NOBUTTON,
+				0,
+				4));		// Coalesced Count
+		view.setIndex(1);
+
+		assertEquals(4, view.getCoalescedCount());
+
+		NativeMouseEvent event = (NativeMouseEvent) view.createEvent();
+		assertEquals(NativeMouseEvent.NATIVE_MOUSE_MOVED, event.getID());
+		assertEquals(50, event.getX());
+		assertEquals(75, event.getY());
+		assertEquals(4, event.getCoalescedCount());
+	}
+
+	/**
+	 * Test of writeRecord method, of class NativeEventView.
+	 */
+	@Test
+	public void testWriteRecord() {
+		System.out.println("writeRecord");
+
+		NativeMouseWheelEvent event = new NativeMouseWheelEvent(
+				NativeMouseEvent.NATIVE_MOUSE_WHEEL,
+				1234L,
+				0x00,		// Modifiers
+				-50,		// X
+				75,			// Y
+				1,			// Click Count
+				NativeMouseWheelEvent.WHEEL_UNIT_SCROLL,
+				3,			// Scroll Amount
+				-1);		// Wheel Rotation
+
+		long[] records = new long[2 * NativeEventView.RECORD_SIZE];
+		NativeEventView.writeRecord(event, records, 1);
+
+		ByteBuffer buffer = ByteBuffer.allocateDirect(records.length * 8);
+		buffer.order(ByteOrder.nativeOrder());
+		buffer.asLongBuffer().put(records);
+
+		NativeEventView view = new NativeEventView(buffer);
+		view.setIndex(1);
+
+		assertEquals(1234L, view.getWhen());
+		assertEquals(NativeMouseEvent.NATIVE_MOUSE_WHEEL, view.getID());
+		assertEquals(-50, view.getX());
+		assertEquals(75, view.getY());
+		assertEquals(1, view.getClickCount());
+		assertEquals(NativeMouseWheelEvent.WHEEL_UNIT_SCROLL, view.getScrollType());
+		assertEquals(3, view.getScrollAmount());
+		assertEquals(-1, view.getWheelRotation());
+	}
+
+	/**
+	 * Test of getCoalescedCount method for wheel events, of class NativeEventView.
+	 */
+	@Test
+	public void testCoalescedWheelEvent() {
+		System.out.println("coalescedWheelEvent");
+
+		NativeMouseWheelEvent event = new NativeMouseWheelEvent(
+				NativeMouseEvent.NATIVE_MOUSE_WHEEL,
+				1234L,
+				0x00,		// Modifiers
+				-50,		// X
+				75,			// Y
+				1,			// Click Count
+				NativeMouseWheelEvent.WHEEL_BLOCK_SCROLL,
+				3,			// Scroll Amount
+				-5,			// Wheel Rotation
+				5);			// Coalesced Count
+
+		long[] records = new long[2 * NativeEventView.RECORD_SIZE];
+		NativeEventView.writeRecord(event, records, 1);
+
+		ByteBuffer buffer = ByteBuffer.allocateDirect(records.length * 8);
+		buffer.order(ByteOrder.nativeOrder());
+		buffer.asLongBuffer().put(records);
+
+		NativeEventView view = new NativeEventView(buffer);
+		view.setIndex(1);
+
+		assertEquals(5, view.getCoalescedCount());
+		assertEquals(1, view.getClickCount());
+		assertEquals(NativeMouseWheelEvent.WHEEL_BLOCK_SCROLL, view.getScrollType());
+		assertEquals(-5, view.getWheelRotation());
+
+		NativeMouseWheelEvent copy = (NativeMouseWheelEvent) view.createEvent();
+		assertEquals(5, copy.getCoalescedCount());
+		assertEquals(NativeMouseWheelEvent.WHEEL_BLOCK_SCROLL, copy.getScrollType());
+		assertEquals(-5, copy.getWheelRotation());
+	}
+
+	/**
+	 * Test of getCaptureTime method, of class NativeEventView.
+	 */
+	@Test
+	public void testCaptureTime() {
+		System.out.println("captureTime");
+
+		NativeKeyEvent event = new NativeKeyEvent(
+				NativeKeyEvent.NATIVE_KEY_PRESSED,
+				1234L,
+				0x00,		// Modifiers
+				0x41,		// Raw Code
+				NativeKeyEvent.VC_A,
+				NativeKeyEvent.CHAR_UNDEFINED,
+				NativeKeyEvent.KEY_LOCATION_STANDARD);
+		event.setCaptureTime(987654321L);
+
+		long[] records = new long[2 * NativeEventView.RECORD_SIZE];
+		NativeEventView.writeRecord(event, records, 1);
+
+		ByteBuffer buffer = ByteBuffer.allocateDirect(records.length * 8);
+		buffer.order(ByteOrder.nativeOrder());
+		buffer.asLongBuffer().put(records);
+
+		NativeEventView view = new NativeEventView(buffer);
+		view.setIndex(1);
+
+		assertEquals(987654321L, view.getCaptureTime());
+		assertEquals(987654321L, view.createEvent().getCaptureTime());
+	}
+}
@@ -130,4 +130,29 @@ public class NativeInputEventTest {
 
 		assertFalse(event.paramString().equals(""));
 	}
+
+	/**
+	 * Test of getCaptureTime and getDispatchTime methods, of class NativeInputEvent.
+	 */
+	@Test
+	public void testGetTimestamps() {
+		System.out.println("getTimestamps");
+
+		NativeInputEvent event = new NativeInputEvent(
+				GlobalScreen.getInstance(),
+				NativeKeyEvent.NATIVE_KEY_PRESSED,
+				System.currentTimeMillis(),
+				0x00);
+
+		// Events created in Java are not stamped.
+		assertEquals(0L, event.getCaptureTime());
+		assertEquals(0L, event.getDispatchTime());
+
+		long now = System.nanoTime();
+		event.setCaptureTime(now);
+		event.setDispatchTime(now + 1000);
+
+		assertEquals(now, event.getCaptureTime());
+		assertEquals(now + 1000, event.getDispatchTime());
+	}
 }
@@ -0,0 +1,145 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+import java.io.ByteArrayInputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+public class NativeLibraryCacheTest {
+	private static final byte[] LIBRARY = "JNativeHook native library".getBytes();
+
+	private File cacheDir;
+
+	@Before
+	public void setUp() throws IOException {
+		File tmpFile = File.createTempFile("jnativehook_test", "");
+		tmpFile.delete();
+
+		cacheDir = new File(tmpFile.getPath() + ".d");
+	}
+
+	@After
+	public void tearDown() {
+		File[] files = cacheDir.listFiles();
+		if (files != null) {
+			for (int i = 0; i < files.length; i++) {
+				files[i].delete();
+			}
+		}
+
+		cacheDir.delete();
+	}
+
+	/**
+	 * Test of getCacheDirectory method, of class NativeLibraryCache.
+	 */
+	@Test
+	public void testGetCacheDirectory() {
+		System.out.println("getCacheDirectory");
+
+		File baseDir = new File("base");
+		assertEquals(new File(baseDir, "jnativehook-alex-1.2.0"), NativeLibraryCache.getCacheDirectory(baseDir, "alex", "1.2.0"));
+		assertEquals(new File(baseDir, "jnativehook-DOMAIN_alex-1.2_beta"), NativeLibraryCache.getCacheDirectory(baseDir, "DOMAIN\\alex", "1.2/beta"));
+	}
+
+	/**
+	 * Test of toHex method, of class NativeLibraryCache.
+	 */
+	@Test
+	public void testToHex() {
+		System.out.println("toHex");
+
+		assertEquals("00ff7f10", NativeLibraryCache.toHex(new byte[] { 0x00, (byte) 0xFF, 0x7F, 0x10 }));
+	}
+
+	/**
+	 * Test of extract method, of class NativeLibraryCache.
+	 */
+	@Test
+	public void testExtract() throws IOException {
+		System.out.println("extract");
+
+		File libFile = NativeLibraryCache.extract(new ByteArrayInputStream(LIBRARY), cacheDir, "libJNativeHook_", ".so");
+		assertTrue(libFile.isFile());
+		assertEquals(cacheDir, libFile.getParentFile());
+		assertEquals(LIBRARY.length, libFile.length());
+
+		// A second launch reuses the same file.
+		File cachedFile = NativeLibraryCache.extract(new ByteArrayInputStream(LIBRARY), cacheDir, "libJNativeHook_", ".so");
+		assertEquals(libFile, cachedFile);
+
+		// No temporary files are left behind.
+		assertEquals(1, cacheDir.listFiles().length);
+	}
+
+	/**
+	 * Test of extract method with a damaged cached copy, of class NativeLibraryCache.
+	 */
+	@Test
+	public void testExtractDamaged() throws IOException, NoSuchAlgorithmException {
+		System.out.println("extractDamaged");
+
+		File libFile = NativeLibraryCache.extract(new ByteArrayInputStream(LIBRARY), cacheDir, "libJNativeHook_", ".so");
+
+		// Damage the cached copy without changing its size.
+		byte[] damaged = LIBRARY.clone();
+		damaged[0] ^= 0xFF;
+		FileOutputStream outputStream = new FileOutputStream(libFile);
+		outputStream.write(damaged);
+		outputStream.close();
+
+		File replacedFile = NativeLibraryCache.extract(new ByteArrayInputStream(LIBRARY), cacheDir, "libJNativeHook_", ".so");
+		assertEquals(libFile, replacedFile);
+		assertTrue(NativeLibraryCache.isValid(replacedFile, LIBRARY.length, MessageDigest.getInstance("SHA-1").digest(LIBRARY)));
+	}
+
+	/**
+	 * Test of extract method with a shared cache directory, of class NativeLibraryCache.
+	 */
+	@Test
+	public void testExtractShared() throws IOException {
+		System.out.println("extractShared");
+
+		// Both permission checks require a POSIX file system.
+		if (File.separatorChar == '/') {
+			assertTrue(cacheDir.mkdirs());
+			assertTrue(cacheDir.setWritable(true, false));
+
+			File libFile = NativeLibraryCache.extract(new ByteArrayInputStream(LIBRARY), cacheDir, "libJNativeHook_", ".so");
+			try {
+				// The library is extracted to a private file outside the cache.
+				assertFalse(cacheDir.equals(libFile.getParentFile()));
+				assertEquals(LIBRARY.length, libFile.length());
+				assertEquals(0, cacheDir.listFiles().length);
+			}
+			finally {
+				libFile.delete();
+			}
+		}
+	}
+}
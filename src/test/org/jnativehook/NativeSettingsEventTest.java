@@ -0,0 +1,62 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook;
+
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+public class NativeSettingsEventTest {
+	/**
+	 * Test of isChanged method, of class NativeSettingsEvent.
+	 */
+	@Test
+	public void testIsChanged() {
+		System.out.println("isChanged");
+
+		long[] previous = new long[] { 25, 500, 2, 4, 10, 500 };
+		long[] current = new long[] { 30, 500, 2, 4, 10, 400 };
+		NativeSettingsEvent event = new NativeSettingsEvent(this, previous, current);
+
+		assertTrue(event.isChanged(NativeSystem.Setting.AUTO_REPEAT_RATE));
+		assertFalse(event.isChanged(NativeSystem.Setting.AUTO_REPEAT_DELAY));
+		assertTrue(event.isChanged(NativeSystem.Setting.MULTI_CLICK_INTERVAL));
+
+		assertEquals(25, event.getPreviousValue(NativeSystem.Setting.AUTO_REPEAT_RATE));
+		assertEquals(30, event.getValue(NativeSystem.Setting.AUTO_REPEAT_RATE));
+
+		// The event keeps its own copy of the values.
+		current[0] = 25;
+		assertTrue(event.isChanged(NativeSystem.Setting.AUTO_REPEAT_RATE));
+	}
+
+	/**
+	 * Test of paramString method, of class NativeSettingsEvent.
+	 */
+	@Test
+	public void testParamString() {
+		System.out.println("paramString");
+
+		NativeSettingsEvent event = new NativeSettingsEvent(this,
+				new long[] { 25, 500, 2, 4, 10, 500 },
+				new long[] { 25, 500, 2, 4, 10, 400 });
+
+		assertEquals("NATIVE_SETTINGS_CHANGED,MULTI_CLICK_INTERVAL=400", event.paramString());
+	}
+}
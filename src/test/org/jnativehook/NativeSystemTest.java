@@ -18,7 +18,9 @@
 package org.jnativehook;
 
 import org.junit.Test;
+import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
 
 public class NativeSystemTest {
 	/**
@@ -40,4 +42,50 @@ public class NativeSystemTest {
 
 		assertFalse(NativeSystem.getArchitecture().equals(NativeSystem.Arch.UNSUPPORTED));
 	}
+
+	/**
+	 * Test of the native setting accessors, of class NativeSystem.
+	 */
+	@Test
+	public void testProperties() {
+		System.out.println("properties");
+
+		assertTrue("Auto Repeat Rate", NativeSystem.getAutoRepeatRate() >= -1);
+		assertTrue("Auto Repeat Delay", NativeSystem.getAutoRepeatDelay() >= -1);
+		assertTrue("Double Click Time", NativeSystem.getMultiClickInterval() >= -1);
+		assertTrue("Pointer Sensitivity", NativeSystem.getPointerSensitivity() >= -1);
+		assertTrue("Pointer Acceleration Multiplier", NativeSystem.getPointerAccelerationMultiplier() >= -1);
+		assertTrue("Pointer Acceleration Threshold", NativeSystem.getPointerAccelerationThreshold() >= -1);
+
+	}
+
+	/**
+	 * Test of the native setting cache, of class NativeSystem.
+	 */
+	@Test
+	public void testPropertyCache() {
+		System.out.println("propertyCache");
+
+		// The first read after an invalidation queries the platform.
+		NativeSystem.invalidateProperties();
+		long queries = NativeSystem.getPropertyQueries();
+		long rate = NativeSystem.getAutoRepeatRate();
+		assertEquals("Initial Query", queries + 1, NativeSystem.getPropertyQueries());
+		assertEquals("Native Value", GlobalScreen.getNativeProperty(GlobalScreen.PROPERTY_AUTO_REPEAT_RATE), rate);
+
+		// Cached values are returned until the settings change.
+		assertEquals("Cached Value", rate, NativeSystem.getAutoRepeatRate());
+		assertEquals("Cached Query", queries + 1, NativeSystem.getPropertyQueries());
+
+		// Every setting is queried again after an invalidation.
+		NativeSystem.invalidateProperties();
+		long[] values = NativeSystem.getProperties();
+		assertEquals("Invalidated Query", queries + 1 + GlobalScreen.PROPERTY_COUNT, NativeSystem.getPropertyQueries());
+
+		for (int i = 0; i < values.length; i++) {
+			assertEquals("Property " + i, GlobalScreen.getNativeProperty(i), values[i]);
+		}
+
+		assertEquals("Cached Query", queries + 1 + GlobalScreen.PROPERTY_COUNT, NativeSystem.getPropertyQueries());
+	}
 }
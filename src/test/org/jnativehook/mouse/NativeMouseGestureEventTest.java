@@ -0,0 +1,95 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.mouse;
+
+import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class NativeMouseGestureEventTest {
+	/**
+	 * Test of getDeltaX and getDeltaY methods, of class NativeMouseGestureEvent.
+	 */
+	@Test
+	public void testGetDelta() {
+		System.out.println("getDelta");
+
+		NativeMouseGestureEvent event = new NativeMouseGestureEvent(
+				NativeMouseGestureEvent.NATIVE_MOUSE_DRAG_ENDED,
+				System.currentTimeMillis(),
+				0x00,	// Modifiers
+				50,		// X
+				75,		// Y
+				0,		// Click Count
+				NativeMouseEvent.BUTTON1,
+				-20,	// Delta X
+				35,		// Delta Y
+				0);		// Wheel Rotation
+
+		assertEquals(-20, event.getDeltaX());
+		assertEquals(35, event.getDeltaY());
+		assertEquals(NativeMouseEvent.BUTTON1, event.getButton());
+	}
+
+	/**
+	 * Test of getWheelRotation method, of class NativeMouseGestureEvent.
+	 */
+	@Test
+	public void testGetWheelRotation() {
+		System.out.println("getWheelRotation");
+
+		NativeMouseGestureEvent event = new NativeMouseGestureEvent(
+				NativeMouseGestureEvent.NATIVE_MOUSE_WHEEL_BURST,
+				System.currentTimeMillis(),
+				0x00,	// Modifiers
+				50,		// X
+				75,		// Y
+				4,		// Wheel Event Count
+				NativeMouseEvent.NOBUTTON,
+				0,		// Delta X
+				0,		// Delta Y
+				-12);	// Wheel Rotation
+
+		assertEquals(-12, event.getWheelRotation());
+		assertEquals(4, event.getClickCount());
+	}
+
+	/**
+	 * Test of paramString method, of class NativeMouseGestureEvent.
+	 */
+	@Test
+	public void testParamString() {
+		System.out.println("paramString");
+
+		NativeMouseGestureEvent event = new NativeMouseGestureEvent(
+				NativeMouseGestureEvent.NATIVE_MOUSE_MULTI_CLICKED,
+				System.currentTimeMillis(),
+				0x00,	// Modifiers
+				50,		// X
+				75,		// Y
+				3,		// Click Count
+				NativeMouseEvent.BUTTON1,
+				0,		// Delta X
+				0,		// Delta Y
+				0);		// Wheel Rotation
+
+		String param = event.paramString();
+		assertTrue(param.startsWith("NATIVE_MOUSE_MULTI_CLICKED,(50,75)"));
+		assertTrue(param.contains("clickCount=3"));
+	}
+}
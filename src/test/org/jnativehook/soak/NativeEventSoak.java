@@ -0,0 +1,404 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.soak;
+
+//Imports
+import org.jnativehook.DispatchStatistics;
+import org.jnativehook.GlobalScreen;
+import org.jnativehook.NativeHookException;
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.mouse.NativeMouseEvent;
+
+import java.io.BufferedReader;
+import java.io.FileReader;
+import java.io.IOException;
+import java.lang.management.ManagementFactory;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * A long running soak test that pushes a mix of key and mouse events through
+ * the full dispatch pipeline and watches for slow leaks and latency drift.
+ * Every report interval the harness prints the number of events sent and
+ * received, the heap in use after a full collection, the native resident
+ * set size, the dispatch queue depth and the capture to listener latency
+ * percentiles.
+ * <p/>
+ *
+ * The harness is run by <code>ant soak</code> and is configured with the
+ * following system properties:
+ * <ul>
+ * 	<li><code>jnativehook.soak.duration</code> the run time in seconds,
+ * 	default 600.</li>
+ * 	<li><code>jnativehook.soak.interval</code> the report interval in
+ * 	seconds, default 10.</li>
+ * 	<li><code>jnativehook.soak.rate</code> the number of events generated per
+ * 	second, default 50000.</li>
+ * 	<li><code>jnativehook.soak.warmup</code> the number of reports before the
+ * 	memory baseline is taken, default 3.</li>
+ * 	<li><code>jnativehook.soak.heapGrowth</code> and
+ * 	<code>jnativehook.soak.rssGrowth</code> the allowed growth over the
+ * 	baseline in megabytes, default 16 and 32.</li>
+ * 	<li><code>jnativehook.soak.mode</code> either <code>dispatch</code> or
+ * 	<code>post</code>, default <code>dispatch</code>.</li>
+ * </ul>
+ * <p/>
+ *
+ * In <code>dispatch</code> mode events are generated by the native benchmark
+ * driver, which calls <code>jni_EventDispatcher()</code> directly and does
+ * not require the native hook.  In <code>post</code> mode the native hook is
+ * registered and shift key presses and mouse motion are injected with
+ * {@link GlobalScreen#postNativeEvent(org.jnativehook.NativeInputEvent)}.
+ * <b>Note:</b> post mode sends real input to the desktop session.
+ * <p/>
+ *
+ * The process exits with a non-zero status if the heap or resident set size
+ * grew beyond the allowed limits or, in <code>dispatch</code> mode, if any
+ * generated event was not delivered.
+ *
+ * @since 1.2
+ */
+public class NativeEventSoak {
+	/** The event types generated in dispatch mode. */
+	private static final int[] DISPATCH_MIX = {
+		NativeKeyEvent.NATIVE_KEY_PRESSED,
+		NativeKeyEvent.NATIVE_KEY_TYPED,
+		NativeKeyEvent.NATIVE_KEY_RELEASED,
+		NativeMouseEvent.NATIVE_MOUSE_MOVED,
+		NativeMouseEvent.NATIVE_MOUSE_PRESSED,
+		NativeMouseEvent.NATIVE_MOUSE_RELEASED,
+		NativeMouseEvent.NATIVE_MOUSE_CLICKED,
+		NativeMouseEvent.NATIVE_MOUSE_MOVED,
+		NativeMouseEvent.NATIVE_MOUSE_WHEEL
+	};
+
+	/** One native event id from each dispatch queue group. */
+	private static final int[] GROUP_IDS = {
+		NativeKeyEvent.NATIVE_KEY_PRESSED,
+		NativeMouseEvent.NATIVE_MOUSE_PRESSED,
+		NativeMouseEvent.NATIVE_MOUSE_MOVED,
+		NativeMouseEvent.NATIVE_MOUSE_WHEEL
+	};
+
+	/** The largest number of events of one type generated in a row. */
+	private static final int BATCH = 16;
+
+	/** The time allowed for queued events to be delivered at the end. */
+	private static final long DRAIN_TIMEOUT = TimeUnit.SECONDS.toNanos(30);
+
+	private static final long MEGABYTE = 1024 * 1024;
+
+	private final long duration = TimeUnit.SECONDS.toNanos(Long.getLong("jnativehook.soak.duration", 600));
+	private final long interval = TimeUnit.SECONDS.toNanos(Long.getLong("jnativehook.soak.interval", 10));
+	private final long rate = Long.getLong("jnativehook.soak.rate", 50000);
+	private final int warmup = Integer.getInteger("jnativehook.soak.warmup", 3);
+	private final long maxHeapGrowth = Long.getLong("jnativehook.soak.heapGrowth", 16) * MEGABYTE;
+	private final long maxRssGrowth = Long.getLong("jnativehook.soak.rssGrowth", 32) * MEGABYTE;
+	private final boolean post = "post".equals(System.getProperty("jnativehook.soak.mode", "dispatch"));
+
+	private final GlobalScreen screen = GlobalScreen.getInstance();
+	private final SoakListener listener = new SoakListener();
+
+	/** The number of native events generated. */
+	private long sent = 0;
+
+	/** The position in the event mix. */
+	private int slot = 0;
+
+	/** The memory baseline taken after the warm up reports. */
+	private long baseHeap = -1, baseRss = -1;
+
+	/** The most recent memory sample. */
+	private long lastHeap = -1, lastRss = -1;
+
+	/** The largest dispatch queue depth seen by any report. */
+	private int maxDepth = 0;
+
+	public static void main(String[] args) throws NativeHookException, InterruptedException {
+		boolean passed = new NativeEventSoak().run();
+
+		System.exit(passed ? 0 : 1);
+	}
+
+	/**
+	 * Run the soak test for the configured duration.
+	 *
+	 * @return true if no leak or lost event was detected.
+	 */
+	boolean run() throws NativeHookException, InterruptedException {
+		GlobalScreen.setEventTimestamps(true);
+		screen.setDispatchStatisticsEnabled(true);
+
+		screen.addNativeKeyListener(listener);
+		screen.addNativeMouseListener(listener);
+		screen.addNativeMouseMotionListener(listener);
+		screen.addNativeMouseWheelListener(listener);
+
+		if (post) {
+			GlobalScreen.registerNativeHook();
+		}
+
+		System.out.printf("Soak test running for %d seconds at %d events per second in %s mode.%n",
+				TimeUnit.NANOSECONDS.toSeconds(duration), rate, post ? "post" : "dispatch");
+
+		long start = System.nanoTime();
+		long report = start + interval;
+		int reports = 0;
+
+		long now = start;
+		while (now - start < duration) {
+			long due = (long) ((now - start) / 1e9 * rate) - sent;
+			while (due > 0) {
+				due -= generate((int) Math.min(due, BATCH));
+			}
+
+			if (now - report >= 0) {
+				report(now - start, ++reports);
+				report += interval;
+			}
+
+			Thread.sleep(1);
+			now = System.nanoTime();
+		}
+
+		// Give the dispatch executors a chance to catch up.
+		long deadline = System.nanoTime() + DRAIN_TIMEOUT;
+		while (getQueueDepth(screen.getDispatchStatistics()) > 0 && System.nanoTime() - deadline < 0) {
+			Thread.sleep(10);
+		}
+		report(System.nanoTime() - start, ++reports);
+
+		if (post) {
+			GlobalScreen.shutdown(5, TimeUnit.SECONDS);
+		}
+
+		screen.removeNativeKeyListener(listener);
+		screen.removeNativeMouseListener(listener);
+		screen.removeNativeMouseMotionListener(listener);
+		screen.removeNativeMouseWheelListener(listener);
+
+		return check();
+	}
+
+	/**
+	 * Generate the next events in the mix.
+	 *
+	 * @param count the maximum number of events to generate.
+	 * @return the number of events generated.
+	 */
+	private int generate(int count) {
+		int generated;
+		if (post) {
+			// Always post a complete press, release and motion group so that
+			// the shift key is never left held down.
+			GlobalScreen.postNativeEvent(new NativeKeyEvent(NativeKeyEvent.NATIVE_KEY_PRESSED, 0, 0x00, 0x00,
+					NativeKeyEvent.VC_SHIFT_L, NativeKeyEvent.CHAR_UNDEFINED, NativeKeyEvent.KEY_LOCATION_LEFT));
+			GlobalScreen.postNativeEvent(new NativeKeyEvent(NativeKeyEvent.NATIVE_KEY_RELEASED, 0, 0x00, 0x00,
+					NativeKeyEvent.VC_SHIFT_L, NativeKeyEvent.CHAR_UNDEFINED, NativeKeyEvent.KEY_LOCATION_LEFT));
+			GlobalScreen.postNativeEvent(new NativeMouseEvent(NativeMouseEvent.NATIVE_MOUSE_MOVED, 0, 0x00,
+					100 + (slot++ & 0x0F), 100, 0, NativeMouseEvent.NOBUTTON));
+			generated = 3;
+		}
+		else {
+			int id = DISPATCH_MIX[slot++ % DISPATCH_MIX.length];
+			dispatchNativeEvents(id, count);
+			generated = count;
+		}
+
+		sent += generated;
+		return generated;
+	}
+
+	/**
+	 * Print a report line and update the memory samples.
+	 *
+	 * @param elapsed the time since the start of the run.
+	 * @param index the number of this report starting at 1.
+	 */
+	private void report(long elapsed, int index) {
+		System.gc();
+		System.gc();
+
+		lastHeap = ManagementFactory.getMemoryMXBean().getHeapMemoryUsage().getUsed();
+		lastRss = getResidentSetSize();
+		if (index == warmup) {
+			baseHeap = lastHeap;
+			baseRss = lastRss;
+		}
+
+		DispatchStatistics statistics = screen.getDispatchStatistics();
+		int depth = getQueueDepth(statistics);
+		for (int i = 0; i < GROUP_IDS.length; i++) {
+			maxDepth = Math.max(maxDepth, statistics.getMaxPendingEventCount(GROUP_IDS[i]));
+		}
+
+		long[] latency = listener.drainLatency();
+
+		System.out.printf("%6ds sent %d received %d heap %.1fMB rss %.1fMB queue %d (max %d) dropped %d latency p50 %s p99 %s p999 %s%n",
+				TimeUnit.NANOSECONDS.toSeconds(elapsed),
+				sent,
+				listener.getReceivedCount(),
+				lastHeap / (double) MEGABYTE,
+				lastRss / (double) MEGABYTE,
+				depth,
+				maxDepth,
+				statistics.getDroppedEventCount(),
+				formatLatency(getPercentile(latency, 50.0)),
+				formatLatency(getPercentile(latency, 99.0)),
+				formatLatency(getPercentile(latency, 99.9)));
+	}
+
+	/**
+	 * Compare the final sample against the baseline.
+	 *
+	 * @return true if the run passed.
+	 */
+	private boolean check() {
+		boolean passed = true;
+
+		if (baseHeap < 0) {
+			System.out.println("The run was too short to take a memory baseline.");
+		}
+		else {
+			if (lastHeap - baseHeap > maxHeapGrowth) {
+				System.out.printf("FAILED: heap grew by %.1fMB.%n", (lastHeap - baseHeap) / (double) MEGABYTE);
+				passed = false;
+			}
+
+			if (baseRss >= 0 && lastRss - baseRss > maxRssGrowth) {
+				System.out.printf("FAILED: resident set grew by %.1fMB.%n", (lastRss - baseRss) / (double) MEGABYTE);
+				passed = false;
+			}
+		}
+
+		// Other input may be mixed in with posted events, so only the
+		// synthetic dispatch mode can account for every event.
+		if (!post && listener.getReceivedCount() != sent) {
+			System.out.printf("FAILED: %d events were sent but %d were received.%n", sent, listener.getReceivedCount());
+			passed = false;
+		}
+
+		if (listener.getUnstampedCount() > 0) {
+			System.out.printf("%d events were received without a capture time.%n", listener.getUnstampedCount());
+		}
+
+		System.out.println(passed ? "Soak test passed." : "Soak test failed.");
+		return passed;
+	}
+
+	/**
+	 * Returns the total number of events waiting in the dispatch queues.
+	 */
+	private static int getQueueDepth(DispatchStatistics statistics) {
+		int depth = 0;
+		for (int i = 0; i < GROUP_IDS.length; i++) {
+			depth += statistics.getPendingEventCount(GROUP_IDS[i]);
+		}
+
+		return depth;
+	}
+
+	/**
+	 * Returns the upper bound of the histogram bucket containing the
+	 * percentile, or 0 if the histogram is empty.
+	 */
+	static long getPercentile(long[] histogram, double percentile) {
+		long total = 0;
+		for (int i = 0; i < histogram.length; i++) {
+			total += histogram[i];
+		}
+
+		long bound = 0;
+		if (total > 0) {
+			long rank = Math.max(1, (long) Math.ceil(total * percentile / 100.0));
+
+			long seen = 0;
+			for (int i = 0; i < histogram.length && seen < rank; i++) {
+				seen += histogram[i];
+				if (seen >= rank) {
+					bound = i < histogram.length - 1 ? 1L << i : Long.MAX_VALUE;
+				}
+			}
+		}
+
+		return bound;
+	}
+
+	private static String formatLatency(long nanos) {
+		String latency;
+		if (nanos < 1000) {
+			latency = nanos + "ns";
+		}
+		else if (nanos < 1000 * 1000) {
+			latency = "<" + (nanos / 1000) + "us";
+		}
+		else {
+			latency = "<" + (nanos / (1000 * 1000)) + "ms";
+		}
+
+		return latency;
+	}
+
+	/**
+	 * Returns the resident set size of this process from
+	 * <code>/proc/self/status</code>.
+	 *
+	 * @return the resident set size in bytes or -1 if it is not available on
+	 * this platform.
+	 */
+	private static long getResidentSetSize() {
+		long rss = -1;
+
+		BufferedReader reader = null;
+		try {
+			reader = new BufferedReader(new FileReader("/proc/self/status"));
+
+			String line;
+			while (rss < 0 && (line = reader.readLine()) != null) {
+				if (line.startsWith("VmRSS:")) {
+					rss = Long.parseLong(line.substring(6).replace("kB", "").trim()) * 1024;
+				}
+			}
+		}
+		catch (IOException e) {
+			// Not available on this platform.
+		}
+		finally {
+			if (reader != null) {
+				try {
+					reader.close();
+				}
+				catch (IOException e) {
+					// Ignore.
+				}
+			}
+		}
+
+		return rss;
+	}
+
+	/**
+	 * Call the native event dispatcher with synthetic events on the current
+	 * thread.  This is only available in the library built by
+	 * <code>ant soak</code>.
+	 *
+	 * @param id the native event id to synthesize.
+	 * @param count the number of events to dispatch.
+	 * @return the elapsed time in nanoseconds.
+	 */
+	static native long dispatchNativeEvents(int id, int count);
+}
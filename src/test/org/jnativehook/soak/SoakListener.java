@@ -0,0 +1,140 @@
+/* JNativeHook: Global keyboard and mouse hooking for Java.
+ * Copyright (C) 2006-2014 Alexander Barker.  All Rights Received.
+ * http://code.google.com/p/jnativehook/
+ *
+ * JNativeHook is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * JNativeHook is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+package org.jnativehook.soak;
+
+//Imports
+import org.jnativehook.NativeInputEvent;
+import org.jnativehook.keyboard.NativeKeyEvent;
+import org.jnativehook.keyboard.NativeKeyListener;
+import org.jnativehook.mouse.NativeMouseEvent;
+import org.jnativehook.mouse.NativeMouseInputListener;
+import org.jnativehook.mouse.NativeMouseWheelEvent;
+import org.jnativehook.mouse.NativeMouseWheelListener;
+
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicLongArray;
+
+/**
+ * A listener for every event type that counts the native events it receives
+ * and records the time from native capture to delivery.  Latency uses the
+ * same power of two buckets as <code>DispatchStatistics</code>: bucket 0
+ * counts zero length intervals and bucket <code>n</code> counts intervals of
+ * at least <code>2<sup>n-1</sup></code> and less than
+ * <code>2<sup>n</sup></code> nanoseconds.
+ * <p/>
+ *
+ * The listener may be called from several dispatch executors at once and
+ * never retains the events, so it is safe to use with pooled event objects.
+ *
+ * @since 1.2
+ */
+class SoakListener implements NativeKeyListener, NativeMouseInputListener, NativeMouseWheelListener {
+	/** The number of latency buckets. */
+	static final int BUCKETS = 64;
+
+	/** The number of native events received, including coalesced events. */
+	private final AtomicLong received = new AtomicLong();
+
+	/** The number of events received without a capture time. */
+	private final AtomicLong unstamped = new AtomicLong();
+
+	/** The capture to delivery latency since the last snapshot. */
+	private final AtomicLongArray latency = new AtomicLongArray(BUCKETS);
+
+	private void received(NativeInputEvent e, int count) {
+		received.addAndGet(count);
+
+		long capture = e.getCaptureTime();
+		if (capture != 0) {
+			long elapsed = System.nanoTime() - capture;
+			latency.incrementAndGet(elapsed > 0 ? 64 - Long.numberOfLeadingZeros(elapsed) : 0);
+		}
+		else {
+			unstamped.incrementAndGet();
+		}
+	}
+
+	/**
+	 * Returns the number of native events received.
+	 *
+	 * @return the number of events, counting each coalesced event.
+	 */
+	long getReceivedCount() {
+		return received.get();
+	}
+
+	/**
+	 * Returns the number of events received without a capture time.
+	 *
+	 * @return the number of unstamped events.
+	 */
+	long getUnstampedCount() {
+		return unstamped.get();
+	}
+
+	/**
+	 * Returns the latency histogram recorded since the previous call and
+	 * starts a new one.
+	 *
+	 * @return the histogram buckets.
+	 */
+	long[] drainLatency() {
+		long[] histogram = new long[BUCKETS];
+		for (int i = 0; i < BUCKETS; i++) {
+			histogram[i] = latency.getAndSet(i, 0);
+		}
+
+		return histogram;
+	}
+
+	public void nativeKeyPressed(NativeKeyEvent e) {
+		received(e, 1);
+	}
+
+	public void nativeKeyReleased(NativeKeyEvent e) {
+		received(e, 1);
+	}
+
+	public void nativeKeyTyped(NativeKeyEvent e) {
+		received(e, 1);
+	}
+
+	public void nativeMouseClicked(NativeMouseEvent e) {
+		received(e, 1);
+	}
+
+	public void nativeMousePressed(NativeMouseEvent e) {
+		received(e, 1);
+	}
+
+	public void nativeMouseReleased(NativeMouseEvent e) {
+		received(e, 1);
+	}
+
+	public void nativeMouseMoved(NativeMouseEvent e) {
+		received(e, e.getCoalescedCount());
+	}
+
+	public void nativeMouseDragged(NativeMouseEvent e) {
+		received(e, e.getCoalescedCount());
+	}
+
+	public void nativeMouseWheelMoved(NativeMouseWheelEvent e) {
+		received(e, e.getCoalescedCount());
+	}
+}